@@ -38,16 +38,15 @@
 #include "libraries/gpio_raspberry_pi/mRaspberryIO.h"
 #endif
 
-#include "libraries/signal_filters/mExponentialFilter.h"
-
 //----------------------------------------------------------------------
 // Internal includes
 //----------------------------------------------------------------------
 #include "projects/smart_home/heat_control/mController.h"
+#include "projects/smart_home/heat_control/mHouseSimulator.h"
 #include "projects/smart_home/heat_control/mPumpInterface.h"
 
 #include "projects/smart_home/shared/mMCP3008.h"
-#include "projects/smart_home/shared/mPT.h"
+#include "projects/smart_home/shared/mPTArray.h"
 
 //----------------------------------------------------------------------
 // Namespace usage
@@ -78,11 +77,30 @@ enum tMCP3008Output
   ePT100_GARAGE,
   eCOUNT
 };
+
+//! Sensor connected to an A/D channel
+struct tSensorChannel
+{
+  tMCP3008Output channel;
+  tTemperatureSensors sensor;
+};
 //----------------------------------------------------------------------
 // Const values
 //----------------------------------------------------------------------
 static runtime_construction::tStandardCreateModuleAction<gHeatControl> cCREATE_ACTION_FOR_G_RASPBERRYPIHEATINGCONTROL("HeatControl");
 
+static const std::array<tSensorChannel, tMCP3008Output::eCOUNT> cSENSOR_CHANNELS {{
+    {tMCP3008Output::ePT1000_SOLAR, tTemperatureSensors::eSOLAR_SENSOR},
+    {tMCP3008Output::ePT100_ROOM, tTemperatureSensors::eROOM_SENSOR},
+    {tMCP3008Output::ePT1000_BOILER_MIDDLE, tTemperatureSensors::eBOILER_MIDDLE_SENSOR},
+    {tMCP3008Output::ePT1000_GROUND, tTemperatureSensors::eGROUND_SENSOR},
+    {tMCP3008Output::ePT100_BOILER_TOP, tTemperatureSensors::eBOILER_TOP_SENSOR},
+    {tMCP3008Output::ePT100_BOILER_BOTTOM, tTemperatureSensors::eBOILER_BOTTOM_SENSOR},
+    {tMCP3008Output::ePT100_FURNACE, tTemperatureSensors::eFURNACE_SENSOR},
+    {tMCP3008Output::ePT100_GARAGE, tTemperatureSensors::eGARAGE_SENSOR}
+  }
+};
+
 //----------------------------------------------------------------------
 // Implementation
 //----------------------------------------------------------------------
@@ -114,6 +132,7 @@ gHeatControl::gHeatControl(core::tFrameworkElement *parent, const std::string &n
   this->co_control_mode.ConnectTo(controller->co_control_mode);
   this->co_heating_state.ConnectTo(controller->co_heating_state);
   this->so_error_state.ConnectTo(controller->so_error_state);
+  this->so_sensor_frame.ConnectTo(controller->so_sensor_frame);
   this->so_led_green.ConnectTo(controller->co_led_online_green);
   this->so_led_yellow.ConnectTo(controller->co_led_online_yellow);
   this->so_led_red.ConnectTo(controller->co_led_online_red);
@@ -143,126 +162,77 @@ gHeatControl::gHeatControl(core::tFrameworkElement *parent, const std::string &n
   mcp_3008->in_voltage_raw.at(tMCP3008Output::ePT100_FURNACE).ConnectTo("/Main Thread/HeatControl/Raspberry Pi GPIO Interface/Output/Mcp3008 Ad Voltage Furnace");
   mcp_3008->in_voltage_raw.at(tMCP3008Output::ePT100_GARAGE).ConnectTo("/Main Thread/HeatControl/Raspberry Pi GPIO Interface/Output/Mcp3008 Ad Voltage Garage");
 
-  auto pt100_room = new shared::mPT100(this, "PT100 Room");
-  pt100_room->par_pre_resistance.Set(94.0);
-  pt100_room->par_reference_voltage.Set(5.0);
-  pt100_room->par_supply_voltage.Set(5.0);
-  pt100_room->in_voltage.ConnectTo(mcp_3008->out_voltage.at(tMCP3008Output::ePT100_ROOM));
-
-  auto filter_room = new signal_filters::mExponentialFilter<rrlib::si_units::tCelsius<double>>(this, "PT100 Room Filter");
-  filter_room->par_number_of_ports.Set(1);
-  filter_room->Init();
-  filter_room->par_weight.Set(0.001);
-  filter_room->par_initial_value.Set(rrlib::si_units::tCelsius<double>(20.0));
-  filter_room->in_input_values.at(0).ConnectTo(pt100_room->out_temperature);
-  filter_room->out_filtered_values.at(0).ConnectTo(controller->si_temperature_room);
-
-  auto pt1000_boiler_middle = new shared::mPT1000(this, "PT1000 Boiler Middle");
-  pt1000_boiler_middle->par_pre_resistance.Set(993.0);
-  pt1000_boiler_middle->par_reference_voltage.Set(5.0);
-  pt1000_boiler_middle->par_supply_voltage.Set(5.0);
-  pt1000_boiler_middle->in_voltage.ConnectTo(mcp_3008->out_voltage.at(tMCP3008Output::ePT1000_BOILER_MIDDLE));
-
-  auto filter_boiler_middle = new signal_filters::mExponentialFilter<rrlib::si_units::tCelsius<double>>(this, "PT1000 Boiler Middle Filter");
-  filter_boiler_middle->par_number_of_ports.Set(1);
-  filter_boiler_middle->Init();
-  filter_boiler_middle->par_weight.Set(0.01);
-  filter_boiler_middle->par_initial_value.Set(rrlib::si_units::tCelsius<double>(20.0));
-  filter_boiler_middle->in_input_values.at(0).ConnectTo(pt1000_boiler_middle->out_temperature);
-  filter_boiler_middle->out_filtered_values.at(0).ConnectTo(controller->si_temperature_boiler_middle);
-
-  auto pt100_boiler_bottom = new shared::mPT100(this, "PT100 Boiler Bottom");
-  pt100_boiler_bottom->par_pre_resistance.Set(92.4);
-  pt100_boiler_bottom->par_reference_voltage.Set(5.0);
-  pt100_boiler_bottom->par_supply_voltage.Set(5.0);
-  pt100_boiler_bottom->in_voltage.ConnectTo(mcp_3008->out_voltage.at(tMCP3008Output::ePT100_BOILER_BOTTOM));
-
-  auto filter_boiler_bottom = new signal_filters::mExponentialFilter<rrlib::si_units::tCelsius<double>>(this, "PT100 Boiler Bottom Filter");
-  filter_boiler_bottom->par_number_of_ports.Set(1);
-  filter_boiler_bottom->Init();
-  filter_boiler_bottom->par_weight.Set(0.01);
-  filter_boiler_bottom->par_initial_value.Set(rrlib::si_units::tCelsius<double>(20.0));
-  filter_boiler_bottom->in_input_values.at(0).ConnectTo(pt100_boiler_bottom->out_temperature);
-  filter_boiler_bottom->out_filtered_values.at(0).ConnectTo(controller->si_temperature_boiler_bottom);
-
-  auto pt100_boiler_top = new shared::mPT100(this, "PT100 Boiler Top");
-  pt100_boiler_top->par_pre_resistance.Set(92.6);
-  pt100_boiler_top->par_reference_voltage.Set(5.0);
-  pt100_boiler_top->par_supply_voltage.Set(5.0);
-  pt100_boiler_top->in_voltage.ConnectTo(mcp_3008->out_voltage.at(tMCP3008Output::ePT100_BOILER_TOP));
-
-  auto filter_boiler_top = new signal_filters::mExponentialFilter<rrlib::si_units::tCelsius<double>>(this, "PT100 Boiler Top Filter");
-  filter_boiler_top->par_number_of_ports.Set(1);
-  filter_boiler_top->Init();
-  filter_boiler_top->par_weight.Set(0.01);
-  filter_boiler_top->par_initial_value.Set(rrlib::si_units::tCelsius<double>(20.0));
-  filter_boiler_top->in_input_values.at(0).ConnectTo(pt100_boiler_top->out_temperature);
-  filter_boiler_top->out_filtered_values.at(0).ConnectTo(controller->si_temperature_boiler_top);
-
-  auto pt1000_solar = new shared::mPT1000(this, "PT1000 Solar");
-  pt1000_solar->par_pre_resistance.Set(991.0);
-  pt1000_solar->par_reference_voltage.Set(5.0);
-  pt1000_solar->par_supply_voltage.Set(5.0);
-  pt1000_solar->in_voltage.ConnectTo(mcp_3008->out_voltage.at(tMCP3008Output::ePT1000_SOLAR));
-
-  auto filter_solar = new signal_filters::mExponentialFilter<rrlib::si_units::tCelsius<double>>(this, "PT1000 Solar Filter");
-  filter_solar->par_number_of_ports.Set(1);
-  filter_solar->Init();
-  filter_solar->par_weight.Set(0.005);
-  filter_solar->par_initial_value.Set(rrlib::si_units::tCelsius<double>(20.0));
-  filter_solar->in_input_values.at(0).ConnectTo(pt1000_solar->out_temperature);
-  filter_solar->out_filtered_values.at(0).ConnectTo(controller->si_temperature_solar);
-
-  auto pt1000_ground = new shared::mPT1000(this, "PT1000 Ground");
-  pt1000_ground->par_pre_resistance.Set(991.0);
-  pt1000_ground->par_reference_voltage.Set(5.0);
-  pt1000_ground->par_supply_voltage.Set(5.0);
-  pt1000_ground->in_voltage.ConnectTo(mcp_3008->out_voltage.at(tMCP3008Output::ePT1000_GROUND));
-
-  auto filter_ground = new signal_filters::mExponentialFilter<rrlib::si_units::tCelsius<double>>(this, "PT1000 Ground Filter");
-  filter_ground->par_number_of_ports.Set(1);
-  filter_ground->Init();
-  filter_ground->par_weight.Set(0.005);
-  filter_ground->par_initial_value.Set(rrlib::si_units::tCelsius<double>(20.0));
-  filter_ground->in_input_values.at(0).ConnectTo(pt1000_ground->out_temperature);
-  filter_ground->out_filtered_values.at(0).ConnectTo(controller->si_temperature_ground);
-
-  auto pt100_furnace = new shared::mPT100(this, "PT100 Furnace");
-  pt100_furnace->par_pre_resistance.Set(92.55);
-  pt100_furnace->par_reference_voltage.Set(5.0);
-  pt100_furnace->par_supply_voltage.Set(5.0);
-  pt100_furnace->in_voltage.ConnectTo(mcp_3008->out_voltage.at(tMCP3008Output::ePT100_FURNACE));
-
-  auto filter_furnace = new signal_filters::mExponentialFilter<rrlib::si_units::tCelsius<double>>(this, "PT100 Furnace Filter");
-  filter_furnace->par_number_of_ports.Set(1);
-  filter_furnace->Init();
-  filter_furnace->par_weight.Set(0.01);
-  filter_furnace->par_initial_value.Set(rrlib::si_units::tCelsius<double>(20.0));
-  filter_furnace->in_input_values.at(0).ConnectTo(pt100_furnace->out_temperature);
-  filter_furnace->out_filtered_values.at(0).ConnectTo(controller->si_temperature_furnace);
-
-  auto pt100_garage = new shared::mPT100(this, "PT100 Garage");
-  pt100_garage->par_pre_resistance.Set(93.5);
-  pt100_garage->par_reference_voltage.Set(5.0);
-  pt100_garage->par_supply_voltage.Set(5.0);
-  pt100_garage->in_voltage.ConnectTo(mcp_3008->out_voltage.at(tMCP3008Output::ePT100_GARAGE));
-
-  auto filter_garage = new signal_filters::mExponentialFilter<rrlib::si_units::tCelsius<double>>(this, "PT100 Garage Filter");
-  filter_garage->par_number_of_ports.Set(1);
-  filter_garage->Init();
-  filter_garage->par_weight.Set(0.01);
-  filter_garage->par_initial_value.Set(rrlib::si_units::tCelsius<double>(20.0));
-  filter_garage->in_input_values.at(0).ConnectTo(pt100_garage->out_temperature);
-  filter_garage->out_filtered_values.at(0).ConnectTo(controller->si_temperature_garage);
-
-  this->so_temperature_room.ConnectTo(filter_room->out_filtered_values.at(0));
-  this->so_temperature_ground.ConnectTo(filter_ground->out_filtered_values.at(0));
-  this->so_temperature_solar.ConnectTo(filter_solar->out_filtered_values.at(0));
-  this->so_temperature_boiler_middle.ConnectTo(filter_boiler_middle->out_filtered_values.at(0));
-  this->so_temperature_boiler_top.ConnectTo(filter_boiler_top->out_filtered_values.at(0));
-  this->so_temperature_boiler_bottom.ConnectTo(filter_boiler_bottom->out_filtered_values.at(0));
-  this->so_temperature_furnace.ConnectTo(filter_furnace->out_filtered_values.at(0));
-  this->so_temperature_garage.ConnectTo(filter_garage->out_filtered_values.at(0));
+  auto pt_array = new shared::mPTArray<tMCP3008Output::eCOUNT>(this, "PT Array");
+  pt_array->par_reference_voltage.Set(5.0);
+  pt_array->par_initial_value.Set(rrlib::si_units::tCelsius<double>(20.0));
+  for (std::size_t i = 0; i < tMCP3008Output::eCOUNT; i++)
+  {
+    pt_array->in_voltage.at(i).ConnectTo(mcp_3008->out_voltage.at(i));
+  }
+
+  pt_array->par_pt_type.at(tMCP3008Output::ePT100_ROOM).Set(shared::tPTType::ePT100);
+  pt_array->par_pre_resistance.at(tMCP3008Output::ePT100_ROOM).Set(94.0);
+  pt_array->par_filter_weight.at(tMCP3008Output::ePT100_ROOM).Set(0.001);
+
+  pt_array->par_pt_type.at(tMCP3008Output::ePT1000_BOILER_MIDDLE).Set(shared::tPTType::ePT1000);
+  pt_array->par_pre_resistance.at(tMCP3008Output::ePT1000_BOILER_MIDDLE).Set(993.0);
+  pt_array->par_filter_weight.at(tMCP3008Output::ePT1000_BOILER_MIDDLE).Set(0.01);
+
+  pt_array->par_pt_type.at(tMCP3008Output::ePT100_BOILER_BOTTOM).Set(shared::tPTType::ePT100);
+  pt_array->par_pre_resistance.at(tMCP3008Output::ePT100_BOILER_BOTTOM).Set(92.4);
+  pt_array->par_filter_weight.at(tMCP3008Output::ePT100_BOILER_BOTTOM).Set(0.01);
+
+  pt_array->par_pt_type.at(tMCP3008Output::ePT100_BOILER_TOP).Set(shared::tPTType::ePT100);
+  pt_array->par_pre_resistance.at(tMCP3008Output::ePT100_BOILER_TOP).Set(92.6);
+  pt_array->par_filter_weight.at(tMCP3008Output::ePT100_BOILER_TOP).Set(0.01);
+
+  pt_array->par_pt_type.at(tMCP3008Output::ePT1000_SOLAR).Set(shared::tPTType::ePT1000);
+  pt_array->par_pre_resistance.at(tMCP3008Output::ePT1000_SOLAR).Set(991.0);
+  pt_array->par_filter_weight.at(tMCP3008Output::ePT1000_SOLAR).Set(0.005);
+
+  pt_array->par_pt_type.at(tMCP3008Output::ePT1000_GROUND).Set(shared::tPTType::ePT1000);
+  pt_array->par_pre_resistance.at(tMCP3008Output::ePT1000_GROUND).Set(991.0);
+  pt_array->par_filter_weight.at(tMCP3008Output::ePT1000_GROUND).Set(0.005);
+
+  pt_array->par_pt_type.at(tMCP3008Output::ePT100_FURNACE).Set(shared::tPTType::ePT100);
+  pt_array->par_pre_resistance.at(tMCP3008Output::ePT100_FURNACE).Set(92.55);
+  pt_array->par_filter_weight.at(tMCP3008Output::ePT100_FURNACE).Set(0.01);
+
+  pt_array->par_pt_type.at(tMCP3008Output::ePT100_GARAGE).Set(shared::tPTType::ePT100);
+  pt_array->par_pre_resistance.at(tMCP3008Output::ePT100_GARAGE).Set(93.5);
+  pt_array->par_filter_weight.at(tMCP3008Output::ePT100_GARAGE).Set(0.01);
+
+  pt_array->out_temperature.at(tMCP3008Output::ePT100_ROOM).ConnectTo(controller->si_temperature_room);
+  pt_array->out_temperature.at(tMCP3008Output::ePT1000_BOILER_MIDDLE).ConnectTo(controller->si_temperature_boiler_middle);
+  pt_array->out_temperature.at(tMCP3008Output::ePT100_BOILER_BOTTOM).ConnectTo(controller->si_temperature_boiler_bottom);
+  pt_array->out_temperature.at(tMCP3008Output::ePT100_BOILER_TOP).ConnectTo(controller->si_temperature_boiler_top);
+  pt_array->out_temperature.at(tMCP3008Output::ePT1000_SOLAR).ConnectTo(controller->si_temperature_solar);
+  pt_array->out_temperature.at(tMCP3008Output::ePT1000_GROUND).ConnectTo(controller->si_temperature_ground);
+  pt_array->out_temperature.at(tMCP3008Output::ePT100_FURNACE).ConnectTo(controller->si_temperature_furnace);
+  pt_array->out_temperature.at(tMCP3008Output::ePT100_GARAGE).ConnectTo(controller->si_temperature_garage);
+
+  this->so_temperature_room.ConnectTo(pt_array->out_temperature.at(tMCP3008Output::ePT100_ROOM));
+  this->so_temperature_ground.ConnectTo(pt_array->out_temperature.at(tMCP3008Output::ePT1000_GROUND));
+  this->so_temperature_solar.ConnectTo(pt_array->out_temperature.at(tMCP3008Output::ePT1000_SOLAR));
+  this->so_temperature_boiler_middle.ConnectTo(pt_array->out_temperature.at(tMCP3008Output::ePT1000_BOILER_MIDDLE));
+  this->so_temperature_boiler_top.ConnectTo(pt_array->out_temperature.at(tMCP3008Output::ePT100_BOILER_TOP));
+  this->so_temperature_boiler_bottom.ConnectTo(pt_array->out_temperature.at(tMCP3008Output::ePT100_BOILER_BOTTOM));
+  this->so_temperature_furnace.ConnectTo(pt_array->out_temperature.at(tMCP3008Output::ePT100_FURNACE));
+  this->so_temperature_garage.ConnectTo(pt_array->out_temperature.at(tMCP3008Output::ePT100_GARAGE));
+
+#ifndef _LIB_WIRING_PI_PRESENT_
+  // without GPIO hardware, the simulated house reacts to the pumps and drives the A/D converter
+  auto simulator = new mHouseSimulator(this, "House Simulator");
+  simulator->in_pump_online_ground.ConnectTo(controller->co_pump_online_ground);
+  simulator->in_pump_online_room.ConnectTo(controller->co_pump_online_room);
+  simulator->in_pump_online_solar.ConnectTo(controller->co_pump_online_solar);
+  for (auto & channel : cSENSOR_CHANNELS)
+  {
+    simulator->par_pt_type.at(channel.sensor).Set(pt_array->par_pt_type.at(channel.channel).Get());
+    simulator->par_pre_resistance.at(channel.sensor).Set(pt_array->par_pre_resistance.at(channel.channel).Get());
+    simulator->out_voltage_raw.at(channel.sensor).ConnectTo(mcp_3008->in_voltage_raw.at(channel.channel));
+  }
+#endif
 
 }
 
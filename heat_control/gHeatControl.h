@@ -93,6 +93,7 @@ public:
   tSensorOutput<rrlib::si_units::tCelsius<double>> so_temperature_furnace;
   tSensorOutput<rrlib::si_units::tCelsius<double>> so_temperature_room;
   tSensorOutput<rrlib::si_units::tCelsius<double>> so_temperature_garage;
+  tSensorOutput<shared::tSensorFrame> so_sensor_frame;
 
   tSensorOutput<bool> so_led_red;
   tSensorOutput<bool> so_led_yellow;
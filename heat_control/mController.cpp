@@ -67,6 +67,48 @@ namespace heat_control
 //----------------------------------------------------------------------
 static runtime_construction::tStandardCreateModuleAction<mController> cCREATE_ACTION_FOR_M_CONTROLLER("Controller");
 
+static_assert(static_cast<int>(tTemperatureSensors::eSOLAR_SENSOR) == static_cast<int>(shared::eSENSOR_SOLAR) and
+              static_cast<int>(tTemperatureSensors::eSENSOR_COUNT) == static_cast<int>(shared::eSENSOR_ROOM_EXTERNAL),
+              "Sensor order of tSensorFrame differs from tTemperatureSensors");
+
+// heartbeat of gated status outputs
+static const rrlib::time::tDuration cSTATUS_HEARTBEAT = std::chrono::seconds(10);
+
+// heartbeat of gated LED outputs, below the input timeout of user_interface::mLED (10 s)
+static const rrlib::time::tDuration cLED_HEARTBEAT = std::chrono::seconds(2);
+
+// publishing intervals of the complete temperature trend and of the buckets since then
+static const rrlib::time::tDuration cTEMPERATURE_TREND_INTERVAL = std::chrono::hours(1);
+static const rrlib::time::tDuration cTEMPERATURE_TREND_UPDATE_INTERVAL = std::chrono::minutes(1);
+
+// bit masks of the pumps (tPumps)
+static constexpr uint8_t cSOLAR_PUMP = 1 << tPumps::eSOLAR;
+static constexpr uint8_t cGROUND_PUMP = 1 << tPumps::eGROUND;
+static constexpr uint8_t cROOM_PUMP = 1 << tPumps::eROOM;
+
+/*!
+ * Supervised temperature sensors (indexed by shared::tSensor, i.e. tTemperatureSensors followed by the external room sensor)
+ *
+ * A sensor is implausible outside [lower bound, upper bound]. If it is outdated or implausible, the pumps whose
+ * control depends on it are switched off.
+ */
+static constexpr std::array<tSensorDescriptor, shared::eSENSOR_FRAME_COUNT> cSENSORS {{
+    // port                                       lower  upper  log label             pumps
+    {&mController::si_temperature_boiler_bottom,  0.0,   100.0, "Speicher (unten)",   0},
+    {&mController::si_temperature_boiler_middle,  0.0,   100.0, "Speicher (mitte)",   cSOLAR_PUMP | cGROUND_PUMP | cROOM_PUMP},
+    {&mController::si_temperature_boiler_top,     0.0,   100.0, "Speicher (oben)",    0},
+    {&mController::si_temperature_furnace,        0.0,   100.0, "Ofen",               0},
+    {&mController::si_temperature_garage,         0.0,   50.0,  "Garage",             0},
+    {&mController::si_temperature_ground,         0.0,   50.0,  "Bodenplatte",        cGROUND_PUMP},
+    {&mController::si_temperature_room,           0.0,   50.0,  "Raum",               cROOM_PUMP},
+    {&mController::si_temperature_solar,          -40.0, 150.0, "Solar",              cSOLAR_PUMP},
+    {&mController::si_temperature_room_external,  0.0,   50.0,  "Raum (extern)",      0}
+  }
+};
+
+// sensors of tTemperatureSensors raise the error state, the external room sensor only refines the room temperature
+static constexpr uint16_t cERROR_SENSORS = (1 << tTemperatureSensors::eSENSOR_COUNT) - 1;
+
 //----------------------------------------------------------------------
 // Implementation
 //----------------------------------------------------------------------
@@ -80,64 +122,78 @@ mController::mController(core::tFrameworkElement *parent, const std::string &nam
   par_temperature_set_point_room("Temperature Set Point Room", this, 23.0, "temperature_set_point_room"),
   par_max_update_duration("Max Temperature Update Duration", this, std::chrono::seconds(10), "max_update_duration"),
   par_max_pump_update_duration("Max Pump Duration", this, std::chrono::seconds(45), "max_pump_duration"),
-  par_temperature_log_interval("Temperature Log Interval", this, std::chrono::hours(1), "temperature_log_interval"),
+  par_temperature_log_interval("Temperature Log Interval", this, std::chrono::seconds(1), "temperature_log_interval"),
   par_temperature_error_log_interval("Temperature Error Log Interval", this, std::chrono::hours(1), "temperature_outdated_error_log_interval"),
-  control_state_(nullptr),
+  par_temperature_trend_duration("Temperature Trend Duration", this, std::chrono::hours(24), "temperature_trend_duration"),
+  clock_(&shared::GetCycleClock()),
+  cycle_time_(clock_->Now()),
+  control_state_(),
   set_point_(23.0),
   error_(tErrorState::eNO_ERROR),
   error_condition_(false),
+  outdated_mask_(0),
+  implausible_mask_(0),
+  supervision_(),
+  pump_error_mask_(0),
+  prevented_switch_mask_(0),
+  error_state_(so_error_state, cSTATUS_HEARTBEAT),
+  error_condition_output_(so_error_condition, cSTATUS_HEARTBEAT),
+  pump_error_solar_(co_pump_error_solar, cSTATUS_HEARTBEAT),
+  pump_error_room_(co_pump_error_room, cSTATUS_HEARTBEAT),
+  pump_error_ground_(co_pump_error_ground, cSTATUS_HEARTBEAT),
+  pump_working_solar_(co_pump_working_solar, cSTATUS_HEARTBEAT),
+  pump_working_room_(co_pump_working_room, cSTATUS_HEARTBEAT),
+  pump_working_ground_(co_pump_working_ground, cSTATUS_HEARTBEAT),
+  led_online_red_(co_led_online_red, cLED_HEARTBEAT),
+  led_online_yellow_(co_led_online_yellow, cLED_HEARTBEAT),
+  led_online_green_(co_led_online_green, cLED_HEARTBEAT),
+  dropped_log_records_(so_dropped_log_records, cSTATUS_HEARTBEAT),
   last_temperature_logging_time_(rrlib::time::cNO_TIME),
   last_temperature_outdated_logging_time_(rrlib::time::cNO_TIME),
-  last_temperature_implausible_logging_time_(rrlib::time::cNO_TIME)
+  last_temperature_implausible_logging_time_(rrlib::time::cNO_TIME),
+  last_temperature_trend_time_(rrlib::time::cNO_TIME),
+  last_temperature_trend_update_time_(rrlib::time::cNO_TIME),
+  temperature_trend_update_begin_(rrlib::time::cNO_TIME)
 {
-  control_state_ = std::unique_ptr<heat_control_states::tState>(new heat_control_states::tReady());
-
   ci_increase_set_point_temperature.ResetChanged();
   ci_decrease_set_point_temperature.ResetChanged();
   ci_reset_set_point_temperature.ResetChanged();
 
   // start logging
-  std::string temperature_filename = rrlib::util::fileio::ShellExpandFilename("$HOME/temperatures_" + rrlib::time::ToFilenameCompatibleString(rrlib::time::Now()) + ".txt");
-  temperature_log_file_.open(temperature_filename, std::fstream::in | std::fstream::out | std::fstream::app);
+  // binary log, see shared/tTemperatureLog.h (temperature_log_export converts it to CSV)
+  std::string temperature_filename = rrlib::util::fileio::ShellExpandFilename("$HOME/temperatures_" + rrlib::time::ToFilenameCompatibleString(cycle_time_) + ".bin");
+  std::array<const char *, shared::eSENSOR_FRAME_COUNT> channel_names;
+  for (size_t i = 0; i < cSENSORS.size(); i++)
+  {
+    channel_names[i] = cSENSORS[i].label;
+  }
 
   // check if opening the file was successful
-  if (temperature_log_file_.fail() and not temperature_filename.empty())
+  if (not temperature_log_.Open(temperature_filename, sizeof(shared::tTemperatureLogRecord), shared::CreateTemperatureLogHeader(cycle_time_, channel_names))
+      and not temperature_filename.empty())
   {
     RRLIB_LOG_PRINT(ERROR, "Failed to open file: ", temperature_filename);
   }
-  if (temperature_log_file_.good())
+  if (temperature_log_.IsOpen())
   {
     RRLIB_LOG_PRINT(DEBUG, "Start logging temperatures: ", temperature_filename);
-    temperature_log_file_ << "Temperaturen (" << rrlib::time::ToFilenameCompatibleString(rrlib::time::Now()) << ")\n";
-    temperature_log_file_ << "-----------------------------------------------------\n";
-    temperature_log_file_ << "Zeit, ";
-    temperature_log_file_ << "Speicher (unten), ";
-    temperature_log_file_ << "Speicher (mitte), ";
-    temperature_log_file_ << "Speicher (oben), ";
-    temperature_log_file_ << "Ofen, ";
-    temperature_log_file_ << "Garage, ";
-    temperature_log_file_ << "Bodenplatte, ";
-    temperature_log_file_ << "Raum, ";
-    temperature_log_file_ << "Solar\n";
-    temperature_log_file_ << "-----------------------------------------------------\n";
-  }
-
-  std::string event_filename = rrlib::util::fileio::ShellExpandFilename("$HOME/events_" + rrlib::time::ToFilenameCompatibleString(rrlib::time::Now()) + ".txt");
-  event_log_file_.open(event_filename, std::fstream::in | std::fstream::out | std::fstream::app);
+  }
+
+  std::string event_filename = rrlib::util::fileio::ShellExpandFilename("$HOME/events_" + rrlib::time::ToFilenameCompatibleString(cycle_time_) + ".txt");
 
   // check if opening the file was successful
-  if (event_log_file_.fail() and not event_filename.empty())
+  if (not event_log_.Open(event_filename) and not event_filename.empty())
   {
     RRLIB_LOG_PRINT(ERROR, "Failed to open file: ", event_filename);
   }
-  if (event_log_file_.good())
+  if (event_log_.IsOpen())
   {
     RRLIB_LOG_PRINT(DEBUG, "Start logging events: ", event_filename);
-    event_log_file_ << "Systemereignisse (" << rrlib::time::ToFilenameCompatibleString(rrlib::time::Now()) << ")\n";
-    event_log_file_ << "-----------------------------------------------------\n";
-    event_log_file_ << "Zeit, Beschreibung\n";
-    event_log_file_ << "-----------------------------------------------------\n";
-    event_log_file_ << rrlib::time::Now() << " Start der Steuerung\n";
+    shared::tLogLine(event_log_) << "Systemereignisse (" << rrlib::time::ToFilenameCompatibleString(cycle_time_) << ")\n";
+    shared::tLogLine(event_log_) << "-----------------------------------------------------\n";
+    shared::tLogLine(event_log_) << "Zeit, Beschreibung\n";
+    shared::tLogLine(event_log_) << "-----------------------------------------------------\n";
+    shared::tLogLine(event_log_, shared::eLOG_DURABLE) << cycle_time_ << " Start der Steuerung\n";
 
   }
 }
@@ -147,17 +203,12 @@ mController::mController(core::tFrameworkElement *parent, const std::string &nam
 //----------------------------------------------------------------------
 mController::~mController()
 {
-  if (temperature_log_file_.is_open())
-  {
-    temperature_log_file_.close();
-  }
-  if (event_log_file_.is_open())
+  // writes the remaining buffered lines
+  temperature_log_.Close();
+  if (event_log_.IsOpen())
   {
-    if (event_log_file_.good())
-    {
-      event_log_file_ << rrlib::time::Now() << " Herunterfahren der Steuerung\n";
-    }
-    event_log_file_.close();
+    shared::tLogLine(event_log_, shared::eLOG_DURABLE) << clock_->Now() << " Herunterfahren der Steuerung\n";
+    event_log_.Close();
   }
 }
 
@@ -169,7 +220,13 @@ void mController::OnParameterChange()
   if (par_temperature_set_point_room.HasChanged())
   {
     this->set_point_ = rrlib::si_units::tCelsius<double>(par_temperature_set_point_room.Get());
-    co_set_point_temperature.Publish(set_point_, rrlib::time::Now());
+    co_set_point_temperature.Publish(set_point_, clock_->Now());
+  }
+
+  // publish the complete trend at the new resolution
+  if (par_temperature_trend_duration.HasChanged())
+  {
+    last_temperature_trend_time_ = rrlib::time::cNO_TIME;
   }
 }
 
@@ -178,158 +235,87 @@ void mController::OnParameterChange()
 //----------------------------------------------------------------------
 void mController::Sense()
 {
-  bool outdated_temperature = false;
-  bool previous_outdated_temperature = std::all_of(temperature_update_error_condition_.begin(), temperature_update_error_condition_.end(), [](bool i)
-  {
-    return i;
-  });
-
-  auto current_time = rrlib::time::Now();
-
-  bool sensor_value_outdated = false;
-  sensor_value_outdated = (current_time - par_max_update_duration.Get() > si_temperature_boiler_bottom.GetTimestamp()) ? true : false;
-  so_outdated_temperature_boiler_bottom.Publish(sensor_value_outdated, current_time);
-  outdated_temperature = outdated_temperature or sensor_value_outdated;
-  temperature_update_error_condition_.at(tTemperatureSensors::eBOILER_BOTTOM_SENSOR) = sensor_value_outdated;
-
-  sensor_value_outdated = (current_time - par_max_update_duration.Get() > si_temperature_boiler_top.GetTimestamp()) ? true : false;
-  so_outdated_temperature_boiler_top.Publish(sensor_value_outdated, current_time);
-  outdated_temperature = outdated_temperature or sensor_value_outdated;
-  temperature_update_error_condition_.at(tTemperatureSensors::eBOILER_TOP_SENSOR) = sensor_value_outdated;
-
-  sensor_value_outdated = (current_time - par_max_update_duration.Get() > si_temperature_boiler_middle.GetTimestamp()) ? true : false;
-  so_outdated_temperature_boiler_middle.Publish(sensor_value_outdated, current_time);
-  outdated_temperature = outdated_temperature or sensor_value_outdated;
-  temperature_update_error_condition_.at(tTemperatureSensors::eBOILER_MIDDLE_SENSOR) = sensor_value_outdated;
-
-  sensor_value_outdated = (current_time - par_max_update_duration.Get() > si_temperature_furnace.GetTimestamp()) ? true : false;
-  so_outdated_temperature_furnace.Publish(sensor_value_outdated, current_time);
-  outdated_temperature = outdated_temperature or sensor_value_outdated;
-  temperature_update_error_condition_.at(tTemperatureSensors::eFURNACE_SENSOR) = sensor_value_outdated;
-
-  sensor_value_outdated = (current_time - par_max_update_duration.Get() > si_temperature_garage.GetTimestamp()) ? true : false;
-  so_outdated_temperature_garage.Publish(sensor_value_outdated, current_time);
-  outdated_temperature = outdated_temperature or sensor_value_outdated;
-  temperature_update_error_condition_.at(tTemperatureSensors::eGARAGE_SENSOR) = sensor_value_outdated;
-
-  sensor_value_outdated = (current_time - par_max_update_duration.Get() > si_temperature_ground.GetTimestamp()) ? true : false;
-  so_outdated_temperature_ground.Publish(sensor_value_outdated, current_time);
-  outdated_temperature = outdated_temperature or sensor_value_outdated;
-  temperature_update_error_condition_.at(tTemperatureSensors::eGROUND_SENSOR) = sensor_value_outdated;
-
-  sensor_value_outdated = (current_time - par_max_update_duration.Get() > si_temperature_room.GetTimestamp()) ? true : false;
-  so_outdated_temperature_room.Publish(sensor_value_outdated, current_time);
-  outdated_temperature = outdated_temperature or sensor_value_outdated;
-  temperature_update_error_condition_.at(tTemperatureSensors::eROOM_SENSOR) = sensor_value_outdated;
-
-  sensor_value_outdated = (current_time - par_max_update_duration.Get() > si_temperature_solar.GetTimestamp()) ? true : false;
-  so_outdated_temperature_solar.Publish(sensor_value_outdated, current_time);
-  outdated_temperature = outdated_temperature or sensor_value_outdated;
-  temperature_update_error_condition_.at(tTemperatureSensors::eSOLAR_SENSOR) = sensor_value_outdated;
-
-  bool external_outdated = (current_time - par_max_update_duration.Get() > si_temperature_room_external.GetTimestamp()) ? true : false;
-  so_outdated_temperature_room_external.Publish(external_outdated, current_time);
+  cycle_time_ = clock_->Now();
+  auto current_time = cycle_time_;
+  bool check_plausibility = this->SensorInputChanged();
+
+  // supervise all sensors in one pass
+  uint16_t previous_outdated_mask = outdated_mask_;
+  uint16_t previous_implausible_mask = implausible_mask_;
+  supervision_.StartCycle(check_plausibility);
+  for (size_t i = 0; i < cSENSORS.size(); i++)
+  {
+    const tSensorDescriptor & descriptor = cSENSORS[i];
+    const tTemperatureInput & port = this->*descriptor.port;
+    supervision_.Check(i, port.Get().ValueFactored(), port.GetTimestamp(), current_time, par_max_update_duration.Get(), descriptor.lower_bound, descriptor.upper_bound, descriptor.pumps);
+  }
+  uint16_t outdated_mask = supervision_.GetOutdatedMask();
+  uint16_t implausible_mask = supervision_.GetImplausibleMask();
+  pump_error_mask_ = supervision_.GetPumpErrorMask();
+
+  if (outdated_mask != outdated_mask_)
+  {
+    outdated_mask_ = outdated_mask;
+    so_outdated_temperatures.Publish(outdated_mask_, current_time);
+  }
+  if (implausible_mask != implausible_mask_)
+  {
+    implausible_mask_ = implausible_mask;
+    so_implausible_temperatures.Publish(implausible_mask_, current_time);
+  }
+
+  // the implausible mask is kept on cycles without new readings, so the error state does not flap between them
+  bool outdated_temperature = supervision_.IsOutdated(cERROR_SENSORS);
+  bool implausible_temperature = supervision_.IsImplausible(cERROR_SENSORS);
+  bool external_outdated = outdated_mask & (1 << shared::eSENSOR_ROOM_EXTERNAL);
+  bool external_implausible = implausible_mask & (1 << shared::eSENSOR_ROOM_EXTERNAL);
 
   // log the error event
-  if (event_log_file_.good() and outdated_temperature)
+  if (event_log_.IsOpen() and outdated_temperature)
   {
     // log after a duration or new failure
     if ((last_temperature_outdated_logging_time_ + par_temperature_error_log_interval.Get() < current_time))
     {
-      event_log_file_ << rrlib::time::Now() << " Fehlerzustand: Temperaturdaten veraltet (";
-      for (size_t i = 0; i < temperature_update_error_condition_.size(); i++)
+      shared::tLogLine line(event_log_, shared::eLOG_DURABLE);
+      line << current_time << " Fehlerzustand: Temperaturdaten veraltet (";
+      for (size_t i = 0; i < tTemperatureSensors::eSENSOR_COUNT; i++)
       {
-        if (temperature_update_error_condition_.at(i))
+        if (outdated_mask & (1 << i))
         {
-          event_log_file_ << make_builder::GetEnumString(static_cast<tTemperatureSensors>(i)) << "; ";
+          line << cSENSORS[i].label << "; ";
         }
       }
-      event_log_file_ << ")\n";
+      line << ")\n";
 
       last_temperature_outdated_logging_time_ = current_time;
     }
   }
-  if (event_log_file_.good() and previous_outdated_temperature and not outdated_temperature)
+  if (event_log_.IsOpen() and (previous_outdated_mask & cERROR_SENSORS) and not outdated_temperature)
   {
-    event_log_file_ << rrlib::time::Now() << " Zustand: Alle Temperaturdaten sind wieder aktuell.\n";
+    shared::tLogLine(event_log_, shared::eLOG_DURABLE) << current_time << " Zustand: Alle Temperaturdaten sind wieder aktuell.\n";
   }
 
-  bool implausible_temperature = false;
-
-  if (this->SensorInputChanged())
+  if (check_plausibility)
   {
-    // check plausibility of temperatures
-    bool sensor_value_implausible = false;
-    sensor_value_implausible = not IsTemperatureInBounds(si_temperature_room.Get(), rrlib::si_units::tCelsius<double>(50.0), rrlib::si_units::tCelsius<double>(0.0));
-    implausible_temperature = implausible_temperature or sensor_value_implausible;
-    so_implausible_temperature_room.Publish(sensor_value_implausible, current_time);
-    this->temperature_plausibility_error_condition_.at(tTemperatureSensors::eROOM_SENSOR) = sensor_value_implausible;
-
-    sensor_value_implausible = not IsTemperatureInBounds(si_temperature_solar.Get(), rrlib::si_units::tCelsius<double>(150.0), rrlib::si_units::tCelsius<double>(-40.0));
-    implausible_temperature = implausible_temperature or sensor_value_implausible;
-    so_implausible_temperature_solar.Publish(sensor_value_implausible, current_time);
-    this->temperature_plausibility_error_condition_.at(tTemperatureSensors::eSOLAR_SENSOR) = sensor_value_implausible;
-
-    sensor_value_implausible = not IsTemperatureInBounds(si_temperature_ground.Get(), rrlib::si_units::tCelsius<double>(50.0), rrlib::si_units::tCelsius<double>(0.0));
-    implausible_temperature = implausible_temperature or sensor_value_implausible;
-    so_implausible_temperature_ground.Publish(sensor_value_implausible, current_time);
-    this->temperature_plausibility_error_condition_.at(tTemperatureSensors::eGROUND_SENSOR) = sensor_value_implausible;
-
-    sensor_value_implausible = not IsTemperatureInBounds(si_temperature_garage.Get(), rrlib::si_units::tCelsius<double>(50.0), rrlib::si_units::tCelsius<double>(0.0));
-    implausible_temperature = implausible_temperature or sensor_value_implausible;
-    so_implausible_temperature_garage.Publish(sensor_value_implausible, current_time);
-    this->temperature_plausibility_error_condition_.at(tTemperatureSensors::eGARAGE_SENSOR) = sensor_value_implausible;
-
-    sensor_value_implausible = not IsTemperatureInBounds(si_temperature_furnace.Get(), rrlib::si_units::tCelsius<double>(100.0), rrlib::si_units::tCelsius<double>(0.0));
-    implausible_temperature = implausible_temperature or sensor_value_implausible;
-    so_implausible_temperature_furnace.Publish(sensor_value_implausible, current_time);
-    this->temperature_plausibility_error_condition_.at(tTemperatureSensors::eFURNACE_SENSOR) = sensor_value_implausible;
-
-    sensor_value_implausible = not IsTemperatureInBounds(si_temperature_boiler_bottom.Get(), rrlib::si_units::tCelsius<double>(100.0), rrlib::si_units::tCelsius<double>(0.0));
-    implausible_temperature = implausible_temperature or sensor_value_implausible;
-    so_implausible_temperature_boiler_bottom.Publish(sensor_value_implausible, current_time);
-    this->temperature_plausibility_error_condition_.at(tTemperatureSensors::eBOILER_BOTTOM_SENSOR) = sensor_value_implausible;
-
-    sensor_value_implausible = not IsTemperatureInBounds(si_temperature_boiler_top.Get(), rrlib::si_units::tCelsius<double>(100.0), rrlib::si_units::tCelsius<double>(0.0));
-    implausible_temperature = implausible_temperature or sensor_value_implausible;
-    so_implausible_temperature_boiler_top.Publish(sensor_value_implausible, current_time);
-    this->temperature_plausibility_error_condition_.at(tTemperatureSensors::eBOILER_TOP_SENSOR) = sensor_value_implausible;
-
-    sensor_value_implausible = not IsTemperatureInBounds(si_temperature_boiler_middle.Get(), rrlib::si_units::tCelsius<double>(100.0), rrlib::si_units::tCelsius<double>(0.0));
-    implausible_temperature = implausible_temperature or sensor_value_implausible;
-    so_implausible_temperature_boiler_middle.Publish(sensor_value_implausible, current_time);
-    this->temperature_plausibility_error_condition_.at(tTemperatureSensors::eBOILER_MIDDLE_SENSOR) = sensor_value_implausible;
-
     // logging of wrong temperature values
-    if (event_log_file_.good() and implausible_temperature)
+    if (event_log_.IsOpen() and implausible_temperature)
     {
       if (last_temperature_implausible_logging_time_ + par_temperature_error_log_interval.Get() < current_time)
       {
-        event_log_file_ << rrlib::time::Now() << " Fehlerzustand: Temperaturdaten sind nicht plausibel (";
-        event_log_file_ << "Raum " << si_temperature_room.Get().ValueFactored() << "; ";
-        event_log_file_ << "Solar " << si_temperature_solar.Get().ValueFactored() << "; ";
-        event_log_file_ << "Bodenplatte " << si_temperature_ground.Get().ValueFactored() << "; ";
-        event_log_file_ << "Ofen " << si_temperature_furnace.Get().ValueFactored() << "; ";
-        event_log_file_ << "Garage " << si_temperature_garage.Get().ValueFactored() << "; ";
-        event_log_file_ << "Speicher (oben) " << si_temperature_boiler_top.Get().ValueFactored() << "; ";
-        event_log_file_ << "Speicher (mitte) " << si_temperature_boiler_middle.Get().ValueFactored() << "; ";
-        event_log_file_ << "Speicher (unten) " << si_temperature_boiler_bottom.Get().ValueFactored() << ")\n";
+        shared::tLogLine line(event_log_, shared::eLOG_DURABLE);
+        line << current_time << " Fehlerzustand: Temperaturdaten sind nicht plausibel (";
+        LogTemperatures(line);
+        line << ")\n";
 
         last_temperature_implausible_logging_time_ = current_time;
       }
     }
 
-    if (event_log_file_.good() and
-        (this->error_ == tErrorState::eIMPLAUSIBLE_TEMPERATURE or
-         this->error_ == tErrorState::eIMPLAUSIBLE_OUTDATED_TEMPERATURE)
-        and not implausible_temperature)
+    if (event_log_.IsOpen() and (previous_implausible_mask & cERROR_SENSORS) and not implausible_temperature)
     {
-      event_log_file_ << rrlib::time::Now() << " Zustand: Alle Temperaturdaten sind wieder plausibel.\n";
+      shared::tLogLine(event_log_, shared::eLOG_DURABLE) << current_time << " Zustand: Alle Temperaturdaten sind wieder plausibel.\n";
     }
 
-    bool external_implausible = not IsTemperatureInBounds(si_temperature_room_external.Get(), rrlib::si_units::tCelsius<double>(50.0), rrlib::si_units::tCelsius<double>(0.0));
-    so_implausible_temperature_room_external.Publish(external_implausible, current_time);
-
     // integrate external room temperature if value is available
     auto temperature_room = si_temperature_room.Get();
     if (not external_outdated and not external_implausible)
@@ -347,39 +333,16 @@ void mController::Sense()
       si_temperature_ground.Get(),
       set_point_
     };
-
-    // log temperatures
-    if (temperature_log_file_.good())
-    {
-      if (last_temperature_logging_time_ + par_temperature_log_interval.Get() < current_time)
-      {
-        temperature_log_file_ << rrlib::time::Now() << ",";
-        temperature_log_file_ << si_temperature_boiler_bottom.Get().ValueFactored() << ", ";
-        temperature_log_file_ << si_temperature_boiler_middle.Get().ValueFactored() << ", ";
-        temperature_log_file_ << si_temperature_boiler_top.Get().ValueFactored() << ", ";
-        temperature_log_file_ << si_temperature_furnace.Get().ValueFactored() << ", ";
-        temperature_log_file_ << si_temperature_garage.Get().ValueFactored() << ", ";
-        temperature_log_file_ << si_temperature_ground.Get().ValueFactored() << ", ";
-        temperature_log_file_ << si_temperature_room.Get().ValueFactored() << ", ";
-        temperature_log_file_ << si_temperature_solar.Get().ValueFactored() << "\n";
-
-        last_temperature_logging_time_ = current_time;
-        temperature_log_file_.flush();
-      }
-    }
   }
 
   // log error condition recovery
-  if (event_log_file_.good() and this->error_condition_
+  if (event_log_.IsOpen() and this->error_condition_
       and not implausible_temperature
       and not outdated_temperature)
   {
-    event_log_file_ << rrlib::time::Now() << " Zustand: Steuerung ist wieder im fehlerfreien Zustand.\n";
+    shared::tLogLine(event_log_, shared::eLOG_DURABLE) << current_time << " Zustand: Steuerung ist wieder im fehlerfreien Zustand.\n";
   }
 
-  // flush to drive
-  event_log_file_.flush();
-
 
   // determine error state
   if (implausible_temperature)
@@ -406,12 +369,68 @@ void mController::Sense()
       this->error_ = tErrorState::eNO_ERROR;
     }
   }
-  this->so_error_state.Publish(error_, current_time);
-  this->so_error_condition.Publish(error_condition_, current_time);
+  error_state_.Publish(error_, current_time);
+  error_condition_output_.Publish(error_condition_, current_time);
   if (error_condition_)
   {
     this->so_last_error_time.Publish(current_time, current_time);
   }
+
+  // publish all readings as one consistent snapshot
+  shared::tSensorFrame frame;
+  frame.SetTimestamp(current_time);
+  for (size_t i = 0; i < cSENSORS.size(); i++)
+  {
+    frame.SetTemperature(static_cast<shared::tSensor>(i), (this->*cSENSORS[i].port).Get());
+  }
+  frame.SetRoomSetPoint(set_point_);
+  frame.SetOutdatedMask(outdated_mask_);
+  frame.SetImplausibleMask(implausible_mask_);
+  so_sensor_frame.Publish(frame, current_time);
+  temperature_rollup_.Add(frame);
+
+  // the complete trend (about 141 kB) is published rarely, the buckets since its newest one each minute;
+  // the ports keep both, so a connecting user interface gets the history at once
+  shared::tRollupLevel trend_level = shared::tTemperatureRollup::SelectLevel(par_temperature_trend_duration.Get());
+  rrlib::time::tTimestamp trend_end = current_time + shared::tTemperatureRollup::GetBucketDuration(trend_level);
+  if (last_temperature_trend_time_ == rrlib::time::cNO_TIME or last_temperature_trend_time_ + cTEMPERATURE_TREND_INTERVAL <= current_time)
+  {
+    rrlib::time::tTimestamp begin = current_time - par_temperature_trend_duration.Get();
+    std::vector<shared::tRollupBucket> trend = temperature_rollup_.GetBuckets(trend_level, begin, trend_end);
+    temperature_trend_update_begin_ = trend.empty() ? begin : shared::GetStart(trend.back());
+    so_temperature_trend.Publish(trend, current_time);
+    so_temperature_trend_update.Publish(std::vector<shared::tRollupBucket>(), current_time);
+    last_temperature_trend_time_ = current_time;
+    last_temperature_trend_update_time_ = current_time;
+  }
+  else if (last_temperature_trend_update_time_ + cTEMPERATURE_TREND_UPDATE_INTERVAL <= current_time)
+  {
+    so_temperature_trend_update.Publish(temperature_rollup_.GetBuckets(trend_level, temperature_trend_update_begin_, trend_end), current_time);
+    last_temperature_trend_update_time_ = current_time;
+  }
+
+  // log temperatures of new readings
+  if (temperature_log_.IsOpen() and check_plausibility
+      and last_temperature_logging_time_ + par_temperature_log_interval.Get() <= current_time)
+  {
+    shared::tTemperatureLogRecord record = shared::ToTemperatureLogRecord(frame);
+    temperature_log_.Write(&record, sizeof(record));
+    last_temperature_logging_time_ = current_time;
+  }
+
+  // lines and records lost because the log writers could not keep up
+  dropped_log_records_.Publish(static_cast<unsigned int>(temperature_log_.GetDroppedCount() + event_log_.GetDroppedCount()), current_time);
+}
+
+//----------------------------------------------------------------------
+// mController LogTemperatures
+//----------------------------------------------------------------------
+void mController::LogTemperatures(std::ostream &stream)
+{
+  for (size_t i = 0; i < tTemperatureSensors::eSENSOR_COUNT; i++)
+  {
+    stream << cSENSORS[i].label << " " << (this->*cSENSORS[i].port).Get().ValueFactored() << ((i + 1 < tTemperatureSensors::eSENSOR_COUNT) ? "; " : "");
+  }
 }
 
 //----------------------------------------------------------------------
@@ -419,19 +438,19 @@ void mController::Sense()
 //----------------------------------------------------------------------
 void mController::Control()
 {
+  // Control runs after Sense within the same cycle
+  auto now = cycle_time_;
+
   // reset if control mode changes
   if (ci_control_mode.HasChanged())
   {
-    co_pump_online_ground.Publish(false, rrlib::time::Now());
-    co_pump_online_room.Publish(false, rrlib::time::Now());
-    co_pump_online_solar.Publish(false, rrlib::time::Now());
-    if (control_state_ != nullptr)
+    co_pump_online_ground.Publish(false, now);
+    co_pump_online_room.Publish(false, now);
+    co_pump_online_solar.Publish(false, now);
+    control_state_.Reset();
+    if (event_log_.IsOpen())
     {
-      control_state_ = std::unique_ptr<heat_control_states::tState>(new heat_control_states::tReady());
-    }
-    if (event_log_file_.good())
-    {
-      event_log_file_ << rrlib::time::Now() << " Zustand: Neuer Heizungskontrollzustand <" << make_builder::GetEnumString(ci_control_mode.Get()) << ">\n";
+      shared::tLogLine(event_log_, shared::eLOG_DURABLE) << now << " Zustand: Neuer Heizungskontrollzustand <" << make_builder::GetEnumString(ci_control_mode.Get()) << ">\n";
     }
 
     co_control_mode.Publish(ci_control_mode.Get(), ci_control_mode.GetTimestamp());
@@ -443,9 +462,9 @@ void mController::Control()
     set_point_ += rrlib::si_units::tTemperature<double>(0.5);
     co_set_point_temperature.Publish(set_point_, ci_increase_set_point_temperature.GetTimestamp());
 
-    if (event_log_file_.good())
+    if (event_log_.IsOpen())
     {
-      event_log_file_ << rrlib::time::Now() << " Erhöhung der Solltemperatur auf " << set_point_ << "\n";
+      shared::tLogLine(event_log_) << now << " Erhöhung der Solltemperatur auf " << set_point_ << "\n";
     }
   }
   if (ci_decrease_set_point_temperature.HasChanged())
@@ -453,9 +472,9 @@ void mController::Control()
     set_point_ -= rrlib::si_units::tTemperature<double>(0.5);
     co_set_point_temperature.Publish(set_point_, ci_decrease_set_point_temperature.GetTimestamp());
 
-    if (event_log_file_.good())
+    if (event_log_.IsOpen())
     {
-      event_log_file_ << rrlib::time::Now() << " Reduzierung der Solltemperatur auf " << set_point_ << "\n";
+      shared::tLogLine(event_log_) << now << " Reduzierung der Solltemperatur auf " << set_point_ << "\n";
     }
   }
   if (ci_reset_set_point_temperature.HasChanged())
@@ -463,9 +482,9 @@ void mController::Control()
     set_point_ = par_temperature_set_point_room.Get();
     co_set_point_temperature.Publish(set_point_, ci_reset_set_point_temperature.GetTimestamp());
 
-    if (event_log_file_.good())
+    if (event_log_.IsOpen())
     {
-      event_log_file_ << rrlib::time::Now() << " Zurücksetzung der Solltemperatur auf " << set_point_ << "\n";
+      shared::tLogLine(event_log_) << now << " Zurücksetzung der Solltemperatur auf " << set_point_ << "\n";
     }
   }
 
@@ -474,72 +493,51 @@ void mController::Control()
   bool pump_solar_error = false;
   bool pump_room_error = false;
 
+  // the masks of Sense map failed sensors to the pumps depending on them (see cSENSORS)
   if ((this->error_ != tErrorState::eNO_ERROR))
   {
-    bool boiler_sensor_failure_ =
-      temperature_plausibility_error_condition_.at(tTemperatureSensors::eBOILER_MIDDLE_SENSOR) or
-      temperature_update_error_condition_.at(tTemperatureSensors::eBOILER_MIDDLE_SENSOR);
-    bool room_sensor_failure_ =
-      temperature_plausibility_error_condition_.at(tTemperatureSensors::eROOM_SENSOR) or
-      temperature_update_error_condition_.at(tTemperatureSensors::eROOM_SENSOR);
-    bool solar_sensor_failure_ =
-      temperature_plausibility_error_condition_.at(tTemperatureSensors::eSOLAR_SENSOR) or
-      temperature_update_error_condition_.at(tTemperatureSensors::eSOLAR_SENSOR);
-    bool ground_sensor_failure_ =
-      temperature_plausibility_error_condition_.at(tTemperatureSensors::eGROUND_SENSOR) or
-      temperature_update_error_condition_.at(tTemperatureSensors::eGROUND_SENSOR);
-
-    // error affects room pump -> boiler temperature outdated or implausible | room temperature outdated or implausible
-    if (boiler_sensor_failure_ or room_sensor_failure_)
+    pump_ground_error = pump_error_mask_ & cGROUND_PUMP;
+    pump_solar_error = pump_error_mask_ & cSOLAR_PUMP;
+    pump_room_error = pump_error_mask_ & cROOM_PUMP;
+
+    if (pump_room_error)
     {
-      pump_room_error = true;
-      co_pump_online_room.Publish(false, rrlib::time::Now());
+      co_pump_online_room.Publish(false, now);
     }
-
-    // error affects solar pump -> boiler temperature outdated or implausible | solar temperature outdated or implausible
-    if (boiler_sensor_failure_ or solar_sensor_failure_)
+    if (pump_solar_error)
     {
-      pump_solar_error = true;
-      co_pump_online_solar.Publish(false, rrlib::time::Now());
+      co_pump_online_solar.Publish(false, now);
     }
-
-    // error affects ground pump -> boiler temperature outdated or implausible | ground temperature outdated or implausible
-    if (boiler_sensor_failure_ or ground_sensor_failure_)
+    if (pump_ground_error)
     {
-      pump_ground_error = true;
-      co_pump_online_ground.Publish(false, rrlib::time::Now());
+      co_pump_online_ground.Publish(false, now);
     }
   }
 
-  co_pump_error_ground.Publish(pump_ground_error, rrlib::time::Now());
-  co_pump_error_room.Publish(pump_room_error, rrlib::time::Now());
-  co_pump_error_solar.Publish(pump_solar_error, rrlib::time::Now());
+  pump_error_ground_.Publish(pump_ground_error, now);
+  pump_error_room_.Publish(pump_room_error, now);
+  pump_error_solar_.Publish(pump_solar_error, now);
 
-  co_pump_working_ground.Publish(not pump_ground_error, rrlib::time::Now());
-  co_pump_working_room.Publish(not pump_room_error, rrlib::time::Now());
-  co_pump_working_solar.Publish(not pump_solar_error, rrlib::time::Now());
+  pump_working_ground_.Publish(not pump_ground_error, now);
+  pump_working_room_.Publish(not pump_room_error, now);
+  pump_working_solar_.Publish(not pump_solar_error, now);
+
+  // a prevented pump switch is logged once per pump error (the switch stays pending on every cycle)
+  prevented_switch_mask_ &= (pump_ground_error ? cGROUND_PUMP : 0) | (pump_room_error ? cROOM_PUMP : 0) | (pump_solar_error ? cSOLAR_PUMP : 0);
 
   // determine state
-  bool state_changed = false;
-  std::unique_ptr<heat_control_states::tState> next_state;
-  control_state_->ComputeControlState(next_state, temperatures_);
-  state_changed = control_state_->HasChanged();
+  bool state_changed = control_state_.ComputeControlState(temperatures_);
   if (state_changed)
   {
-    control_state_ = std::move(next_state);
-    co_heating_state.Publish(control_state_->GetCurrentState(), rrlib::time::Now());
+    co_heating_state.Publish(control_state_.GetCurrentState(), now);
 
-    if (event_log_file_.good())
+    if (event_log_.IsOpen())
     {
-      event_log_file_ << rrlib::time::Now() << " Automatischer Zustandswechsel: <" << make_builder::GetEnumString(control_state_->GetCurrentState());
-      event_log_file_ << ">   (Raum " << si_temperature_room.Get().ValueFactored() << "; ";
-      event_log_file_ << "Solar " << si_temperature_solar.Get().ValueFactored() << "; ";
-      event_log_file_ << "Bodenplatte " << si_temperature_ground.Get().ValueFactored() << "; ";
-      event_log_file_ << "Ofen " << si_temperature_furnace.Get().ValueFactored() << "; ";
-      event_log_file_ << "Garage " << si_temperature_garage.Get().ValueFactored() << "; ";
-      event_log_file_ << "Speicher (oben) " << si_temperature_boiler_top.Get().ValueFactored() << "; ";
-      event_log_file_ << "Speicher (mitte) " << si_temperature_boiler_middle.Get().ValueFactored() << "; ";
-      event_log_file_ << "Speicher (unten) " << si_temperature_boiler_bottom.Get().ValueFactored() << ")\n";
+      shared::tLogLine line(event_log_);
+      line << now << " Automatischer Zustandswechsel: <" << make_builder::GetEnumString(control_state_.GetCurrentState());
+      line << ">   (";
+      LogTemperatures(line);
+      line << ")\n";
     }
   }
 
@@ -549,9 +547,9 @@ void mController::Control()
     error_condition_ = false;
     state_changed = true;
 
-    if (event_log_file_.good())
+    if (event_log_.IsOpen())
     {
-      event_log_file_ << rrlib::time::Now() << " Automatischer Zustandswechsel: Wiederherstellung des Zustands nach einem Fehler.\n";
+      shared::tLogLine(event_log_, shared::eLOG_DURABLE) << now << " Automatischer Zustandswechsel: Wiederherstellung des Zustands nach einem Fehler.\n";
     }
   }
 
@@ -561,109 +559,112 @@ void mController::Control()
   case tControlModeType::eAUTOMATIC:
   {
     // get pump settings
-    auto pumps = control_state_->GetPumpSettings();
+    auto pumps = control_state_.GetPumpSettings();
 
     // check if state differs from last state and update time window is valid
     if (this->pump_last_state_.at(tPumps::eGROUND) != pumps.IsGroundOnline() and
-        this->pump_switch_time_.at(tPumps::eGROUND) + par_max_pump_update_duration.Get() < rrlib::time::Now())
+        this->pump_switch_time_.at(tPumps::eGROUND) + par_max_pump_update_duration.Get() < now)
     {
       // no error condition
-      if (not pump_room_error)
+      if (not pump_ground_error)
       {
-        co_pump_online_ground.Publish(pumps.IsGroundOnline(), rrlib::time::Now());
+        co_pump_online_ground.Publish(pumps.IsGroundOnline(), now);
         this->pump_last_state_.at(tPumps::eGROUND) = pumps.IsGroundOnline();
-        this->pump_switch_time_.at(tPumps::eGROUND) = rrlib::time::Now();
+        this->pump_switch_time_.at(tPumps::eGROUND) = now;
 
-        if (event_log_file_.good())
+        if (event_log_.IsOpen())
         {
           if (pumps.IsGroundOnline())
           {
-            event_log_file_ << rrlib::time::Now() << " Automatischer Zustandswechsel: Aktiviere Pumpe Bodenplatte.\n";
+            shared::tLogLine(event_log_, shared::eLOG_DURABLE) << now << " Automatischer Zustandswechsel: Aktiviere Pumpe Bodenplatte.\n";
           }
           else
           {
-            event_log_file_ << rrlib::time::Now() << " Automatischer Zustandswechsel: Deaktiviere Pumpe Bodenplatte.\n";
+            shared::tLogLine(event_log_, shared::eLOG_DURABLE) << now << " Automatischer Zustandswechsel: Deaktiviere Pumpe Bodenplatte.\n";
           }
         }
       }
       // error condition
       else
       {
-        co_pump_online_ground.Publish(false, rrlib::time::Now());
-        if (event_log_file_.good())
+        co_pump_online_ground.Publish(false, now);
+        if (event_log_.IsOpen() and not (prevented_switch_mask_ & cGROUND_PUMP))
         {
-          event_log_file_ << rrlib::time::Now() << " Fehlerzustand: Zustandswechsel von Pumpe Boden verhindert. Pumpe deaktiviert.\n";
+          shared::tLogLine(event_log_, shared::eLOG_DURABLE) << now << " Fehlerzustand: Zustandswechsel von Pumpe Boden verhindert. Pumpe deaktiviert.\n";
         }
+        prevented_switch_mask_ |= cGROUND_PUMP;
       }
     }
 
     // check if state differs from last state and update time window is valid
     if (this->pump_last_state_.at(tPumps::eROOM) != pumps.IsRoomOnline() and
-        this->pump_switch_time_.at(tPumps::eROOM) + par_max_pump_update_duration.Get() < rrlib::time::Now())
+        this->pump_switch_time_.at(tPumps::eROOM) + par_max_pump_update_duration.Get() < now)
     {
       // no error condition
       if (not pump_room_error)
       {
-        co_pump_online_room.Publish(pumps.IsRoomOnline(), rrlib::time::Now());
+        co_pump_online_room.Publish(pumps.IsRoomOnline(), now);
         this->pump_last_state_.at(tPumps::eROOM) = pumps.IsRoomOnline();
-        this->pump_switch_time_.at(tPumps::eROOM) = rrlib::time::Now();
+        this->pump_switch_time_.at(tPumps::eROOM) = now;
 
-        if (event_log_file_.good())
+        if (event_log_.IsOpen())
         {
           if (pumps.IsRoomOnline())
           {
-            event_log_file_ << rrlib::time::Now() << " Automatischer Zustandswechsel: Aktiviere Pumpe Raum.\n";
+            shared::tLogLine(event_log_, shared::eLOG_DURABLE) << now << " Automatischer Zustandswechsel: Aktiviere Pumpe Raum.\n";
           }
           else
           {
-            event_log_file_ << rrlib::time::Now() << " Automatischer Zustandswechsel: Deaktiviere Pumpe Raum.\n";
+            shared::tLogLine(event_log_, shared::eLOG_DURABLE) << now << " Automatischer Zustandswechsel: Deaktiviere Pumpe Raum.\n";
           }
         }
       }
       // error condition
       else
       {
-        co_pump_online_room.Publish(false, rrlib::time::Now());
-        if (event_log_file_.good())
+        co_pump_online_room.Publish(false, now);
+        if (event_log_.IsOpen() and not (prevented_switch_mask_ & cROOM_PUMP))
         {
-          event_log_file_ << rrlib::time::Now() << " Fehlerzustand: Zustandswechsel von Pumpe Raum verhindert. Pumpe deaktiviert.\n";
+          shared::tLogLine(event_log_, shared::eLOG_DURABLE) << now << " Fehlerzustand: Zustandswechsel von Pumpe Raum verhindert. Pumpe deaktiviert.\n";
         }
+        prevented_switch_mask_ |= cROOM_PUMP;
       }
     }
 
     // solar pump cannot be disabled
     // check if state differs from last state and update time window is valid
     if (this->pump_last_state_.at(tPumps::eSOLAR) != pumps.IsSolarOnline() and
-        this->pump_switch_time_.at(tPumps::eSOLAR) + par_max_pump_update_duration.Get() < rrlib::time::Now())
+        this->pump_switch_time_.at(tPumps::eSOLAR) + par_max_pump_update_duration.Get() < now)
     {
       // bo error condition
       if (not pump_solar_error)
       {
-        co_pump_online_solar.Publish(pumps.IsSolarOnline(), rrlib::time::Now());
+        co_pump_online_solar.Publish(pumps.IsSolarOnline(), now);
 
         this->pump_last_state_.at(tPumps::eSOLAR) = pumps.IsSolarOnline();
-        this->pump_switch_time_.at(tPumps::eSOLAR) = rrlib::time::Now();
+        this->pump_switch_time_.at(tPumps::eSOLAR) = now;
 
-        if (event_log_file_.good())
+        if (event_log_.IsOpen())
         {
           if (pumps.IsSolarOnline())
           {
-            event_log_file_ << rrlib::time::Now() << " Automatischer Zustandswechsel: Aktiviere Pumpe Solar.\n";
+            shared::tLogLine(event_log_, shared::eLOG_DURABLE) << now << " Automatischer Zustandswechsel: Aktiviere Pumpe Solar.\n";
           }
           else
           {
-            event_log_file_ << rrlib::time::Now() << " Automatischer Zustandswechsel: Deaktiviere Pumpe Solar.\n";
+            shared::tLogLine(event_log_, shared::eLOG_DURABLE) << now << " Automatischer Zustandswechsel: Deaktiviere Pumpe Solar.\n";
           }
         }
       }
       // error condition
       else
       {
-        co_pump_online_solar.Publish(false, rrlib::time::Now());
-        if (event_log_file_.good())
+        co_pump_online_solar.Publish(false, now);
+        if (event_log_.IsOpen() and not (prevented_switch_mask_ & cSOLAR_PUMP))
         {
-          event_log_file_ << rrlib::time::Now() << " Fehlerzustand: Zustandswechsel von Pumpe Solar verhindert. Pumpe deaktiviert.\n";
+          shared::tLogLine(event_log_, shared::eLOG_DURABLE) << now << " Fehlerzustand: Zustandswechsel von Pumpe Solar verhindert. Pumpe deaktiviert.\n";
         }
+        prevented_switch_mask_ |= cSOLAR_PUMP;
       }
 
     }
@@ -672,9 +673,9 @@ void mController::Control()
   case tControlModeType::eSTOP:
     if (ci_control_mode.HasChanged())
     {
-      co_pump_online_ground.Publish(false, rrlib::time::Now());
-      co_pump_online_room.Publish(false, rrlib::time::Now());
-      co_pump_online_solar.Publish(false, rrlib::time::Now());
+      co_pump_online_ground.Publish(false, now);
+      co_pump_online_room.Publish(false, now);
+      co_pump_online_solar.Publish(false, now);
     }
     break;
   case tControlModeType::eMANUAL:
@@ -683,15 +684,15 @@ void mController::Control()
     {
       co_pump_online_ground.Publish(ci_manual_pump_online_ground.Get());
 
-      if (event_log_file_.good())
+      if (event_log_.IsOpen())
       {
         if (ci_manual_pump_online_ground.Get())
         {
-          event_log_file_ << rrlib::time::Now() << " Manueller Zustandswechsel: Aktiviere Pumpe Bodenplatte.\n";
+          shared::tLogLine(event_log_, shared::eLOG_DURABLE) << now << " Manueller Zustandswechsel: Aktiviere Pumpe Bodenplatte.\n";
         }
         else
         {
-          event_log_file_ << rrlib::time::Now() << " Manueller Zustandswechsel: Deaktiviere Pumpe Bodenplatte.\n";
+          shared::tLogLine(event_log_, shared::eLOG_DURABLE) << now << " Manueller Zustandswechsel: Deaktiviere Pumpe Bodenplatte.\n";
         }
       }
     }
@@ -699,15 +700,15 @@ void mController::Control()
     {
       co_pump_online_room.Publish(ci_manual_pump_online_room.Get());
 
-      if (event_log_file_.good())
+      if (event_log_.IsOpen())
       {
         if (ci_manual_pump_online_room.Get())
         {
-          event_log_file_ << rrlib::time::Now() << " Manueller Zustandswechsel: Aktiviere Pumpe Raum.\n";
+          shared::tLogLine(event_log_, shared::eLOG_DURABLE) << now << " Manueller Zustandswechsel: Aktiviere Pumpe Raum.\n";
         }
         else
         {
-          event_log_file_ << rrlib::time::Now() << " Manueller Zustandswechsel: Deaktiviere Pumpe Raum.\n";
+          shared::tLogLine(event_log_, shared::eLOG_DURABLE) << now << " Manueller Zustandswechsel: Deaktiviere Pumpe Raum.\n";
         }
       }
     }
@@ -715,57 +716,57 @@ void mController::Control()
     {
       co_pump_online_solar.Publish(ci_manual_pump_online_solar.Get());
 
-      if (event_log_file_.good())
+      if (event_log_.IsOpen())
       {
         if (ci_manual_pump_online_room.Get())
         {
-          event_log_file_ << rrlib::time::Now() << " Manueller Zustandswechsel: Aktiviere Pumpe Solar.\n";
+          shared::tLogLine(event_log_, shared::eLOG_DURABLE) << now << " Manueller Zustandswechsel: Aktiviere Pumpe Solar.\n";
         }
         else
         {
-          event_log_file_ << rrlib::time::Now() << " Manueller Zustandswechsel: Deaktiviere Pumpe Solar.\n";
+          shared::tLogLine(event_log_, shared::eLOG_DURABLE) << now << " Manueller Zustandswechsel: Deaktiviere Pumpe Solar.\n";
         }
       }
     }
   }
   break;
   default:
-    co_pump_online_ground.Publish(false, rrlib::time::Now());
-    co_pump_online_room.Publish(false, rrlib::time::Now());
-    co_pump_online_solar.Publish(false, rrlib::time::Now());
+    co_pump_online_ground.Publish(false, now);
+    co_pump_online_room.Publish(false, now);
+    co_pump_online_solar.Publish(false, now);
   };
 
   // led control
   auto boiler = si_temperature_boiler_middle.Get();
   if (boiler <= rrlib::si_units::tCelsius<double>(25.0))
   {
-    co_led_online_green.Publish(false, rrlib::time::Now());
-    co_led_online_yellow.Publish(false, rrlib::time::Now());
-    co_led_online_red.Publish(true, rrlib::time::Now());
+    led_online_green_.Publish(false, now);
+    led_online_yellow_.Publish(false, now);
+    led_online_red_.Publish(true, now);
   }
   else if (boiler > rrlib::si_units::tCelsius<double>(25.0) && boiler <= rrlib::si_units::tCelsius<double>(30.0))
   {
-    co_led_online_green.Publish(false, rrlib::time::Now());
-    co_led_online_yellow.Publish(true, rrlib::time::Now());
-    co_led_online_red.Publish(true, rrlib::time::Now());
+    led_online_green_.Publish(false, now);
+    led_online_yellow_.Publish(true, now);
+    led_online_red_.Publish(true, now);
   }
   else if (boiler > rrlib::si_units::tCelsius<double>(30.0) && boiler <= rrlib::si_units::tCelsius<double>(40.0))
   {
-    co_led_online_green.Publish(false, rrlib::time::Now());
-    co_led_online_yellow.Publish(true, rrlib::time::Now());
-    co_led_online_red.Publish(false, rrlib::time::Now());
+    led_online_green_.Publish(false, now);
+    led_online_yellow_.Publish(true, now);
+    led_online_red_.Publish(false, now);
   }
   else if (boiler > rrlib::si_units::tCelsius<double>(40.0) && boiler <= rrlib::si_units::tCelsius<double>(45.0))
   {
-    co_led_online_green.Publish(true, rrlib::time::Now());
-    co_led_online_yellow.Publish(true, rrlib::time::Now());
-    co_led_online_red.Publish(false, rrlib::time::Now());
+    led_online_green_.Publish(true, now);
+    led_online_yellow_.Publish(true, now);
+    led_online_red_.Publish(false, now);
   }
   else if (boiler > rrlib::si_units::tCelsius<double>(45.0))
   {
-    co_led_online_green.Publish(true, rrlib::time::Now());
-    co_led_online_yellow.Publish(false, rrlib::time::Now());
-    co_led_online_red.Publish(false, rrlib::time::Now());
+    led_online_green_.Publish(true, now);
+    led_online_yellow_.Publish(false, now);
+    led_online_red_.Publish(false, now);
   }
 
 }
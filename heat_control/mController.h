@@ -41,12 +41,19 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
-#include <fstream>
+#include <ostream>
 
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
-#include "projects/smart_home/heat_control_states/tReady.h"
+#include "projects/smart_home/heat_control/tSensorSupervision.h"
+#include "projects/smart_home/heat_control_states/tHeatingCircuits.h"
+#include "projects/smart_home/shared/tAsyncLogWriter.h"
+#include "projects/smart_home/shared/tChangeGatedOutput.h"
+#include "projects/smart_home/shared/tCycleClock.h"
+#include "projects/smart_home/shared/tSensorFrame.h"
+#include "projects/smart_home/shared/tTemperatureLog.h"
+#include "projects/smart_home/shared/tTemperatureRollup.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -123,29 +130,24 @@ public:
   tSensorInput<rrlib::si_units::tCelsius<double>> si_temperature_garage;
 
   tSensorOutput<rrlib::si_units::tCelsius<double>> so_temperature_room_combined;
+  tSensorOutput<shared::tSensorFrame> so_sensor_frame;
+
+  // history of the last temperature trend duration, at most 1440 buckets (published each hour)
+  tSensorOutput<std::vector<shared::tRollupBucket>> so_temperature_trend;
+  // buckets since the newest bucket of so_temperature_trend (published each minute), replace buckets with the same start
+  tSensorOutput<std::vector<shared::tRollupBucket>> so_temperature_trend_update;
+
+  // bit masks of outdated and implausible sensors (bit i belongs to tTemperatureSensors i, bit 8 to the external room sensor)
+  tSensorOutput<uint16_t> so_outdated_temperatures;
+  tSensorOutput<uint16_t> so_implausible_temperatures;
 
-  tSensorOutput<bool> so_implausible_temperature_boiler_top;
-  tSensorOutput<bool> so_implausible_temperature_boiler_middle;
-  tSensorOutput<bool> so_implausible_temperature_boiler_bottom;
-  tSensorOutput<bool> so_implausible_temperature_room;
-  tSensorOutput<bool> so_implausible_temperature_room_external;
-  tSensorOutput<bool> so_implausible_temperature_solar;
-  tSensorOutput<bool> so_implausible_temperature_ground;
-  tSensorOutput<bool> so_implausible_temperature_furnace;
-  tSensorOutput<bool> so_implausible_temperature_garage;
-  tSensorOutput<bool> so_outdated_temperature_boiler_top;
-  tSensorOutput<bool> so_outdated_temperature_boiler_middle;
-  tSensorOutput<bool> so_outdated_temperature_boiler_bottom;
-  tSensorOutput<bool> so_outdated_temperature_room;
-  tSensorOutput<bool> so_outdated_temperature_room_external;
-  tSensorOutput<bool> so_outdated_temperature_solar;
-  tSensorOutput<bool> so_outdated_temperature_ground;
-  tSensorOutput<bool> so_outdated_temperature_furnace;
-  tSensorOutput<bool> so_outdated_temperature_garage;
   tSensorOutput<tErrorState> so_error_state;
   tSensorOutput<bool> so_error_condition;
   tSensorOutput<rrlib::time::tTimestamp> so_last_error_time;
 
+  // number of log lines dropped because the log writer threads could not keep up
+  tSensorOutput<unsigned int> so_dropped_log_records;
+
   tControllerInput<tControlModeType> ci_control_mode;
   tControllerInput<bool> ci_manual_pump_online_solar;
   tControllerInput<bool> ci_manual_pump_online_ground;
@@ -181,10 +183,12 @@ public:
   tParameter<rrlib::time::tDuration> par_max_update_duration;
   // max allow duration until pump changes
   tParameter<rrlib::time::tDuration> par_max_pump_update_duration;
-  // logging frequency of temperatures (e.g. each hour)
+  // logging frequency of temperatures (0 logs every sensor update)
   tParameter<rrlib::time::tDuration> par_temperature_log_interval;
   // logging frequency of temperature update errors (e.g. each 30min)
   tParameter<rrlib::time::tDuration> par_temperature_error_log_interval;
+  // time span of so_temperature_trend
+  tParameter<rrlib::time::tDuration> par_temperature_trend_duration;
 
 //----------------------------------------------------------------------
 // Public methods and typedefs
@@ -193,6 +197,23 @@ public:
 
   mController(core::tFrameworkElement *parent, const std::string &name = "Controller");
 
+  /*!
+   * Replaces the clock of the controller (shared::GetCycleClock() by default)
+   * @param clock clock (has to outlive the module)
+   */
+  inline void SetClock(shared::tCycleClock &clock)
+  {
+    clock_ = &clock;
+  }
+
+  /*!
+   * Live temperature history of the controller (for modules running in the same thread)
+   */
+  inline const shared::tTemperatureRollup &GetTemperatureRollup() const
+  {
+    return temperature_rollup_;
+  }
+
 //----------------------------------------------------------------------
 // Protected methods
 //----------------------------------------------------------------------
@@ -217,37 +238,77 @@ private:
   virtual void OnParameterChange() override;
 
   /*!
-   * Checks if a temperature value is within bounds
-   * @return within bounds
+   * Writes the temperatures of all sensors of tTemperatureSensors to a log line
    */
-  inline bool IsTemperatureInBounds(const rrlib::si_units::tCelsius<double> & temperature,
-                                    const rrlib::si_units::tCelsius<double> & upper_bound,
-                                    const rrlib::si_units::tCelsius<double> & lower_bound) const
-  {
-    return (temperature.ValueFactored() <= upper_bound.ValueFactored()) and (temperature.ValueFactored() >= lower_bound.ValueFactored());
-  }
+  void LogTemperatures(std::ostream &stream);
+
+  // clock and its timestamp of the current cycle (sampled once at the beginning of Sense)
+  shared::tCycleClock *clock_;
+  rrlib::time::tTimestamp cycle_time_;
 
-  std::unique_ptr<heat_control_states::tState> control_state_;
+  heat_control_states::tHeatingCircuits control_state_;
   rrlib::si_units::tCelsius<double> set_point_;
 
   tErrorState error_;
   bool error_condition_;
 
+  // last published sensor health (the ports start with 0, i.e. all sensors healthy)
+  uint16_t outdated_mask_;
+  uint16_t implausible_mask_;
+
+  // sensor checks of the current cycle and pumps (bit i belongs to tPumps i) depending on an outdated or implausible sensor
+  tSensorSupervision supervision_;
+  uint8_t pump_error_mask_;
+
+  // pumps whose prevented switch has already been logged during the current pump error
+  uint8_t prevented_switch_mask_;
+
+  // outputs published only on change (and heartbeat)
+  shared::tChangeGatedOutput<tErrorState, tSensorOutput<tErrorState>> error_state_;
+  shared::tChangeGatedOutput<bool, tSensorOutput<bool>> error_condition_output_;
+  shared::tChangeGatedOutput<bool, tControllerOutput<bool>> pump_error_solar_;
+  shared::tChangeGatedOutput<bool, tControllerOutput<bool>> pump_error_room_;
+  shared::tChangeGatedOutput<bool, tControllerOutput<bool>> pump_error_ground_;
+  shared::tChangeGatedOutput<bool, tControllerOutput<bool>> pump_working_solar_;
+  shared::tChangeGatedOutput<bool, tControllerOutput<bool>> pump_working_room_;
+  shared::tChangeGatedOutput<bool, tControllerOutput<bool>> pump_working_ground_;
+  shared::tChangeGatedOutput<bool, tControllerOutput<bool>> led_online_red_;
+  shared::tChangeGatedOutput<bool, tControllerOutput<bool>> led_online_yellow_;
+  shared::tChangeGatedOutput<bool, tControllerOutput<bool>> led_online_green_;
+  shared::tChangeGatedOutput<unsigned int, tSensorOutput<unsigned int>> dropped_log_records_;
+
   shared::tTemperatures temperatures_;
-  std::array<bool, tTemperatureSensors::eSENSOR_COUNT> temperature_update_error_condition_;
-  std::array<bool, tTemperatureSensors::eSENSOR_COUNT> temperature_plausibility_error_condition_;
 
   std::array<rrlib::time::tTimestamp, tPumps::eNUMBER_STATES> pump_switch_time_;
   std::array<bool, tPumps::eNUMBER_STATES> pump_last_state_;
 
-  std::fstream temperature_log_file_;
-  std::fstream event_log_file_;
+  // log files (event log as text, temperatures as binary records), written by background threads
+  shared::tAsyncLogWriter temperature_log_;
+  shared::tAsyncLogWriter event_log_;
   rrlib::time::tTimestamp last_temperature_logging_time_;
   rrlib::time::tTimestamp last_temperature_outdated_logging_time_;
   rrlib::time::tTimestamp last_temperature_implausible_logging_time_;
 
+  // live temperature history in memory (about 1.7 MB)
+  shared::tTemperatureRollup temperature_rollup_;
+  rrlib::time::tTimestamp last_temperature_trend_time_;
+  rrlib::time::tTimestamp last_temperature_trend_update_time_;
+  rrlib::time::tTimestamp temperature_trend_update_begin_;
 
 
+
+};
+
+typedef mController::tSensorInput<rrlib::si_units::tCelsius<double>> tTemperatureInput;
+
+//! Supervision of one temperature sensor
+struct tSensorDescriptor
+{
+  tTemperatureInput mController::*port;
+  double lower_bound;
+  double upper_bound;
+  const char *label;
+  uint8_t pumps;
 };
 
 //----------------------------------------------------------------------
@@ -0,0 +1,175 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/heat_control/mHouseSimulator.cpp
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ */
+//----------------------------------------------------------------------
+#include "projects/smart_home/heat_control/mHouseSimulator.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace heat_control
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+static runtime_construction::tStandardCreateModuleAction<mHouseSimulator> cCREATE_ACTION_FOR_M_HOUSESIMULATOR("HouseSimulator");
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// mHouseSimulator constructor
+//----------------------------------------------------------------------
+mHouseSimulator::mHouseSimulator(core::tFrameworkElement *parent, const std::string &name) :
+  tModule(parent, name, false),
+  in_pump_online_solar(false),
+  in_pump_online_room(false),
+  in_pump_online_ground(false),
+  par_ambient_temperature_mean(5.0),
+  par_ambient_temperature_amplitude(5.0),
+  par_peak_irradiance(600.0),
+  par_furnace_power(8000.0),
+  clock_(&shared::GetCycleClock()),
+  model_(),
+  last_update_(rrlib::time::cNO_TIME),
+  simulation_start_(rrlib::time::cNO_TIME),
+  system_start_(rrlib::time::cNO_TIME),
+  update_count_(0)
+{
+  for (std::size_t i = 0; i < cHOUSE_SENSOR_COUNT; i++)
+  {
+    out_voltage_raw.emplace_back(tOutput<unsigned short>("Voltage Raw " + std::to_string(i), this));
+    par_pt_type.emplace_back(tParameter<shared::tPTType>("PT Type " + std::to_string(i), this, shared::tPTType::ePT1000));
+    par_pre_resistance.emplace_back(tParameter<rrlib::si_units::tElectricResistance<double>>("Pre Resistance " + std::to_string(i), this, 1000.0));
+  }
+  nominal_resistance_.fill(1000.0);
+  pre_resistance_.fill(1000.0);
+}
+
+//----------------------------------------------------------------------
+// mHouseSimulator destructor
+//----------------------------------------------------------------------
+mHouseSimulator::~mHouseSimulator()
+{
+  if (update_count_ > 0)
+  {
+    double simulated = std::chrono::duration_cast<std::chrono::duration<double>>(last_update_ - simulation_start_).count();
+    double system = std::chrono::duration_cast<std::chrono::duration<double>>(rrlib::time::Now() - system_start_).count();
+    RRLIB_LOG_PRINT(USER, "Simulated ", simulated / 3600.0, " h in ", system, " s (", update_count_, " cycles, ",
+                    model_.GetStepCount(), " model steps, ", (system > 0.0 ? simulated / system : 0.0), "x real time)");
+  }
+}
+
+//----------------------------------------------------------------------
+// mHouseSimulator OnParameterChange
+//----------------------------------------------------------------------
+void mHouseSimulator::OnParameterChange()
+{
+  for (std::size_t i = 0; i < cHOUSE_SENSOR_COUNT; i++)
+  {
+    switch (par_pt_type[i].Get())
+    {
+    case shared::tPTType::ePT100:
+      nominal_resistance_[i] = 100.0;
+      break;
+    case shared::tPTType::ePT500:
+      nominal_resistance_[i] = 500.0;
+      break;
+    case shared::tPTType::ePT1000:
+    default:
+      nominal_resistance_[i] = 1000.0;
+      break;
+    }
+    pre_resistance_[i] = par_pre_resistance[i].Get().Value();
+  }
+  model_.SetWeather(par_ambient_temperature_mean.Get().ValueFactored(), par_ambient_temperature_amplitude.Get(), par_peak_irradiance.Get());
+  model_.SetFurnacePower(par_furnace_power.Get());
+}
+
+//----------------------------------------------------------------------
+// mHouseSimulator Update
+//----------------------------------------------------------------------
+void mHouseSimulator::Update()
+{
+  auto now = clock_->Now();
+  if (last_update_ == rrlib::time::cNO_TIME)
+  {
+    simulation_start_ = now;
+    system_start_ = rrlib::time::Now();
+  }
+  else if (now > last_update_)
+  {
+    model_.SetPumps(in_pump_online_solar.Get(), in_pump_online_room.Get(), in_pump_online_ground.Get());
+    model_.Advance(last_update_, now - last_update_);
+  }
+  last_update_ = now;
+  update_count_++;
+
+  for (std::size_t i = 0; i < cHOUSE_SENSOR_COUNT; i++)
+  {
+    out_voltage_raw[i].Publish(tHouseModel::GetADValue(model_.GetTemperature(static_cast<shared::tSensor>(i)), nominal_resistance_[i], pre_resistance_[i]), now);
+  }
+
+  double seconds_of_day = tHouseModel::GetSecondsOfDay(now);
+  out_temperature_ambient.Publish(rrlib::si_units::tCelsius<double>(model_.GetAmbientTemperature(seconds_of_day)), now);
+  out_irradiance.Publish(model_.GetIrradiance(seconds_of_day), now);
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
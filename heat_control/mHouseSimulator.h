@@ -0,0 +1,171 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/heat_control/mHouseSimulator.h
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ * \brief Contains mHouseSimulator
+ *
+ * \b mHouseSimulator
+ *
+ * module that simulates the house and provides MCP3008 output codes of the temperature sensors.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __projects__smart_home__heat_control__mHouseSimulator_h__
+#define __projects__smart_home__heat_control__mHouseSimulator_h__
+
+#include "plugins/structure/tModule.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "projects/smart_home/heat_control/tHouseModel.h"
+#include "projects/smart_home/shared/mPTArray.h"
+#include "projects/smart_home/shared/tCycleClock.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace heat_control
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! SHORT_DESCRIPTION
+/*!
+ * module that simulates the house and provides MCP3008 output codes of the temperature sensors.
+ *
+ * Replaces the GPIO interface for hardware-free runs. Each Update integrates the tHouseModel
+ * from the previous to the current time of the cycle clock with the pump states of the
+ * controller and publishes one raw code per sensor (indexed by tTemperatureSensors).
+ * PT type and pre resistance of each channel have to match the configuration of the PT array.
+ * Combined with a simulated clock (see shared::tSimulatedClock), the house runs faster than real time.
+ */
+class mHouseSimulator : public structure::tModule
+{
+
+//----------------------------------------------------------------------
+// Ports (These are the only variables that may be declared public)
+//----------------------------------------------------------------------
+public:
+
+  tInput<bool> in_pump_online_solar;
+  tInput<bool> in_pump_online_room;
+  tInput<bool> in_pump_online_ground;
+
+  std::vector<tOutput<unsigned short>> out_voltage_raw;
+
+  tOutput<rrlib::si_units::tCelsius<double>> out_temperature_ambient;
+  // irradiance on the collector [W/m^2]
+  tOutput<double> out_irradiance;
+
+  std::vector<tParameter<shared::tPTType>> par_pt_type;
+  std::vector<tParameter<rrlib::si_units::tElectricResistance<double>>> par_pre_resistance;
+
+  tParameter<rrlib::si_units::tCelsius<double>> par_ambient_temperature_mean;
+  // daily amplitude of the ambient temperature [K]
+  tParameter<double> par_ambient_temperature_amplitude;
+  // irradiance at noon [W/m^2]
+  tParameter<double> par_peak_irradiance;
+  // heating power of the furnace during its daily firing [W]
+  tParameter<double> par_furnace_power;
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  mHouseSimulator(core::tFrameworkElement *parent, const std::string &name = "HouseSimulator");
+
+  /*!
+   * Replaces the clock of the simulation (shared::GetCycleClock() by default)
+   * @param clock clock (has to outlive the module)
+   */
+  inline void SetClock(shared::tCycleClock &clock)
+  {
+    clock_ = &clock;
+  }
+
+//----------------------------------------------------------------------
+// Protected methods
+//----------------------------------------------------------------------
+protected:
+
+  /*! Destructor
+   *
+   * The destructor of modules is declared protected to avoid accidental deletion. Deleting
+   * modules is already handled by the framework.
+   */
+  ~mHouseSimulator();
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  virtual void OnParameterChange() override;
+
+  virtual void Update() override;
+
+  shared::tCycleClock *clock_;
+
+  tHouseModel model_;
+
+  // nominal resistance (e.g. 1000 Ohm for PT1000) and pre resistance per channel
+  std::array<double, cHOUSE_SENSOR_COUNT> nominal_resistance_;
+  std::array<double, cHOUSE_SENSOR_COUNT> pre_resistance_;
+
+  rrlib::time::tTimestamp last_update_;
+
+  // throughput statistics
+  rrlib::time::tTimestamp simulation_start_;
+  rrlib::time::tTimestamp system_start_;
+  uint64_t update_count_;
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+
+#endif
@@ -82,7 +82,13 @@ mPumpInterface::mPumpInterface(core::tFrameworkElement *parent, const std::strin
   out_gpio_pump_online_ground(true),
   out_gpio_pump_led_online_solar(false),
   out_gpio_pump_led_online_room(false),
-  out_gpio_pump_led_online_ground(false)
+  out_gpio_pump_led_online_ground(false),
+  gpio_pump_online_solar_(out_gpio_pump_online_solar),
+  gpio_pump_online_room_(out_gpio_pump_online_room),
+  gpio_pump_online_ground_(out_gpio_pump_online_ground),
+  gpio_pump_led_online_solar_(out_gpio_pump_led_online_solar),
+  gpio_pump_led_online_room_(out_gpio_pump_led_online_room),
+  gpio_pump_led_online_ground_(out_gpio_pump_led_online_ground)
 {}
 
 //----------------------------------------------------------------------
@@ -96,24 +102,14 @@ mPumpInterface::~mPumpInterface()
 //----------------------------------------------------------------------
 void mPumpInterface::Update()
 {
-  if (this->InputChanged())
-  {
-    if (in_pump_online_solar.HasChanged())
-    {
-      out_gpio_pump_online_solar.Publish(not in_pump_online_solar.Get());
-      out_gpio_pump_led_online_solar.Publish(in_pump_online_solar.Get());
-    }
-    if (in_pump_online_ground.HasChanged())
-    {
-      out_gpio_pump_online_ground.Publish(not in_pump_online_ground.Get());
-      out_gpio_pump_led_online_ground.Publish(in_pump_online_ground.Get());
-    }
-    if (in_pump_online_room.HasChanged())
-    {
-      out_gpio_pump_online_room.Publish(not in_pump_online_room.Get());
-      out_gpio_pump_led_online_room.Publish(in_pump_online_room.Get());
-    }
-  }
+  // the gated outputs only forward changes, the relays are low active
+  auto now = rrlib::time::Now();
+  gpio_pump_online_solar_.Publish(not in_pump_online_solar.Get(), now);
+  gpio_pump_led_online_solar_.Publish(in_pump_online_solar.Get(), now);
+  gpio_pump_online_ground_.Publish(not in_pump_online_ground.Get(), now);
+  gpio_pump_led_online_ground_.Publish(in_pump_online_ground.Get(), now);
+  gpio_pump_online_room_.Publish(not in_pump_online_room.Get(), now);
+  gpio_pump_led_online_room_.Publish(in_pump_online_room.Get(), now);
 }
 
 //----------------------------------------------------------------------
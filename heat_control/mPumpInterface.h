@@ -45,6 +45,7 @@
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "projects/smart_home/shared/tChangeGatedOutput.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -113,6 +114,13 @@ private:
 
   virtual void Update() override;
 
+  shared::tChangeGatedOutput<bool, tOutput<bool>> gpio_pump_online_solar_;
+  shared::tChangeGatedOutput<bool, tOutput<bool>> gpio_pump_online_room_;
+  shared::tChangeGatedOutput<bool, tOutput<bool>> gpio_pump_online_ground_;
+  shared::tChangeGatedOutput<bool, tOutput<bool>> gpio_pump_led_online_solar_;
+  shared::tChangeGatedOutput<bool, tOutput<bool>> gpio_pump_led_online_room_;
+  shared::tChangeGatedOutput<bool, tOutput<bool>> gpio_pump_led_online_ground_;
+
 };
 
 //----------------------------------------------------------------------
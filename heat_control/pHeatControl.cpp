@@ -38,7 +38,9 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include <algorithm>
 #include <chrono>
+#include <cstdlib>
 
 //----------------------------------------------------------------------
 // Internal includes with ""
@@ -46,6 +48,7 @@
 #include <cassert>
 
 #include "projects/smart_home/heat_control/gHeatControl.h"
+#include "projects/smart_home/shared/tCycleClock.h"
 
 //----------------------------------------------------------------------
 // Namespace usage
@@ -71,7 +74,18 @@ bool make_all_port_links_unique = true;
 // StartUp
 //----------------------------------------------------------------------
 void StartUp()
-{}
+{
+#ifdef _LIB_WIRING_PI_PRESENT_
+  // GPIO sensors are sampled in system time, only the house simulator follows simulated time
+  if (std::getenv("SMART_HOME_TIME_SCALE"))
+  {
+    RRLIB_LOG_PRINT(WARNING, "SMART_HOME_TIME_SCALE is ignored, as the sensors are read from the GPIO hardware.");
+  }
+#else
+  // SMART_HOME_TIME_SCALE=<factor> runs the controllers and the house simulator on accelerated simulated time
+  finroc::smart_home::shared::ConfigureCycleClockFromEnvironment();
+#endif
+}
 
 //----------------------------------------------------------------------
 // CreateMainGroup
@@ -79,7 +93,15 @@ void StartUp()
 void CreateMainGroup(const std::vector<std::string> &remaining_arguments)
 {
   auto main_thread = new finroc::structure::tTopLevelThreadContainer<>("Main Thread", __FILE__".xml", true, make_all_port_links_unique);
-  main_thread->SetCycleTime(std::chrono::milliseconds(200));
+  // on simulated time, the cycle covers 200 ms of simulated time (but at least 1 ms of system time)
+  rrlib::time::tDuration cycle_time = std::chrono::milliseconds(200);
+  auto simulated_clock = dynamic_cast<finroc::smart_home::shared::tSimulatedClock *>(&finroc::smart_home::shared::GetCycleClock());
+  if (simulated_clock and simulated_clock->GetTimeScale() > 0.0)
+  {
+    auto scaled_cycle_time = std::chrono::duration_cast<rrlib::time::tDuration>(cycle_time / simulated_clock->GetTimeScale());
+    cycle_time = std::max<rrlib::time::tDuration>(scaled_cycle_time, std::chrono::milliseconds(1));
+  }
+  main_thread->SetCycleTime(cycle_time);
 
   new finroc::smart_home::heat_control::gHeatControl(main_thread);
 
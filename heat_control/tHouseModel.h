@@ -0,0 +1,361 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/heat_control/tHouseModel.h
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tHouseModel.h
+ *
+ * \b tHouseModel.h
+ *
+ * Lumped thermal model of the house and its heating circuits.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __projects__smart_home__heat_control__tHouseModel_h__
+#define __projects__smart_home__heat_control__tHouseModel_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/time/time.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "projects/smart_home/shared/tMCP3008.h"
+#include "projects/smart_home/shared/tPT.h"
+#include "projects/smart_home/shared/tSensorFrame.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace heat_control
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+// number of simulated sensors (shared::tSensor without the external room sensor)
+static constexpr std::size_t cHOUSE_SENSOR_COUNT = shared::eSENSOR_ROOM_EXTERNAL;
+
+// heat capacities [J/K]
+static constexpr double cHOUSE_BOILER_NODE_CAPACITY = 100.0 * 4186.0;   // 300 l boiler, three layers
+static constexpr double cHOUSE_COLLECTOR_CAPACITY = 40000.0;            // 5 m^2 collector with fluid
+static constexpr double cHOUSE_ROOM_CAPACITY = 15E6;                    // air, walls and furniture
+static constexpr double cHOUSE_GROUND_CAPACITY = 40E6;                  // floor slab
+static constexpr double cHOUSE_GARAGE_CAPACITY = 3E6;
+static constexpr double cHOUSE_FURNACE_CAPACITY = 0.5E6;                // furnace with water jacket
+
+// heat transfer coefficients [W/K]
+static constexpr double cHOUSE_SOLAR_LOOP = 200.0;          // collector -> boiler bottom (solar pump)
+static constexpr double cHOUSE_RADIATOR = 300.0;            // boiler top -> room (room pump)
+static constexpr double cHOUSE_SLAB_LOOP = 400.0;           // boiler middle -> floor slab (ground pump)
+static constexpr double cHOUSE_COLLECTOR_LOSS = 20.0;       // collector -> ambient
+static constexpr double cHOUSE_ROOM_LOSS = 100.0;           // room -> ambient
+static constexpr double cHOUSE_GROUND_ROOM = 250.0;         // floor slab <-> room
+static constexpr double cHOUSE_GROUND_EARTH = 60.0;         // floor slab -> earth
+static constexpr double cHOUSE_GARAGE_LOSS = 80.0;          // garage -> ambient
+static constexpr double cHOUSE_GARAGE_ROOM = 30.0;          // garage <-> room
+static constexpr double cHOUSE_FURNACE_ROOM = 50.0;         // furnace <-> room
+static constexpr double cHOUSE_FURNACE_BOILER = 800.0;      // furnace -> boiler top (thermosiphon, only if warmer)
+static constexpr double cHOUSE_BOILER_LOSS = 1.5;           // each boiler layer -> room
+static constexpr double cHOUSE_BOILER_CONDUCTION = 15.0;    // between adjacent boiler layers
+
+// heat sources
+static constexpr double cHOUSE_COLLECTOR_GAIN = 5.0 * 0.75; // collector area [m^2] * optical efficiency
+static constexpr double cHOUSE_INTERNAL_GAINS = 400.0;      // people and appliances [W]
+static constexpr double cHOUSE_EARTH_TEMPERATURE = 10.0;
+static constexpr double cHOUSE_FURNACE_START = 17.0 * 3600.0; // daily firing of the furnace [s of day]
+static constexpr double cHOUSE_FURNACE_STOP = 21.0 * 3600.0;
+
+// longest integration step (explicit Euler, shortest time constant is about 3 minutes)
+static const rrlib::time::tDuration cHOUSE_MAX_STEP = std::chrono::seconds(5);
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! SHORT_DESCRIPTION
+/*!
+ * Lumped thermal model of the house and its heating circuits.
+ *
+ * Nodes are the three layers of the stratified boiler, the solar collector, the room, the
+ * floor slab, the garage and the furnace, indexed by shared::tSensor. The solar pump
+ * moves heat from the collector into the bottom layer, the room pump from the top layer into
+ * the room and the ground pump from the middle layer into the floor slab. The furnace is fired
+ * daily from 17:00 to 21:00 and heats the top layer by thermosiphon. Warmer water below a
+ * colder layer mixes immediately. Ambient temperature follows a daily cosine with its
+ * minimum at 5:00, irradiance a half sine between 6:00 and 20:00 (UTC of the timestamps).
+ */
+class tHouseModel
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  tHouseModel():
+    ambient_mean_(5.0),
+    ambient_amplitude_(5.0),
+    peak_irradiance_(600.0),
+    furnace_power_(8000.0),
+    pump_solar_(false),
+    pump_room_(false),
+    pump_ground_(false),
+    step_count_(0)
+  {
+    Reset();
+  }
+
+  /*!
+   * Sets all temperatures to their initial values (boiler 45/50/55, room and floor slab 20 degree Celsius)
+   */
+  void Reset()
+  {
+    temperature_[shared::eSENSOR_BOILER_BOTTOM] = 45.0;
+    temperature_[shared::eSENSOR_BOILER_MIDDLE] = 50.0;
+    temperature_[shared::eSENSOR_BOILER_TOP] = 55.0;
+    temperature_[shared::eSENSOR_FURNACE] = 20.0;
+    temperature_[shared::eSENSOR_GARAGE] = ambient_mean_;
+    temperature_[shared::eSENSOR_GROUND] = 20.0;
+    temperature_[shared::eSENSOR_ROOM] = 20.0;
+    temperature_[shared::eSENSOR_SOLAR] = ambient_mean_;
+    step_count_ = 0;
+  }
+
+  /*!
+   * Sets the daily weather profile
+   * @param ambient_mean mean ambient temperature [degree Celsius]
+   * @param ambient_amplitude amplitude of the daily ambient temperature [K]
+   * @param peak_irradiance irradiance at noon [W/m^2]
+   */
+  void SetWeather(double ambient_mean, double ambient_amplitude, double peak_irradiance)
+  {
+    ambient_mean_ = ambient_mean;
+    ambient_amplitude_ = ambient_amplitude;
+    peak_irradiance_ = std::max(0.0, peak_irradiance);
+  }
+
+  /*!
+   * Sets the heating power of the furnace during its daily firing
+   * @param power power [W] (zero disables the furnace)
+   */
+  void SetFurnacePower(double power)
+  {
+    furnace_power_ = std::max(0.0, power);
+  }
+
+  void SetPumps(bool solar, bool room, bool ground)
+  {
+    pump_solar_ = solar;
+    pump_room_ = room;
+    pump_ground_ = ground;
+  }
+
+  /*!
+   * Integrates the model
+   * @param start time at the beginning of the interval
+   * @param duration length of the interval (split into steps of at most cHOUSE_MAX_STEP)
+   */
+  void Advance(const rrlib::time::tTimestamp & start, const rrlib::time::tDuration & duration)
+  {
+    double time = GetSecondsOfDay(start);
+    double remaining = std::chrono::duration_cast<std::chrono::duration<double>>(duration).count();
+    const double max_step = std::chrono::duration_cast<std::chrono::duration<double>>(cHOUSE_MAX_STEP).count();
+    while (remaining > 0.0)
+    {
+      double step = std::min(remaining, max_step);
+      Step(time, step);
+      time += step;
+      remaining -= step;
+    }
+  }
+
+  inline double GetTemperature(shared::tSensor sensor) const
+  {
+    return temperature_[sensor];
+  }
+
+  inline void SetTemperature(shared::tSensor sensor, double temperature)
+  {
+    temperature_[sensor] = temperature;
+  }
+
+  /*!
+   * Ambient temperature of the weather profile
+   * @param seconds_of_day time of day [s]
+   * @return temperature [degree Celsius]
+   */
+  inline double GetAmbientTemperature(double seconds_of_day) const
+  {
+    return ambient_mean_ - ambient_amplitude_ * std::cos(2.0 * M_PI * (seconds_of_day - 5.0 * 3600.0) / 86400.0);
+  }
+
+  /*!
+   * Irradiance of the weather profile
+   * @param seconds_of_day time of day [s]
+   * @return irradiance [W/m^2]
+   */
+  inline double GetIrradiance(double seconds_of_day) const
+  {
+    double daylight = (seconds_of_day - 6.0 * 3600.0) / (14.0 * 3600.0);
+    return (daylight > 0.0 and daylight < 1.0) ? peak_irradiance_ * std::sin(M_PI * daylight) : 0.0;
+  }
+
+  static inline double GetSecondsOfDay(const rrlib::time::tTimestamp & timestamp)
+  {
+    auto seconds = std::chrono::duration_cast<std::chrono::milliseconds>(timestamp.time_since_epoch()).count() % (86400 * 1000);
+    return static_cast<double>(seconds < 0 ? seconds + 86400 * 1000 : seconds) / 1000.0;
+  }
+
+  /*!
+   * Number of integration steps since construction or Reset
+   */
+  inline uint64_t GetStepCount() const
+  {
+    return step_count_;
+  }
+
+  /*!
+   * Output code of the MCP3008 for a PT sensor in the voltage divider of the heating
+   * (inverse of tPTLookupTable)
+   * @param temperature temperature [degree Celsius]
+   * @param nominal_resistance resistance of the PT sensor at 0 degree Celsius (e.g. 1000 for PT1000)
+   * @param pre_resistance pre resistance of the voltage divider
+   * @return A/D code
+   */
+  static inline unsigned short GetADValue(double temperature, double nominal_resistance, double pre_resistance)
+  {
+    static const shared::tPT<1000> pt;
+    double resistance = pt.GetResistance(rrlib::si_units::tCelsius<double>(temperature)).Value() * nominal_resistance / 1000.0;
+    double code = std::round(static_cast<double>(shared::cMCP3008_RESOLUTION - 1) * resistance / (pre_resistance + resistance));
+    return static_cast<unsigned short>(std::max(0.0, std::min<double>(shared::cMCP3008_RESOLUTION - 1, code)));
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  std::array<double, cHOUSE_SENSOR_COUNT> temperature_;
+
+  double ambient_mean_;
+  double ambient_amplitude_;
+  double peak_irradiance_;
+  double furnace_power_;
+
+  bool pump_solar_;
+  bool pump_room_;
+  bool pump_ground_;
+
+  uint64_t step_count_;
+
+  /*!
+   * One explicit Euler step
+   * @param seconds_of_day time of day at the beginning of the step [s]
+   * @param step step size [s]
+   */
+  void Step(double seconds_of_day, double step)
+  {
+    auto & t = temperature_;
+    seconds_of_day = std::fmod(seconds_of_day, 86400.0);
+    const double ambient = GetAmbientTemperature(seconds_of_day);
+    const double irradiance = GetIrradiance(seconds_of_day);
+    const double firing = (seconds_of_day >= cHOUSE_FURNACE_START and seconds_of_day < cHOUSE_FURNACE_STOP) ? furnace_power_ : 0.0;
+    const double room = t[shared::eSENSOR_ROOM];
+
+    // heat flows [W]
+    double solar = pump_solar_ ? cHOUSE_SOLAR_LOOP * (t[shared::eSENSOR_SOLAR] - t[shared::eSENSOR_BOILER_BOTTOM]) : 0.0;
+    double radiator = pump_room_ ? cHOUSE_RADIATOR * (t[shared::eSENSOR_BOILER_TOP] - room) : 0.0;
+    double slab = pump_ground_ ? cHOUSE_SLAB_LOOP * (t[shared::eSENSOR_BOILER_MIDDLE] - t[shared::eSENSOR_GROUND]) : 0.0;
+    double lower_conduction = cHOUSE_BOILER_CONDUCTION * (t[shared::eSENSOR_BOILER_MIDDLE] - t[shared::eSENSOR_BOILER_BOTTOM]);
+    double upper_conduction = cHOUSE_BOILER_CONDUCTION * (t[shared::eSENSOR_BOILER_TOP] - t[shared::eSENSOR_BOILER_MIDDLE]);
+    double ground_room = cHOUSE_GROUND_ROOM * (t[shared::eSENSOR_GROUND] - room);
+    double garage_room = cHOUSE_GARAGE_ROOM * (t[shared::eSENSOR_GARAGE] - room);
+    double furnace_room = cHOUSE_FURNACE_ROOM * (t[shared::eSENSOR_FURNACE] - room);
+    double furnace_boiler = cHOUSE_FURNACE_BOILER * std::max(0.0, t[shared::eSENSOR_FURNACE] - t[shared::eSENSOR_BOILER_TOP]);
+    double boiler_loss = cHOUSE_BOILER_LOSS * (t[shared::eSENSOR_BOILER_BOTTOM] + t[shared::eSENSOR_BOILER_MIDDLE] + t[shared::eSENSOR_BOILER_TOP] - 3.0 * room);
+
+    std::array<double, cHOUSE_SENSOR_COUNT> flow;
+    flow[shared::eSENSOR_BOILER_BOTTOM] = solar + lower_conduction - cHOUSE_BOILER_LOSS * (t[shared::eSENSOR_BOILER_BOTTOM] - room);
+    flow[shared::eSENSOR_BOILER_MIDDLE] = upper_conduction - lower_conduction - slab - cHOUSE_BOILER_LOSS * (t[shared::eSENSOR_BOILER_MIDDLE] - room);
+    flow[shared::eSENSOR_BOILER_TOP] = furnace_boiler - upper_conduction - radiator - cHOUSE_BOILER_LOSS * (t[shared::eSENSOR_BOILER_TOP] - room);
+    flow[shared::eSENSOR_SOLAR] = cHOUSE_COLLECTOR_GAIN * irradiance - cHOUSE_COLLECTOR_LOSS * (t[shared::eSENSOR_SOLAR] - ambient) - solar;
+    flow[shared::eSENSOR_ROOM] = radiator + ground_room + garage_room + furnace_room + boiler_loss + cHOUSE_INTERNAL_GAINS - cHOUSE_ROOM_LOSS * (room - ambient);
+    flow[shared::eSENSOR_GROUND] = slab - ground_room - cHOUSE_GROUND_EARTH * (t[shared::eSENSOR_GROUND] - cHOUSE_EARTH_TEMPERATURE);
+    flow[shared::eSENSOR_GARAGE] = -garage_room - cHOUSE_GARAGE_LOSS * (t[shared::eSENSOR_GARAGE] - ambient);
+    flow[shared::eSENSOR_FURNACE] = firing - furnace_room - furnace_boiler;
+
+    t[shared::eSENSOR_BOILER_BOTTOM] += step * flow[shared::eSENSOR_BOILER_BOTTOM] / cHOUSE_BOILER_NODE_CAPACITY;
+    t[shared::eSENSOR_BOILER_MIDDLE] += step * flow[shared::eSENSOR_BOILER_MIDDLE] / cHOUSE_BOILER_NODE_CAPACITY;
+    t[shared::eSENSOR_BOILER_TOP] += step * flow[shared::eSENSOR_BOILER_TOP] / cHOUSE_BOILER_NODE_CAPACITY;
+    t[shared::eSENSOR_SOLAR] += step * flow[shared::eSENSOR_SOLAR] / cHOUSE_COLLECTOR_CAPACITY;
+    t[shared::eSENSOR_ROOM] += step * flow[shared::eSENSOR_ROOM] / cHOUSE_ROOM_CAPACITY;
+    t[shared::eSENSOR_GROUND] += step * flow[shared::eSENSOR_GROUND] / cHOUSE_GROUND_CAPACITY;
+    t[shared::eSENSOR_GARAGE] += step * flow[shared::eSENSOR_GARAGE] / cHOUSE_GARAGE_CAPACITY;
+    t[shared::eSENSOR_FURNACE] += step * flow[shared::eSENSOR_FURNACE] / cHOUSE_FURNACE_CAPACITY;
+
+    // stratification: warmer water rises (equal layer volumes, i.e. mixing to the mean)
+    Mix(shared::eSENSOR_BOILER_BOTTOM, shared::eSENSOR_BOILER_MIDDLE);
+    Mix(shared::eSENSOR_BOILER_MIDDLE, shared::eSENSOR_BOILER_TOP);
+    Mix(shared::eSENSOR_BOILER_BOTTOM, shared::eSENSOR_BOILER_MIDDLE);
+
+    step_count_++;
+  }
+
+  inline void Mix(shared::tSensor lower, shared::tSensor upper)
+  {
+    if (temperature_[lower] > temperature_[upper])
+    {
+      double mean = 0.5 * (temperature_[lower] + temperature_[upper]);
+      temperature_[lower] = mean;
+      temperature_[upper] = mean;
+    }
+  }
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -0,0 +1,194 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/heat_control/tSensorSupervision.h
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tSensorSupervision
+ *
+ * \b tSensorSupervision
+ *
+ * Outdated and implausible temperature sensors of one control cycle.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __projects__smart_home__heat_control__tSensorSupervision_h__
+#define __projects__smart_home__heat_control__tSensorSupervision_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/time/time.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace heat_control
+{
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! SHORT_DESCRIPTION
+/*!
+ * Outdated and implausible temperature sensors of one control cycle.
+ *
+ * Bit i of a mask belongs to sensor i. A sensor is outdated if it has not delivered a new
+ * reading for longer than the allowed update duration of the controller's cycle clock. The
+ * reading timestamps are only compared with each other: sensor drivers and other processes
+ * stamp them with system time, which differs from the cycle clock on simulated time.
+ * Plausibility is only checked on cycles with new readings.
+ * Sensor modules publish unchanged values only every few seconds, so the result of the last
+ * check is kept on the cycles in between: a sensor stays implausible until a new reading
+ * is within its bounds.
+ */
+class tSensorSupervision
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  tSensorSupervision() :
+    check_plausibility_(false),
+    outdated_(0),
+    implausible_(0),
+    pump_errors_(0)
+  {
+    reading_time_.fill(rrlib::time::cNO_TIME);
+    receive_time_.fill(rrlib::time::cNO_TIME);
+  }
+
+  /*!
+   * Starts the supervision of a control cycle
+   * @param new_readings sensor inputs changed in this cycle
+   */
+  inline void StartCycle(bool new_readings)
+  {
+    check_plausibility_ = new_readings;
+    outdated_ = 0;
+    implausible_ = new_readings ? 0 : implausible_;
+    pump_errors_ = 0;
+  }
+
+  /*!
+   * Checks one sensor
+   * @param sensor index of the sensor
+   * @param temperature current reading
+   * @param timestamp time of the reading (cNO_TIME, if there is none yet)
+   * @param current_time time of the cycle
+   * @param max_update_duration time without a new reading after which the sensor is outdated
+   * @param lower_bound lowest plausible temperature
+   * @param upper_bound highest plausible temperature
+   * @param pumps bit mask of the pumps depending on the sensor
+   */
+  inline void Check(std::size_t sensor, double temperature, const rrlib::time::tTimestamp &timestamp, const rrlib::time::tTimestamp &current_time,
+                    const rrlib::time::tDuration &max_update_duration, double lower_bound, double upper_bound, uint8_t pumps)
+  {
+    uint16_t bit = 1 << sensor;
+    if (timestamp != reading_time_[sensor])
+    {
+      reading_time_[sensor] = timestamp;
+      receive_time_[sensor] = (timestamp == rrlib::time::cNO_TIME) ? rrlib::time::cNO_TIME : current_time;
+    }
+    bool outdated = receive_time_[sensor] == rrlib::time::cNO_TIME or current_time - receive_time_[sensor] > max_update_duration;
+    outdated_ |= outdated ? bit : 0;
+    if (check_plausibility_)
+    {
+      implausible_ |= (temperature >= lower_bound and temperature <= upper_bound) ? 0 : bit;
+    }
+    pump_errors_ |= ((outdated_ | implausible_) & bit) ? pumps : 0;
+  }
+
+  inline uint16_t GetOutdatedMask() const
+  {
+    return outdated_;
+  }
+
+  inline uint16_t GetImplausibleMask() const
+  {
+    return implausible_;
+  }
+
+  /*!
+   * Pumps depending on an outdated or implausible sensor
+   */
+  inline uint8_t GetPumpErrorMask() const
+  {
+    return pump_errors_;
+  }
+
+  /*!
+   * Is one of the sensors in a mask outdated or implausible (on every cycle, also without new readings)
+   */
+  inline bool IsOutdated(uint16_t sensors) const
+  {
+    return (outdated_ & sensors) != 0;
+  }
+
+  inline bool IsImplausible(uint16_t sensors) const
+  {
+    return (implausible_ & sensors) != 0;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  bool check_plausibility_;
+  uint16_t outdated_;
+  uint16_t implausible_;
+  uint8_t pump_errors_;
+
+  // one bit per sensor in the masks
+  static constexpr std::size_t cMAX_SENSORS = 16;
+
+  // timestamp of the last reading of each sensor and cycle time when it was received
+  std::array<rrlib::time::tTimestamp, cMAX_SENSORS> reading_time_;
+  std::array<rrlib::time::tTimestamp, cMAX_SENSORS> receive_time_;
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
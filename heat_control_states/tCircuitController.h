@@ -0,0 +1,226 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/heat_control_states/tCircuitController.h
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tCircuitController.h
+ *
+ * \b tCircuitController.h
+ *
+ * Hysteresis controller of a single heating circuit and the priority layer combining several of them.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __projects__smart_home__heat_control_states__tCircuitController_h__
+#define __projects__smart_home__heat_control_states__tCircuitController_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstdint>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace heat_control_states
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//! Bit mask of running circuits
+typedef uint8_t tCircuitSet;
+
+/*!
+ * Checks a conjunction of conditions
+ * @param conditions bit mask of conditions which hold
+ * @param mask conditions which have to hold
+ * @return true, if all conditions of mask hold
+ */
+inline bool HoldsAll(uint16_t conditions, uint16_t mask)
+{
+  return (conditions & mask) == mask;
+}
+
+/*!
+ * Checks which of some circuits are running, independent of all other circuits
+ * @param running running circuits
+ * @param involved circuits the check depends on
+ * @param expected circuits of involved which have to run (the others of involved have to be off)
+ * @return true, if exactly the expected circuits of involved are running
+ */
+inline bool RunsExactly(tCircuitSet running, tCircuitSet involved, tCircuitSet expected)
+{
+  return (running & involved) == expected;
+}
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! SHORT_DESCRIPTION
+/*!
+ * Hysteresis controller of a single heating circuit (i.e. one pump).
+ *
+ * TRule provides
+ *  - cCIRCUIT: bit of the circuit within tCircuitSet
+ *  - Start(conditions, running): start guard, evaluated while the circuit is off
+ *  - Stop(conditions, running): stop guard, evaluated while the circuit is on
+ *  - OnStart(running): circuits running after the start (usually running | cCIRCUIT)
+ *
+ * The guards get the set of running circuits, so interlocks with other circuits are part of the rule.
+ */
+template<typename TRule>
+class tCircuitController
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  static constexpr tCircuitSet cCIRCUIT = TRule::cCIRCUIT;
+
+  /*!
+   * Checks whether the circuit stops
+   * @param conditions bit mask of conditions which hold
+   * @param running running circuits
+   * @param next running circuits after the stop
+   * @return true, if the circuit is running and stops
+   */
+  static inline bool Stop(uint16_t conditions, tCircuitSet running, tCircuitSet & next)
+  {
+    if ((running & cCIRCUIT) and TRule::Stop(conditions, running))
+    {
+      next = running & ~cCIRCUIT;
+      return true;
+    }
+    return false;
+  }
+
+  /*!
+   * Checks whether the circuit starts
+   * @param conditions bit mask of conditions which hold
+   * @param running running circuits
+   * @param next running circuits after the start
+   * @return true, if the circuit is off and starts
+   */
+  static inline bool Start(uint16_t conditions, tCircuitSet running, tCircuitSet & next)
+  {
+    if (not(running & cCIRCUIT) and TRule::Start(conditions, running))
+    {
+      next = TRule::OnStart(running);
+      return true;
+    }
+    return false;
+  }
+
+};
+
+//! SHORT_DESCRIPTION
+/*!
+ * Priority layer combining several circuit controllers.
+ *
+ * Circuits are listed by priority (highest first). At most one circuit switches per step:
+ * stops are checked first, from the lowest priority circuit upwards, then starts from the
+ * highest priority circuit downwards. The cost of a step is linear in the number of circuits.
+ */
+template<typename ... TControllers>
+class tCircuitPriority;
+
+template<>
+class tCircuitPriority<>
+{
+public:
+
+  static constexpr tCircuitSet cCIRCUITS = 0;
+
+  static inline bool Stop(uint16_t, tCircuitSet, tCircuitSet &)
+  {
+    return false;
+  }
+
+  static inline bool Start(uint16_t, tCircuitSet, tCircuitSet &)
+  {
+    return false;
+  }
+
+};
+
+template<typename TController, typename ... TLowerPriority>
+class tCircuitPriority<TController, TLowerPriority...>
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  static constexpr tCircuitSet cCIRCUITS = TController::cCIRCUIT | tCircuitPriority<TLowerPriority...>::cCIRCUITS;
+
+  /*!
+   * Computes the running circuits after one step
+   * @param conditions bit mask of conditions which hold
+   * @param running running circuits
+   * @return running circuits after the step
+   */
+  static inline tCircuitSet GetNext(uint16_t conditions, tCircuitSet running)
+  {
+    tCircuitSet next = running;
+    if (not Stop(conditions, running, next))
+    {
+      Start(conditions, running, next);
+    }
+    return next;
+  }
+
+  static inline bool Stop(uint16_t conditions, tCircuitSet running, tCircuitSet & next)
+  {
+    return tCircuitPriority<TLowerPriority...>::Stop(conditions, running, next) or TController::Stop(conditions, running, next);
+  }
+
+  static inline bool Start(uint16_t conditions, tCircuitSet running, tCircuitSet & next)
+  {
+    return TController::Start(conditions, running, next) or tCircuitPriority<TLowerPriority...>::Start(conditions, running, next);
+  }
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+#endif
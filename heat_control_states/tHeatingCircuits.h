@@ -0,0 +1,285 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/heat_control_states/tHeatingCircuits.h
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tHeatingCircuits.h
+ *
+ * \b tHeatingCircuits.h
+ *
+ * Heat control composed of the solar, room and ground circuits.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __projects__smart_home__heat_control_states__tHeatingCircuits_h__
+#define __projects__smart_home__heat_control_states__tHeatingCircuits_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <array>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "projects/smart_home/heat_control_states/tCircuitController.h"
+#include "projects/smart_home/heat_control_states/tStateMachine.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace heat_control_states
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+enum tCircuit : tCircuitSet
+{
+  eCIRCUIT_GROUND = 1 << 0,
+  eCIRCUIT_ROOM = 1 << 1,
+  eCIRCUIT_SOLAR = 1 << 2
+};
+
+//! Solar circuit: runs while the solar panel is warmer than the boiler
+struct tSolarRule
+{
+  static constexpr tCircuitSet cCIRCUIT = eCIRCUIT_SOLAR;
+
+  static inline bool Start(uint16_t conditions, tCircuitSet running)
+  {
+    // interlock (as in tGround): with ground but not room running, the lower threshold applies unless the room starts
+    if (RunsExactly(running, eCIRCUIT_GROUND | eCIRCUIT_ROOM, eCIRCUIT_GROUND))
+    {
+      return (conditions & eSOLAR_ABOVE_BOILER_LOW) and not HoldsAll(conditions, cHEAT_ROOM.mask);
+    }
+    return HoldsAll(conditions, cSTART_SOLAR.mask);
+  }
+
+  static inline bool Stop(uint16_t conditions, tCircuitSet /*running*/)
+  {
+    return HoldsAll(conditions, cSTOP_SOLAR.mask);
+  }
+
+  static inline tCircuitSet OnStart(tCircuitSet running)
+  {
+    // interlock (as in tGround): the room takes over from the ground when solar starts
+    if (RunsExactly(running, eCIRCUIT_GROUND | eCIRCUIT_ROOM, eCIRCUIT_GROUND))
+    {
+      return tCircuitSet((running & ~eCIRCUIT_GROUND) | eCIRCUIT_SOLAR | eCIRCUIT_ROOM);
+    }
+    return tCircuitSet(running | eCIRCUIT_SOLAR);
+  }
+};
+
+//! Room circuit: runs while the room is below its set point and the boiler can deliver heat
+struct tRoomRule
+{
+  static constexpr tCircuitSet cCIRCUIT = eCIRCUIT_ROOM;
+
+  static inline bool Start(uint16_t conditions, tCircuitSet running)
+  {
+    // interlock (as in tGroundSolar): with solar and ground running, the boiler condition is inverted
+    if (RunsExactly(running, eCIRCUIT_SOLAR | eCIRCUIT_GROUND, eCIRCUIT_SOLAR | eCIRCUIT_GROUND))
+    {
+      return HoldsAll(conditions, eROOM_BELOW_SET_POINT_HIGH | eBOILER_BELOW_ROOM_MAX | eBOILER_BELOW_ROOM_HIGH);
+    }
+    return HoldsAll(conditions, cHEAT_ROOM.mask);
+  }
+
+  static inline bool Stop(uint16_t conditions, tCircuitSet /*running*/)
+  {
+    return conditions & cSTOP_ROOM.mask;
+  }
+
+  static inline tCircuitSet OnStart(tCircuitSet running)
+  {
+    return running | eCIRCUIT_ROOM;
+  }
+};
+
+//! Ground circuit: runs while the boiler is hot enough to heat the ground
+struct tGroundRule
+{
+  static constexpr tCircuitSet cCIRCUIT = eCIRCUIT_GROUND;
+
+  static inline bool Start(uint16_t conditions, tCircuitSet /*running*/)
+  {
+    return HoldsAll(conditions, cHEAT_GROUND.mask);
+  }
+
+  static inline bool Stop(uint16_t conditions, tCircuitSet /*running*/)
+  {
+    return conditions & cSTOP_GROUND.mask;
+  }
+
+  static inline tCircuitSet OnStart(tCircuitSet running)
+  {
+    return running | eCIRCUIT_GROUND;
+  }
+};
+
+//! Circuits by priority (solar first)
+typedef tCircuitPriority<tCircuitController<tSolarRule>, tCircuitController<tRoomRule>, tCircuitController<tGroundRule>> tHeatingCircuitPriority;
+
+//! Running circuits of each state (indexed by tCurrentState)
+static constexpr std::array<tCircuitSet, cSTATE_COUNT> cSTATE_CIRCUITS {{
+    0,                                                 // eREADY
+    eCIRCUIT_SOLAR,                                    // eSOLAR
+    eCIRCUIT_ROOM,                                     // eROOM
+    eCIRCUIT_GROUND,                                   // eGROUND
+    eCIRCUIT_SOLAR | eCIRCUIT_ROOM,                    // eSOLAR_ROOM
+    eCIRCUIT_SOLAR | eCIRCUIT_GROUND,                  // eSOLAR_GROUND
+    eCIRCUIT_ROOM | eCIRCUIT_GROUND,                   // eROOM_GROUND
+    eCIRCUIT_SOLAR | eCIRCUIT_ROOM | eCIRCUIT_GROUND   // eSOLAR_ROOM_GROUND
+  }
+};
+
+//! State of each set of running circuits (indexed by tCircuitSet)
+static constexpr std::array<tCurrentState, cSTATE_COUNT> cCIRCUIT_STATES {{
+    tCurrentState::eREADY,              // none
+    tCurrentState::eGROUND,             // ground
+    tCurrentState::eROOM,               // room
+    tCurrentState::eROOM_GROUND,        // room, ground
+    tCurrentState::eSOLAR,              // solar
+    tCurrentState::eSOLAR_GROUND,       // solar, ground
+    tCurrentState::eSOLAR_ROOM,         // solar, room
+    tCurrentState::eSOLAR_ROOM_GROUND   // solar, room, ground
+  }
+};
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! SHORT_DESCRIPTION
+/*!
+ * Heat control composed of the solar, room and ground circuits.
+ *
+ * Produces the same states as tStateMachine. A further circuit needs one rule, one entry in
+ * tHeatingCircuitPriority and one pump bit instead of doubling the number of states. Interlocks
+ * only test the bits of the circuits they involve, so further circuits do not change them.
+ */
+class tHeatingCircuits
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  tHeatingCircuits():
+    running_(0),
+    state_has_changed_(false)
+  {}
+
+  /*!
+   * Computes the running circuits of the next step
+   * @param temperatures sensed temperatures
+   * @return true, if a circuit has been switched
+   */
+  inline bool ComputeControlState(const shared::tTemperatures & temperatures)
+  {
+    tCircuitSet next = tHeatingCircuitPriority::GetNext(tStateMachine::EvaluateConditions(temperatures), running_);
+    state_has_changed_ = (next != running_);
+    running_ = next;
+    return state_has_changed_;
+  }
+
+  /*!
+   * Switches all circuits off
+   */
+  inline void Reset()
+  {
+    running_ = 0;
+    state_has_changed_ = false;
+  }
+
+  /*!
+   * Has a circuit been switched in the last step
+   * @return state changed
+   */
+  inline bool HasChanged() const
+  {
+    return state_has_changed_;
+  }
+
+  /*!
+   * Getter for running circuits
+   * @return bit mask of tCircuit values
+   */
+  inline tCircuitSet GetRunningCircuits() const
+  {
+    return running_;
+  }
+
+  /*!
+   * Returns the current state
+   * @return current state
+   */
+  inline tCurrentState GetCurrentState() const
+  {
+    return cCIRCUIT_STATES[running_];
+  }
+
+  /*!
+   * Determines the pump settings of the running circuits
+   * @return desired pump settings
+   */
+  inline shared::tPumps GetPumpSettings() const
+  {
+    return shared::tPumps(running_ & eCIRCUIT_GROUND, running_ & eCIRCUIT_ROOM, running_ & eCIRCUIT_SOLAR);
+  }
+
+  /*!
+   * Sets the running circuits
+   * @param state state to continue from
+   */
+  inline void SetCurrentState(tCurrentState state)
+  {
+    running_ = cSTATE_CIRCUITS[static_cast<std::size_t>(state)];
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  tCircuitSet running_;
+  bool state_has_changed_;
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+#endif
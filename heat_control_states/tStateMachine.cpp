@@ -0,0 +1,159 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/heat_control_states/tStateMachine.cpp
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ */
+//----------------------------------------------------------------------
+#include "projects/smart_home/heat_control_states/tStateMachine.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/logging/messages.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace heat_control_states
+{
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+// rows evaluated at once, the conditions of a block stay in the L1 cache
+static constexpr std::size_t cBLOCK_SIZE = 256;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+namespace
+{
+
+/*!
+ * Successors of all states for all condition masks, indexed by (state << cCONDITION_COUNT) | conditions
+ */
+const std::vector<uint8_t> & GetSuccessorTable()
+{
+  static const std::vector<uint8_t> table = []
+  {
+    std::vector<uint8_t> successors(cSTATE_COUNT << cCONDITION_COUNT);
+    for (std::size_t i = 0; i < successors.size(); i++)
+    {
+      auto state = static_cast<tCurrentState>(i >> cCONDITION_COUNT);
+      successors[i] = static_cast<uint8_t>(tStateMachine::GetNextState(state, static_cast<uint16_t>(i & ((1 << cCONDITION_COUNT) - 1))));
+    }
+    return successors;
+  }();
+  return table;
+}
+
+}
+
+bool tStateMachine::ComputeControlState(const shared::tTemperatures & temperatures)
+{
+  tCurrentState next_state = GetNextState(current_state_, EvaluateConditions(temperatures));
+  state_has_changed_ = (next_state != current_state_);
+  if (state_has_changed_)
+  {
+    RRLIB_LOG_PRINT(DEBUG, static_cast<int>(current_state_), " -> ", static_cast<int>(next_state));
+    current_state_ = next_state;
+  }
+  return state_has_changed_;
+}
+
+void tStateMachine::ComputeControlStates(const tTemperatureColumns & temperatures, const tCurrentState *state,
+    const tControlStateColumns & result, std::size_t count, unsigned int thread_count)
+{
+  if (thread_count == 0)
+  {
+    thread_count = std::max(1u, std::thread::hardware_concurrency());
+  }
+  std::size_t rows_per_thread = std::max(cBLOCK_SIZE, (count + thread_count - 1) / thread_count);
+
+  std::vector<std::thread> threads;
+  std::size_t first = 0;
+  for (; first + rows_per_thread < count; first += rows_per_thread)
+  {
+    threads.emplace_back(&tStateMachine::ComputeControlStateRange, std::cref(temperatures), state, std::cref(result), first, first + rows_per_thread);
+  }
+  ComputeControlStateRange(temperatures, state, result, first, count);
+  for (auto & thread : threads)
+  {
+    thread.join();
+  }
+}
+
+void tStateMachine::ComputeControlStateRange(const tTemperatureColumns & temperatures, const tCurrentState *state,
+    const tControlStateColumns & result, std::size_t first, std::size_t last)
+{
+  const uint8_t *successors = GetSuccessorTable().data();
+  std::array<uint16_t, cBLOCK_SIZE> conditions;
+
+  for (std::size_t block = first; block < last; block += cBLOCK_SIZE)
+  {
+    std::size_t size = std::min(cBLOCK_SIZE, last - block);
+
+    // no dependencies between rows, compilers vectorize this loop
+    for (std::size_t i = 0; i < size; i++)
+    {
+      std::size_t row = block + i;
+      conditions[i] = EvaluateConditions(temperatures.boiler[row], temperatures.room[row], temperatures.solar[row],
+                                         temperatures.ground[row], temperatures.room_set_point[row]);
+    }
+
+    for (std::size_t i = 0; i < size; i++)
+    {
+      std::size_t row = block + i;
+      std::size_t current = static_cast<std::size_t>(state[row]);
+      current = (current < cSTATE_COUNT) ? current : static_cast<std::size_t>(tCurrentState::eREADY);
+      auto next_state = successors[(current << cCONDITION_COUNT) | conditions[i]];
+      const tPumpSettings & pumps = cPUMP_SETTINGS[next_state];
+      result.next_state[row] = static_cast<tCurrentState>(next_state);
+      result.ground_pump[row] = pumps.ground;
+      result.room_pump[row] = pumps.room;
+      result.solar_pump[row] = pumps.solar;
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
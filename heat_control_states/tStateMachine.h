@@ -0,0 +1,361 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/heat_control_states/tStateMachine.h
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tStateMachine.h
+ *
+ * \b tStateMachine.h
+ *
+ * Table driven heat control state machine.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __projects__smart_home__heat_control_states__tStateMachine_h__
+#define __projects__smart_home__heat_control_states__tStateMachine_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "projects/smart_home/heat_control_states/tState.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace heat_control_states
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//! Elementary conditions of the transition guards (one bit each)
+enum tCondition : uint16_t
+{
+  eSOLAR_ABOVE_BOILER_HIGH = 1 << 0,    //!< solar - boiler >= cSOLAR_DIFF_BOILER_HIGH
+  eSOLAR_ABOVE_BOILER_LOW = 1 << 1,     //!< solar - boiler >= cSOLAR_DIFF_BOILER_LOW
+  eSOLAR_BELOW_BOILER_LOW = 1 << 2,     //!< solar - boiler < cSOLAR_DIFF_BOILER_LOW
+  eROOM_BELOW_SET_POINT_HIGH = 1 << 3,  //!< set point - room >= cROOM_DIFF_SETPOINT_HIGH
+  eROOM_ABOVE_SET_POINT_LOW = 1 << 4,   //!< set point - room < cROOM_DIFF_SETPOINT_LOW
+  eBOILER_BELOW_ROOM_MAX = 1 << 5,      //!< boiler < cROOM_BOILER_MAX
+  eBOILER_ABOVE_ROOM_MAX = 1 << 6,      //!< boiler >= cROOM_BOILER_MAX
+  eBOILER_ABOVE_ROOM_HIGH = 1 << 7,     //!< boiler - room >= cROOM_DIFF_BOILER_HIGH
+  eBOILER_BELOW_ROOM_HIGH = 1 << 8,     //!< boiler - room < cROOM_DIFF_BOILER_HIGH
+  eBOILER_BELOW_ROOM_LOW = 1 << 9,      //!< boiler - room < cROOM_DIFF_BOILER_LOW
+  eBOILER_ABOVE_GROUND_MIN = 1 << 10,   //!< boiler > cGROUND_BOILER_MIN
+  eBOILER_BELOW_GROUND_MIN = 1 << 11,   //!< boiler < cGROUND_BOILER_MIN
+  eBOILER_ABOVE_GROUND_HIGH = 1 << 12,  //!< boiler - ground >= cGROUND_DIFF_BOILER_HIGH
+  eBOILER_BELOW_GROUND_LOW = 1 << 13    //!< boiler - ground < cGROUND_DIFF_BOILER_LOW
+};
+
+//! Guard of a transition: all or any of the conditions in mask have to hold
+struct tGuard
+{
+  uint16_t mask;
+  bool all;
+};
+
+//! Transition to a target state
+struct tTransition
+{
+  tGuard guard;
+  tCurrentState target;
+};
+
+//! Pump settings of a state
+struct tPumpSettings
+{
+  bool ground;
+  bool room;
+  bool solar;
+};
+
+//! Temperature columns of a batch (struct of arrays, degree Celsius)
+struct tTemperatureColumns
+{
+  const double *boiler;
+  const double *room;
+  const double *solar;
+  const double *ground;
+  const double *room_set_point;
+};
+
+//! Result columns of a batch
+struct tControlStateColumns
+{
+  tCurrentState *next_state;
+  bool *ground_pump;
+  bool *room_pump;
+  bool *solar_pump;
+};
+
+static constexpr std::size_t cSTATE_COUNT = 8;
+static constexpr std::size_t cCONDITION_COUNT = 14;
+static constexpr std::size_t cTRANSITIONS_PER_STATE = 3;
+
+static constexpr tGuard cHEAT_ROOM {eROOM_BELOW_SET_POINT_HIGH | eBOILER_BELOW_ROOM_MAX | eBOILER_ABOVE_ROOM_HIGH, true};
+static constexpr tGuard cSTOP_ROOM {eROOM_ABOVE_SET_POINT_LOW | eBOILER_ABOVE_ROOM_MAX | eBOILER_BELOW_ROOM_LOW, false};
+static constexpr tGuard cHEAT_GROUND {eBOILER_ABOVE_GROUND_MIN | eBOILER_ABOVE_GROUND_HIGH, true};
+static constexpr tGuard cSTOP_GROUND {eBOILER_BELOW_GROUND_MIN | eBOILER_BELOW_GROUND_LOW, false};
+static constexpr tGuard cSTART_SOLAR {eSOLAR_ABOVE_BOILER_HIGH, true};
+static constexpr tGuard cSTOP_SOLAR {eSOLAR_BELOW_BOILER_LOW, true};
+
+/*!
+ * Transitions of each state (indexed by tCurrentState), checked in order.
+ *
+ * Reproduces the state classes (tReady, tSolar, ...) including two deviations from the
+ * symmetric scheme: ground switches to solar room with the low solar threshold, and solar
+ * ground adds the room if the boiler is less than cROOM_DIFF_BOILER_HIGH warmer than the room.
+ */
+static constexpr std::array<std::array<tTransition, cTRANSITIONS_PER_STATE>, cSTATE_COUNT> cTRANSITIONS {{
+    // eREADY
+    {{{cSTART_SOLAR, tCurrentState::eSOLAR}, {cHEAT_ROOM, tCurrentState::eROOM}, {cHEAT_GROUND, tCurrentState::eGROUND}}},
+    // eSOLAR
+    {{{cSTOP_SOLAR, tCurrentState::eREADY}, {cHEAT_ROOM, tCurrentState::eSOLAR_ROOM}, {cHEAT_GROUND, tCurrentState::eSOLAR_GROUND}}},
+    // eROOM
+    {{{cSTOP_ROOM, tCurrentState::eREADY}, {cSTART_SOLAR, tCurrentState::eSOLAR_ROOM}, {cHEAT_GROUND, tCurrentState::eROOM_GROUND}}},
+    // eGROUND
+    {{{cSTOP_GROUND, tCurrentState::eREADY}, {cHEAT_ROOM, tCurrentState::eROOM_GROUND}, {{eSOLAR_ABOVE_BOILER_LOW, true}, tCurrentState::eSOLAR_ROOM}}},
+    // eSOLAR_ROOM
+    {{{cSTOP_ROOM, tCurrentState::eSOLAR}, {cSTOP_SOLAR, tCurrentState::eROOM}, {cHEAT_GROUND, tCurrentState::eSOLAR_ROOM_GROUND}}},
+    // eSOLAR_GROUND
+    {{{cSTOP_GROUND, tCurrentState::eSOLAR}, {cSTOP_SOLAR, tCurrentState::eGROUND}, {{eROOM_BELOW_SET_POINT_HIGH | eBOILER_BELOW_ROOM_MAX | eBOILER_BELOW_ROOM_HIGH, true}, tCurrentState::eSOLAR_ROOM_GROUND}}},
+    // eROOM_GROUND
+    {{{cSTOP_GROUND, tCurrentState::eROOM}, {cSTOP_ROOM, tCurrentState::eGROUND}, {cSTART_SOLAR, tCurrentState::eSOLAR_ROOM_GROUND}}},
+    // eSOLAR_ROOM_GROUND
+    {{{cSTOP_GROUND, tCurrentState::eSOLAR_ROOM}, {cSTOP_ROOM, tCurrentState::eSOLAR_GROUND}, {cSTOP_SOLAR, tCurrentState::eROOM_GROUND}}}
+  }
+};
+
+//! Pump settings of each state (indexed by tCurrentState)
+static constexpr std::array<tPumpSettings, cSTATE_COUNT> cPUMP_SETTINGS {{
+    {false, false, false},  // eREADY
+    {false, false, true},   // eSOLAR
+    {false, true, false},   // eROOM
+    {true, false, false},   // eGROUND
+    {false, true, true},    // eSOLAR_ROOM
+    {true, false, true},    // eSOLAR_GROUND
+    {true, true, false},    // eROOM_GROUND
+    {true, true, true}      // eSOLAR_ROOM_GROUND
+  }
+};
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! SHORT_DESCRIPTION
+/*!
+ * Table driven heat control state machine.
+ *
+ * Computes the same states as the tState classes, but looks the transitions up in
+ * cTRANSITIONS. A control step neither allocates nor calls virtual functions.
+ */
+class tStateMachine
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * Constructor
+   * @param initial_state initial state
+   */
+  tStateMachine(tCurrentState initial_state = tCurrentState::eREADY):
+    current_state_(initial_state),
+    state_has_changed_(false)
+  {}
+
+  /*!
+   * Computes the next control state
+   * @param temperatures sensed temperatures
+   * @return true, if the state has changed
+   */
+  bool ComputeControlState(const shared::tTemperatures & temperatures);
+
+  /*!
+   * Returns to the initial state
+   */
+  inline void Reset()
+  {
+    current_state_ = tCurrentState::eREADY;
+    state_has_changed_ = false;
+  }
+
+  /*!
+   * Has the state changed in the last step
+   * @return state changed
+   */
+  inline bool HasChanged() const
+  {
+    return state_has_changed_;
+  }
+
+  /*!
+   * Returns the current state
+   * @return current state
+   */
+  inline tCurrentState GetCurrentState() const
+  {
+    return current_state_;
+  }
+
+  /*!
+   * Determines the pump settings of the current state
+   * @return desired pump settings
+   */
+  inline shared::tPumps GetPumpSettings() const
+  {
+    return GetPumpSettings(current_state_);
+  }
+
+  /*!
+   * Determines the pump settings of a state
+   * @param state state
+   * @return desired pump settings
+   */
+  static inline shared::tPumps GetPumpSettings(tCurrentState state)
+  {
+    const tPumpSettings & settings = cPUMP_SETTINGS[static_cast<std::size_t>(state)];
+    return shared::tPumps(settings.ground, settings.room, settings.solar);
+  }
+
+  /*!
+   * Computes the next control states of many independent rows
+   *
+   * Evaluates the conditions of a block of rows in a branch free loop and looks the successors
+   * up in a table over all (state, conditions) pairs. The rows are split evenly between threads.
+   *
+   * @param temperatures temperature columns
+   * @param state column with current state of each row (rows with an invalid state start from eREADY)
+   * @param result columns to write next state and pump settings of each row to
+   * @param count number of rows
+   * @param thread_count number of threads (0 uses all hardware threads)
+   */
+  static void ComputeControlStates(const tTemperatureColumns & temperatures, const tCurrentState *state,
+                                   const tControlStateColumns & result, std::size_t count, unsigned int thread_count = 1);
+
+  /*!
+   * Evaluates all elementary conditions
+   * @param temperatures sensed temperatures
+   * @return bit mask of tCondition values which hold
+   */
+  static inline uint16_t EvaluateConditions(const shared::tTemperatures & temperatures)
+  {
+    return EvaluateConditions(temperatures.GetBoiler().ValueFactored(), temperatures.GetRoom().ValueFactored(), temperatures.GetSolar().ValueFactored(),
+                              temperatures.GetGround().ValueFactored(), temperatures.GetRoomSetPoint().ValueFactored());
+  }
+
+  /*!
+   * Evaluates all elementary conditions
+   * @param boiler temperature of boiler in degree Celsius
+   * @param room temperature of room in degree Celsius
+   * @param solar temperature of solar panel in degree Celsius
+   * @param ground temperature of ground in degree Celsius
+   * @param room_set_point set point of room in degree Celsius
+   * @return bit mask of tCondition values which hold
+   */
+  static inline uint16_t EvaluateConditions(double boiler, double room, double solar, double ground, double room_set_point)
+  {
+    double solar_boiler = solar - boiler;
+    double set_point_room = room_set_point - room;
+    double boiler_room = boiler - room;
+    double boiler_ground = boiler - ground;
+
+    uint16_t conditions = 0;
+    conditions |= (solar_boiler >= shared::cSOLAR_DIFF_BOILER_HIGH.Value()) ? eSOLAR_ABOVE_BOILER_HIGH : 0;
+    conditions |= (solar_boiler >= shared::cSOLAR_DIFF_BOILER_LOW.Value()) ? eSOLAR_ABOVE_BOILER_LOW : 0;
+    conditions |= (solar_boiler < shared::cSOLAR_DIFF_BOILER_LOW.Value()) ? eSOLAR_BELOW_BOILER_LOW : 0;
+    conditions |= (set_point_room >= shared::cROOM_DIFF_SETPOINT_HIGH.Value()) ? eROOM_BELOW_SET_POINT_HIGH : 0;
+    conditions |= (set_point_room < shared::cROOM_DIFF_SETPOINT_LOW.Value()) ? eROOM_ABOVE_SET_POINT_LOW : 0;
+    conditions |= (boiler < shared::cROOM_BOILER_MAX.ValueFactored()) ? eBOILER_BELOW_ROOM_MAX : 0;
+    conditions |= (boiler >= shared::cROOM_BOILER_MAX.ValueFactored()) ? eBOILER_ABOVE_ROOM_MAX : 0;
+    conditions |= (boiler_room >= shared::cROOM_DIFF_BOILER_HIGH.Value()) ? eBOILER_ABOVE_ROOM_HIGH : 0;
+    conditions |= (boiler_room < shared::cROOM_DIFF_BOILER_HIGH.Value()) ? eBOILER_BELOW_ROOM_HIGH : 0;
+    conditions |= (boiler_room < shared::cROOM_DIFF_BOILER_LOW.Value()) ? eBOILER_BELOW_ROOM_LOW : 0;
+    conditions |= (boiler > shared::cGROUND_BOILER_MIN.ValueFactored()) ? eBOILER_ABOVE_GROUND_MIN : 0;
+    conditions |= (boiler < shared::cGROUND_BOILER_MIN.ValueFactored()) ? eBOILER_BELOW_GROUND_MIN : 0;
+    conditions |= (boiler_ground >= shared::cGROUND_DIFF_BOILER_HIGH.Value()) ? eBOILER_ABOVE_GROUND_HIGH : 0;
+    conditions |= (boiler_ground < shared::cGROUND_DIFF_BOILER_LOW.Value()) ? eBOILER_BELOW_GROUND_LOW : 0;
+    return conditions;
+  }
+
+  /*!
+   * Determines the successor of a state
+   * @param state current state
+   * @param conditions bit mask of tCondition values which hold
+   * @return next state (state if no guard holds)
+   */
+  static inline tCurrentState GetNextState(tCurrentState state, uint16_t conditions)
+  {
+    for (const tTransition & transition : cTRANSITIONS[static_cast<std::size_t>(state)])
+    {
+      uint16_t matching = conditions & transition.guard.mask;
+      if (transition.guard.all ? (matching == transition.guard.mask) : (matching != 0))
+      {
+        return transition.target;
+      }
+    }
+    return state;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  tCurrentState current_state_;
+  bool state_has_changed_;
+
+  /*!
+   * Computes the next control states of consecutive rows in the calling thread
+   * @param first index of first row
+   * @param last index behind last row
+   */
+  static void ComputeControlStateRange(const tTemperatureColumns & temperatures, const tCurrentState *state,
+                                       const tControlStateColumns & result, std::size_t first, std::size_t last);
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+#endif
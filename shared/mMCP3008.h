@@ -41,6 +41,8 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include <algorithm>
+#include <array>
 
 //----------------------------------------------------------------------
 // Internal includes with ""
@@ -67,6 +69,19 @@ namespace shared
 //! SHORT_DESCRIPTION
 /*!
  * MCP 3008 A/D converter, reads raw unsigned voltage and provides SI voltage output.
+ *
+ * Optionally oversamples and decimates: 4^n raw values per channel are summed and shifted
+ * right by n, which results in a voltage with n additional bits published every 4^n samples.
+ * Consumers such as mController rely on a value at least every refresh interval (their update
+ * limit is longer than the default refresh interval). If the refresh interval is due before 4^n
+ * samples are collected, the mean of the samples collected so far is published, so unchanged
+ * channels are published at least every refresh interval plus one sample period. If 4^n samples
+ * take longer than the refresh interval at the actual sample rate, n is lowered until they fit
+ * and a warning is logged (e.g. at most 2 bits at 5 Hz with a refresh interval of 5 s), so that
+ * changes are still detected within the refresh interval.
+ *
+ * A channel is only published if its value differs from the last published value by more
+ * than the deadband, or if the refresh interval has passed since its last publish.
  */
 template<size_t Tchannels>
 class mMCP3008 : public structure::tModule
@@ -82,6 +97,12 @@ public:
   std::vector<tOutput<rrlib::si_units::tVoltage<double>>> out_voltage;
 
   tParameter<rrlib::si_units::tVoltage<double>> par_reference_voltage;
+  // additional bits gained by oversampling (0 disables oversampling, lowered if 4^n samples take longer than the refresh interval)
+  tParameter<unsigned int> par_oversampling_bits;
+  // changes up to this number of (10 bit) codes are not published
+  tParameter<unsigned int> par_deadband;
+  // unchanged channels are published again after this duration (keep it below the update limit of the consumers)
+  tParameter<rrlib::time::tDuration> par_refresh_interval;
 
 //----------------------------------------------------------------------
 // Public methods and typedefs
@@ -91,8 +112,20 @@ public:
   mMCP3008(core::tFrameworkElement *parent, const std::string &name = "MCP3008"):
     tModule(parent, name),
     par_reference_voltage(5.0),
-    mcp3008_(5.0)
+    par_oversampling_bits(0),
+    par_deadband(0),
+    par_refresh_interval(std::chrono::seconds(5)),
+    mcp3008_(5.0),
+    oversampling_bits_(0),
+    deadband_(0),
+    refresh_interval_(std::chrono::seconds(5))
   {
+    sample_sum_.fill(0);
+    sample_count_.fill(0);
+    sample_start_time_.fill(rrlib::time::cNO_TIME);
+    last_value_.fill(0);
+    last_publish_time_.fill(rrlib::time::cNO_TIME);
+
     for (std::size_t i = 0; i < Tchannels; i++)
     {
       in_voltage_raw.emplace_back(tInput<unsigned short>("Voltage Raw " + std::to_string(i), this));
@@ -120,21 +153,160 @@ private:
   inline virtual void OnParameterChange() override
   {
     mcp3008_.SetReferenceVoltage(par_reference_voltage.Get());
+
+    if (par_oversampling_bits.HasChanged())
+    {
+      SetOversamplingBits(std::min(par_oversampling_bits.Get(), cMCP3008_MAX_OVERSAMPLING_BITS));
+      if (oversampling_bits_ != par_oversampling_bits.Get())
+      {
+        RRLIB_LOG_PRINT(WARNING, "Oversampling limited to ", cMCP3008_MAX_OVERSAMPLING_BITS, " additional bits.");
+      }
+    }
+    deadband_ = par_deadband.Get() << oversampling_bits_;
+    refresh_interval_ = par_refresh_interval.Get();
+
+    // publish all channels with the new configuration
+    last_publish_time_.fill(rrlib::time::cNO_TIME);
   }
 
   inline virtual void Update() override
   {
     if (this->InputChanged())
     {
+      const uint32_t samples_per_value = 1u << (2 * oversampling_bits_);
+      unsigned int limited_bits = oversampling_bits_;
       for (std::size_t i = 0; i < Tchannels; i++)
       {
-        out_voltage.at(i).Publish(mcp3008_.ConvertADValueToVoltage(in_voltage_raw.at(i).Get()), in_voltage_raw.at(i).GetTimestamp());
+        if (not in_voltage_raw[i].HasChanged())
+        {
+          continue;
+        }
+
+        uint32_t value = in_voltage_raw[i].Get();
+        auto timestamp = in_voltage_raw[i].GetTimestamp();
+        if (oversampling_bits_ > 0)
+        {
+          if (sample_count_[i] == 0)
+          {
+            sample_start_time_[i] = timestamp;
+          }
+          sample_sum_[i] += std::min<uint32_t>(value, cMCP3008_RESOLUTION - 1);
+          sample_count_[i]++;
+          limited_bits = std::min(limited_bits, GetFittingOversamplingBits(timestamp - sample_start_time_[i], sample_count_[i]));
+          if (sample_count_[i] == samples_per_value)
+          {
+            value = sample_sum_[i] >> oversampling_bits_;
+          }
+          else if (IsRefreshDue(i, timestamp))
+          {
+            // mean of the samples collected so far, on the scale of a complete value
+            value = static_cast<uint32_t>((static_cast<uint64_t>(sample_sum_[i]) << oversampling_bits_) / sample_count_[i]);
+          }
+          else
+          {
+            continue;
+          }
+          sample_sum_[i] = 0;
+          sample_count_[i] = 0;
+        }
+
+        if (not IsPublishRequired(i, value, timestamp))
+        {
+          continue;
+        }
+
+        auto voltage = (oversampling_bits_ > 0) ? mcp3008_.ConvertDecimatedValueToVoltage(value, oversampling_bits_) : mcp3008_.ConvertADValueToVoltage(value);
+        out_voltage[i].Publish(voltage, timestamp);
+        last_value_[i] = value;
+        last_publish_time_[i] = timestamp;
       }
+
+      if (limited_bits != oversampling_bits_)
+      {
+        RRLIB_LOG_PRINT(WARNING, "Oversampling lowered to ", limited_bits, " additional bits, as ", samples_per_value, " samples take longer than the refresh interval.");
+        SetOversamplingBits(limited_bits);
+        deadband_ = par_deadband.Get() << oversampling_bits_;
+      }
+    }
+  }
+
+  /*!
+   * Changes the additional bits, restarts the collection of samples and brings the last
+   * published values to the new scale (so the deadband compares values of the same scale)
+   * @param bits new number of additional bits
+   */
+  inline void SetOversamplingBits(unsigned int bits)
+  {
+    for (std::size_t i = 0; i < Tchannels; i++)
+    {
+      last_value_[i] = (bits > oversampling_bits_) ? last_value_[i] << (bits - oversampling_bits_) : last_value_[i] >> (oversampling_bits_ - bits);
     }
+    oversampling_bits_ = bits;
+    sample_sum_.fill(0);
+    sample_count_.fill(0);
+  }
+
+  /*!
+   * Determines the additional bits whose samples fit into the refresh interval
+   * (checked with every sample, as incomplete values are published when the refresh interval is due)
+   * @param duration time from the first to the last collected sample of a decimated value
+   * @param samples number of collected samples
+   * @return current bits, if they fit (otherwise fewer bits)
+   */
+  inline unsigned int GetFittingOversamplingBits(const rrlib::time::tDuration & duration, uint32_t samples) const
+  {
+    unsigned int bits = oversampling_bits_;
+    if (samples < 2)
+    {
+      return bits;
+    }
+    // n samples span n - 1 sample periods
+    auto sample_period = duration / (samples - 1);
+    while (bits > 0 and sample_period * ((1u << (2 * bits)) - 1) >= refresh_interval_)
+    {
+      bits--;
+    }
+    return bits;
+  }
+
+  /*!
+   * Checks if a new value of a channel has to be published
+   * @param channel index of channel
+   * @param value new (possibly decimated) value
+   * @param timestamp timestamp of new value
+   * @return publish required
+   */
+  inline bool IsPublishRequired(std::size_t channel, uint32_t value, const rrlib::time::tTimestamp & timestamp) const
+  {
+    if (last_publish_time_[channel] == rrlib::time::cNO_TIME)
+    {
+      return true;
+    }
+    uint32_t difference = (value > last_value_[channel]) ? value - last_value_[channel] : last_value_[channel] - value;
+    return (difference > deadband_) or IsRefreshDue(channel, timestamp);
+  }
+
+  /*!
+   * Checks if a channel has to be published again, as the refresh interval has passed (or it was never published)
+   */
+  inline bool IsRefreshDue(std::size_t channel, const rrlib::time::tTimestamp & timestamp) const
+  {
+    return last_publish_time_[channel] == rrlib::time::cNO_TIME or timestamp - last_publish_time_[channel] >= refresh_interval_;
   }
 
   shared::tMCP3008 mcp3008_;
 
+  unsigned int oversampling_bits_;
+  uint32_t deadband_;
+  rrlib::time::tDuration refresh_interval_;
+
+  // state per channel
+  std::array<uint32_t, Tchannels> sample_sum_;
+  std::array<uint32_t, Tchannels> sample_count_;
+  std::array<rrlib::time::tTimestamp, Tchannels> sample_start_time_;
+  std::array<uint32_t, Tchannels> last_value_;
+  std::array<rrlib::time::tTimestamp, Tchannels> last_publish_time_;
+
 };
 
 //----------------------------------------------------------------------
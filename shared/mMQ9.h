@@ -40,10 +40,18 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include "rrlib/util/fileio.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
 
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "projects/smart_home/shared/tAsyncFileWriter.h"
+#include "projects/smart_home/shared/tMQ9.h"
+#include "projects/smart_home/shared/tSlidingWindowMaximum.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -58,6 +66,10 @@ namespace shared
 //----------------------------------------------------------------------
 // Forward declarations / typedefs / enums
 //----------------------------------------------------------------------
+static constexpr unsigned int cMQ9_BASELINE_BUCKETS = 1440;
+static const rrlib::time::tDuration cMQ9_BASELINE_SAVE_INTERVAL = std::chrono::hours(1);
+/*! duration after a restart during which the stored baseline is still taken into account */
+static const rrlib::time::tDuration cMQ9_BASELINE_SEED_DURATION = std::chrono::hours(1);
 
 //----------------------------------------------------------------------
 // Class declaration
@@ -76,24 +88,55 @@ public:
 
   tInput<rrlib::si_units::tVoltage<double>> in_voltage;
 
+  /*! concentrations in ppm */
   tOutput<rrlib::si_units::tAmountOfSubstance<double>> out_carbon_monoxid;
+  tOutput<rrlib::si_units::tAmountOfSubstance<double>> out_methane;
   tOutput<rrlib::si_units::tElectricResistance<double>> out_resistance;
+  tOutput<rrlib::si_units::tElectricResistance<double>> out_clean_air_resistance;
 
   tParameter<rrlib::si_units::tElectricResistance<double>> par_pre_resistance;
   tParameter<rrlib::si_units::tVoltage<double>> par_reference_voltage;
   tParameter<rrlib::si_units::tVoltage<double>> par_supply_voltage;
+  /*! sensor resistance in clean air (R0) used during the first hour if no baseline is stored */
+  tParameter<rrlib::si_units::tElectricResistance<double>> par_clean_air_resistance;
+  /*! window of baseline tracking, should contain some time in clean air */
+  tParameter<rrlib::time::tDuration> par_baseline_window;
 
 //----------------------------------------------------------------------
 // Public methods and typedefs
 //----------------------------------------------------------------------
 public:
 
-  mMQ9(core::tFrameworkElement *parent, const std::string &name = "MQ9") :
+  /*!
+   * Constructor
+   * @param baseline_file name of file that keeps the baseline across restarts (not persisted if empty)
+   */
+  mMQ9(core::tFrameworkElement *parent, const std::string &name = "MQ9", const std::string &baseline_file = "$HOME/.mq9_baseline") :
     tModule(parent, name),
     par_pre_resistance(31.0),
     par_reference_voltage(5.0),
-    par_supply_voltage(5.0)
-  {}
+    par_supply_voltage(5.0),
+    par_clean_air_resistance(31.0),
+    par_baseline_window(std::chrono::hours(24)),
+    baseline_(par_baseline_window.Get(), cMQ9_BASELINE_BUCKETS),
+    clean_air_resistance_(0.0),
+    seed_resistance_(0.0),
+    baseline_start_time_(rrlib::time::cNO_TIME),
+    last_baseline_save_time_(rrlib::time::cNO_TIME)
+  {
+    baseline_filename_ = baseline_file.empty() ? "" : rrlib::util::fileio::ShellExpandFilename(baseline_file);
+    std::ifstream file(baseline_filename_);
+    double resistance = 0.0;
+    if (file >> resistance and resistance > 0.0)
+    {
+      RRLIB_LOG_PRINT(DEBUG, "Loaded clean air resistance ", resistance, " from ", baseline_filename_);
+      clean_air_resistance_ = resistance;
+    }
+    if (not baseline_filename_.empty())
+    {
+      baseline_writer_.Open(baseline_filename_);
+    }
+  }
 
 //----------------------------------------------------------------------
 // Protected methods
@@ -107,36 +150,90 @@ protected:
    */
   ~mMQ9() {}
 
-  /*!
-   * Determines resistance value of PT sensor
-   * @param voltage A/D voltage
-   * @param reference_voltage reference voltage of A/D converter
-   * @param pre_resistance pre resistance of PT sensor
-   * @return resistance
-   */
-  inline rrlib::si_units::tElectricResistance<double> GetResistance(
-    const rrlib::si_units::tVoltage<double> & voltage,
-    const rrlib::si_units::tVoltage<double> & reference_voltage,
-    const rrlib::si_units::tElectricResistance<double> & pre_resistance) const
-  {
-    if (voltage.Value() == 0)
-    {
-      return pre_resistance;
-    }
-
-    return pre_resistance * ((reference_voltage / voltage).Value() - 1.0);
-  }
-
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
 private:
 
+  tMQ9 mq9_;
+
+  /*! sensor resistance maximum, i.e. the cleanest air, within the window */
+  tSlidingWindowMaximum baseline_;
+  double clean_air_resistance_;
+
+  /*! stored (or configured) baseline and start of tracking */
+  double seed_resistance_;
+  rrlib::time::tTimestamp baseline_start_time_;
+
+  std::string baseline_filename_;
+  rrlib::time::tTimestamp last_baseline_save_time_;
+
+  /*! replaces the baseline file outside of the control cycle */
+  tAsyncFileWriter baseline_writer_;
+
+  inline virtual void OnParameterChange() override
+  {
+    if (par_baseline_window.HasChanged())
+    {
+      baseline_ = tSlidingWindowMaximum(par_baseline_window.Get(), cMQ9_BASELINE_BUCKETS);
+      baseline_start_time_ = rrlib::time::cNO_TIME;
+      last_baseline_save_time_ = rrlib::time::cNO_TIME;
+    }
+  }
+
   inline virtual void Update() override
   {
-    auto resistance =  GetResistance(in_voltage.Get(), par_reference_voltage.Get(), par_pre_resistance.Get());
+    if (this->InputChanged())
+    {
+      auto resistance = tMQ9::GetResistance(in_voltage.Get(), par_reference_voltage.Get(), par_pre_resistance.Get());
+      auto timestamp = in_voltage.GetTimestamp();
+      out_resistance.Publish(resistance, timestamp);
+
+      UpdateBaseline(resistance.Value(), timestamp);
+      out_clean_air_resistance.Publish(rrlib::si_units::tElectricResistance<double>(clean_air_resistance_), timestamp);
+
+      double ratio = resistance.Value() / clean_air_resistance_;
+      out_carbon_monoxid.Publish(rrlib::si_units::tAmountOfSubstance<double>(mq9_.GetConcentration(tMQ9Gas::eCARBON_MONOXIDE, ratio)), timestamp);
+      out_methane.Publish(rrlib::si_units::tAmountOfSubstance<double>(mq9_.GetConcentration(tMQ9Gas::eMETHANE, ratio)), timestamp);
+    }
+  }
+
+  /*!
+   * Tracks the clean air resistance R0 and stores it from time to time (by the writer thread of baseline_writer_)
+   * @param resistance current sensor resistance
+   * @param timestamp time of measurement
+   */
+  void UpdateBaseline(double resistance, const rrlib::time::tTimestamp & timestamp)
+  {
+    if (baseline_start_time_ == rrlib::time::cNO_TIME)
+    {
+      double initial_resistance = clean_air_resistance_ > 0.0 ? clean_air_resistance_ : par_clean_air_resistance.Get().Value();
+      seed_resistance_ = initial_resistance * cMQ9_CLEAN_AIR_RATIO;
+      baseline_start_time_ = timestamp;
+      last_baseline_save_time_ = timestamp;
+    }
+
+    // gas lowers the resistance, so the maximum within the window is the cleanest air seen
+    baseline_.Add(resistance, timestamp);
+    double maximum = baseline_.GetMaximum();
 
-    out_resistance.Publish(resistance, in_voltage.GetTimestamp());
+    // the stored baseline only bridges the first hour, a stale one would otherwise dominate the whole window
+    if (timestamp - baseline_start_time_ < cMQ9_BASELINE_SEED_DURATION)
+    {
+      maximum = std::max(maximum, seed_resistance_);
+    }
+    clean_air_resistance_ = maximum / cMQ9_CLEAN_AIR_RATIO;
+
+    if (not baseline_filename_.empty() and timestamp - last_baseline_save_time_ >= cMQ9_BASELINE_SAVE_INTERVAL)
+    {
+      last_baseline_save_time_ = timestamp;
+      std::ostringstream content;
+      content << clean_air_resistance_ << "\n";
+      if (not baseline_writer_.Write(content.str()))
+      {
+        RRLIB_LOG_PRINT(WARNING, "Failed to write baseline: ", baseline_filename_);
+      }
+    }
   }
 };
 
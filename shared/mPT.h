@@ -46,6 +46,7 @@
 // Internal includes with ""
 //----------------------------------------------------------------------
 #include "projects/smart_home/shared/tPT.h"
+#include "projects/smart_home/shared/tPTLookupTable.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -96,7 +97,9 @@ public:
     par_pre_resistance(2000.0),
     par_reference_voltage(5.0),
     par_supply_voltage(5.0)
-  {}
+  {
+    lookup_table_.template Rebuild<TResistance>(par_pre_resistance.Get(), par_reference_voltage.Get());
+  }
 
 //----------------------------------------------------------------------
 // Protected methods
@@ -115,14 +118,23 @@ protected:
 //----------------------------------------------------------------------
 private:
 
+  inline virtual void OnParameterChange() override
+  {
+    if (par_pre_resistance.HasChanged() or par_reference_voltage.HasChanged())
+    {
+      lookup_table_.template Rebuild<TResistance>(par_pre_resistance.Get(), par_reference_voltage.Get());
+    }
+  }
+
   inline virtual void Update() override
   {
     if (this->InputChanged())
     {
-      auto resistance = GetResistance(in_voltage.Get(), par_reference_voltage.Get(), par_pre_resistance.Get());
+      auto voltage = in_voltage.Get();
+      auto resistance = shared::tPTLookupTable::GetResistance(voltage, par_reference_voltage.Get(), par_pre_resistance.Get());
 
       out_resistance.Publish(resistance, in_voltage.GetTimestamp());
-      auto temperature = pt_.GetTemperature(resistance);
+      auto temperature = lookup_table_.GetTemperature(voltage);
       if(not std::isnan(temperature.Value()))
       {
     	  out_temperature.Publish(temperature, in_voltage.GetTimestamp());
@@ -130,40 +142,7 @@ private:
     }
   }
 
-  /*!
-   * Determines resistance value of PT sensor
-   * @param voltage A/D voltage
-   * @param reference_voltage reference voltage of A/D converter
-   * @param pre_resistance pre resistance of PT sensor
-   * @return resistance
-   */
-  inline rrlib::si_units::tElectricResistance<double> GetResistance(
-    const rrlib::si_units::tVoltage<double> & voltage_adc,
-    const rrlib::si_units::tVoltage<double> & voltage_ref,
-    const rrlib::si_units::tElectricResistance<double> & resistance_pre) const
-  {
-    /*
-     * _____ V_ref
-     *   |
-     *  [ ] R_pre
-     *   |____ V_adc
-     *   |
-     *  [ ] R_pt
-     * __|__
-     *        V_gnd
-     *
-     * R_pre / (V_ref - V_adc) = R_pt / (V_adc - V_gnf)
-     *
-     */
-    if (voltage_adc >= voltage_ref)
-    {
-      return resistance_pre;
-    }
-
-    return resistance_pre * voltage_adc / (voltage_ref - voltage_adc);
-  }
-
-  shared::tPT<TResistance> pt_;
+  shared::tPTLookupTable lookup_table_;
 
 };
 
@@ -0,0 +1,264 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/shared/mPTArray.h
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ * \brief Contains mPTArray
+ *
+ * \b mPTArray
+ *
+ * module that converts the voltages of several PT sensors into exponentially filtered temperatures.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __projects__smart_home__shared__mPTArray_h__
+#define __projects__smart_home__shared__mPTArray_h__
+
+#include "plugins/structure/tModule.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <array>
+#include <cmath>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "projects/smart_home/shared/tHeldInputFilter.h"
+#include "projects/smart_home/shared/tPTLookupTable.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace shared
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+enum class tPTType
+{
+  ePT100,
+  ePT500,
+  ePT1000
+};
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! SHORT_DESCRIPTION
+/*!
+ * module that converts the voltages of several PT sensors into exponentially filtered temperatures.
+ *
+ * Replaces one mPT and one mExponentialFilter per channel. Sensor type, pre resistance and
+ * filter weight are configured per channel, all channels are processed in a single Update.
+ *
+ * The filter weight applies to one filter period (the 200 ms control cycle by default). The
+ * input modules publish unchanged or decimated values less often, so the previous temperature of
+ * a channel is treated as held until the next value arrives (see tHeldInputFilter). This keeps
+ * the time constant independent of the publishing rate.
+ */
+template<size_t Tchannels>
+class mPTArray: public structure::tModule
+{
+
+//----------------------------------------------------------------------
+// Ports (These are the only variables that may be declared public)
+//----------------------------------------------------------------------
+public:
+
+  std::vector<tInput<rrlib::si_units::tVoltage<double>>> in_voltage;
+
+  std::vector<tOutput<rrlib::si_units::tCelsius<double>>> out_temperature;
+
+  std::vector<tParameter<tPTType>> par_pt_type;
+  std::vector<tParameter<rrlib::si_units::tElectricResistance<double>>> par_pre_resistance;
+  std::vector<tParameter<double>> par_filter_weight;
+
+  tParameter<rrlib::si_units::tVoltage<double>> par_reference_voltage;
+  tParameter<rrlib::si_units::tCelsius<double>> par_initial_value;
+  tParameter<rrlib::time::tDuration> par_filter_period;
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  mPTArray(core::tFrameworkElement *parent, const std::string &name = "PT Array") :
+    tModule(parent, name),
+    par_reference_voltage(5.0),
+    par_initial_value(20.0),
+    par_filter_period(std::chrono::milliseconds(200)),
+    filter_period_(std::chrono::milliseconds(200))
+  {
+    for (std::size_t i = 0; i < Tchannels; i++)
+    {
+      in_voltage.emplace_back(tInput<rrlib::si_units::tVoltage<double>>("Voltage " + std::to_string(i), this));
+      out_temperature.emplace_back(tOutput<rrlib::si_units::tCelsius<double>>("Temperature " + std::to_string(i), this));
+      par_pt_type.emplace_back(tParameter<tPTType>("PT Type " + std::to_string(i), this, tPTType::ePT1000));
+      par_pre_resistance.emplace_back(tParameter<rrlib::si_units::tElectricResistance<double>>("Pre Resistance " + std::to_string(i), this, 2000.0));
+      par_filter_weight.emplace_back(tParameter<double>("Filter Weight " + std::to_string(i), this, 1.0));
+    }
+
+    pt_type_.fill(tPTType::ePT1000);
+    pre_resistance_.fill(2000.0);
+    filter_weight_.fill(1.0);
+    filtered_.fill(par_initial_value.Get().ValueFactored());
+    last_input_.fill(par_initial_value.Get().ValueFactored());
+    last_update_time_.fill(rrlib::time::cNO_TIME);
+    for (std::size_t i = 0; i < Tchannels; i++)
+    {
+      RebuildLookupTable(i);
+    }
+  }
+
+//----------------------------------------------------------------------
+// Protected methods
+//----------------------------------------------------------------------
+protected:
+
+  /*! Destructor
+   *
+   * The destructor of modules is declared protected to avoid accidental deletion. Deleting
+   * modules is already handled by the framework.
+   */
+  ~mPTArray() {}
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  // channel configuration and filter state as struct of arrays
+  std::array<tPTType, Tchannels> pt_type_;
+  std::array<double, Tchannels> pre_resistance_;
+  std::array<double, Tchannels> filter_weight_;
+  std::array<double, Tchannels> filtered_;
+  std::array<double, Tchannels> last_input_;
+  std::array<rrlib::time::tTimestamp, Tchannels> last_update_time_;
+  std::array<tPTLookupTable, Tchannels> lookup_table_;
+  rrlib::time::tDuration filter_period_;
+
+  inline virtual void OnParameterChange() override
+  {
+    bool reference_voltage_changed = par_reference_voltage.HasChanged();
+    for (std::size_t i = 0; i < Tchannels; i++)
+    {
+      filter_weight_[i] = par_filter_weight[i].Get();
+      if (reference_voltage_changed or par_pt_type[i].HasChanged() or par_pre_resistance[i].HasChanged())
+      {
+        pt_type_[i] = par_pt_type[i].Get();
+        pre_resistance_[i] = par_pre_resistance[i].Get().Value();
+        RebuildLookupTable(i);
+      }
+    }
+    if (par_initial_value.HasChanged())
+    {
+      filtered_.fill(par_initial_value.Get().ValueFactored());
+      last_input_.fill(par_initial_value.Get().ValueFactored());
+    }
+    if (par_filter_period.Get() > rrlib::time::tDuration::zero())
+    {
+      filter_period_ = par_filter_period.Get();
+    }
+  }
+
+  inline virtual void Update() override
+  {
+    if (this->InputChanged())
+    {
+      for (std::size_t i = 0; i < Tchannels; i++)
+      {
+        if (not in_voltage[i].HasChanged())
+        {
+          continue;
+        }
+
+        double temperature = lookup_table_[i].GetTemperature(in_voltage[i].Get()).ValueFactored();
+        if (std::isnan(temperature))
+        {
+          continue;
+        }
+
+        auto timestamp = in_voltage[i].GetTimestamp();
+        filtered_[i] = tHeldInputFilter::Step(filtered_[i], last_input_[i], temperature, filter_weight_[i], GetFilterPeriods(i, timestamp));
+        last_input_[i] = temperature;
+        last_update_time_[i] = timestamp;
+        out_temperature[i].Publish(rrlib::si_units::tCelsius<double>(filtered_[i]), timestamp);
+      }
+    }
+  }
+
+  /*!
+   * Filter periods since the previous value of a channel
+   * @param channel index of channel
+   * @param timestamp timestamp of new value
+   * @return number of periods (one for the first value)
+   */
+  inline double GetFilterPeriods(std::size_t channel, const rrlib::time::tTimestamp & timestamp) const
+  {
+    if (last_update_time_[channel] == rrlib::time::cNO_TIME or timestamp <= last_update_time_[channel])
+    {
+      return 1.0;
+    }
+    return std::chrono::duration<double>(timestamp - last_update_time_[channel]).count() / std::chrono::duration<double>(filter_period_).count();
+  }
+
+  /*!
+   * Recomputes the conversion table of one channel
+   * @param channel index of channel
+   */
+  void RebuildLookupTable(std::size_t channel)
+  {
+    rrlib::si_units::tElectricResistance<double> pre_resistance(pre_resistance_[channel]);
+    switch (pt_type_[channel])
+    {
+    case tPTType::ePT100:
+      lookup_table_[channel].template Rebuild<100>(pre_resistance, par_reference_voltage.Get());
+      break;
+    case tPTType::ePT500:
+      lookup_table_[channel].template Rebuild<500>(pre_resistance, par_reference_voltage.Get());
+      break;
+    case tPTType::ePT1000:
+    default:
+      lookup_table_[channel].template Rebuild<1000>(pre_resistance, par_reference_voltage.Get());
+    };
+  }
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+#endif
@@ -0,0 +1,207 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/shared/tAsyncFileWriter.cpp
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ */
+//----------------------------------------------------------------------
+#include "projects/smart_home/shared/tAsyncFileWriter.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/logging/messages.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <libgen.h>
+#include <unistd.h>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace shared
+{
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+tAsyncFileWriter::tAsyncFileWriter(std::size_t capacity) :
+  buffer_(capacity),
+  stop_(false),
+  open_(false),
+  written_count_(0),
+  dropped_count_(0)
+{}
+
+tAsyncFileWriter::~tAsyncFileWriter()
+{
+  Close();
+}
+
+void tAsyncFileWriter::Open(const std::string &filename)
+{
+  Close();
+  filename_ = filename;
+  stop_ = false;
+  open_ = true;
+  writer_thread_ = std::thread(&tAsyncFileWriter::Run, this);
+}
+
+void tAsyncFileWriter::Close()
+{
+  if (writer_thread_.joinable())
+  {
+    stop_ = true;
+    writer_thread_.join();
+  }
+  open_ = false;
+}
+
+bool tAsyncFileWriter::Write(const std::string &content)
+{
+  assert(content.size() <= sizeof(tLogRecord::text));
+  if (not open_)
+  {
+    return false;
+  }
+  tLogRecord *record = buffer_.Reserve();
+  if (not record)
+  {
+    dropped_count_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  std::memcpy(record->text, content.data(), content.size());
+  record->length = static_cast<uint16_t>(content.size());
+  buffer_.Commit();
+  return true;
+}
+
+bool tAsyncFileWriter::ReplaceFile(const std::string &filename, const std::string &content)
+{
+  std::string temporary_filename = filename + ".tmp";
+  int file_descriptor = open(temporary_filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (file_descriptor < 0)
+  {
+    return false;
+  }
+  std::size_t written = 0;
+  while (written < content.size())
+  {
+    ssize_t result = write(file_descriptor, content.data() + written, content.size() - written);
+    if (result < 0 and errno == EINTR)
+    {
+      continue;
+    }
+    if (result < 0)
+    {
+      break;
+    }
+    written += result;
+  }
+
+  // the content has to be on the device before the rename makes it visible
+  bool stored = written == content.size() and fsync(file_descriptor) == 0;
+  stored &= close(file_descriptor) == 0;
+  if (not stored or std::rename(temporary_filename.c_str(), filename.c_str()) != 0)
+  {
+    std::remove(temporary_filename.c_str());
+    return false;
+  }
+
+  std::vector<char> path(filename.begin(), filename.end());
+  path.push_back('\0');
+  int directory = open(dirname(path.data()), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (directory >= 0)
+  {
+    fsync(directory);
+    close(directory);
+  }
+  return true;
+}
+
+void tAsyncFileWriter::Run()
+{
+  while (true)
+  {
+    // contents committed before the stop request are still written
+    bool stop = stop_.load(std::memory_order_acquire);
+
+    // only the newest content is stored
+    std::string content;
+    uint64_t count = 0;
+    for (const tLogRecord *record = buffer_.Front(); record; record = buffer_.Front())
+    {
+      content.assign(record->text, record->length);
+      count++;
+      buffer_.Pop();
+    }
+    if (count > 0)
+    {
+      if (ReplaceFile(filename_, content))
+      {
+        written_count_.fetch_add(1, std::memory_order_relaxed);
+      }
+      else
+      {
+        RRLIB_LOG_PRINT(WARNING, "Failed to replace ", filename_, ": ", std::strerror(errno));
+        dropped_count_.fetch_add(count, std::memory_order_relaxed);
+      }
+    }
+
+    if (stop)
+    {
+      return;
+    }
+    std::this_thread::sleep_for(cLOG_WRITER_PERIOD);
+  }
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
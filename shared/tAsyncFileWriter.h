@@ -0,0 +1,184 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/shared/tAsyncFileWriter.h
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tAsyncFileWriter
+ *
+ * \b tAsyncFileWriter
+ *
+ * Small state file that is replaced atomically by a background thread.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __projects__smart_home__shared__tAsyncFileWriter_h__
+#define __projects__smart_home__shared__tAsyncFileWriter_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "projects/smart_home/shared/tAsyncLogWriter.h"
+#include "projects/smart_home/shared/tSPSCRingBuffer.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace shared
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+// default number of buffered file contents
+static constexpr std::size_t cFILE_WRITER_DEFAULT_CAPACITY = 4;
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! SHORT_DESCRIPTION
+/*!
+ * Small state file (e.g. a sensor baseline) whose complete content is replaced by a background thread.
+ *
+ * Write hands the new content over to the writer thread through a lock-free ring buffer like
+ * tAsyncLogWriter, so the producing (control) thread never waits for the storage. The writer
+ * thread only stores the newest content of a period with ReplaceFile, so readers and a power
+ * loss always leave either the old or the new content. All contents have to be written by the
+ * same thread.
+ */
+class tAsyncFileWriter
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * Constructor
+   * @param capacity number of buffered contents
+   */
+  explicit tAsyncFileWriter(std::size_t capacity = cFILE_WRITER_DEFAULT_CAPACITY);
+
+  /*!
+   * Writes the buffered content and stops the writer thread
+   */
+  ~tAsyncFileWriter();
+
+  /*!
+   * Starts the writer thread for a file (the file is not touched until the first Write)
+   * @param filename file name
+   */
+  void Open(const std::string &filename);
+
+  /*!
+   * Writes the buffered content and stops the writer thread
+   */
+  void Close();
+
+  inline bool IsOpen() const
+  {
+    return open_;
+  }
+
+  /*!
+   * Replaces the content of the file (asynchronously)
+   * @param content new content (at most sizeof(tLogRecord::text) characters)
+   * @return false, if the content was dropped
+   */
+  bool Write(const std::string &content);
+
+  /*!
+   * Number of times the file was replaced (contents superseded within a writer period are skipped)
+   */
+  inline uint64_t GetWrittenCount() const
+  {
+    return written_count_.load(std::memory_order_relaxed);
+  }
+
+  /*!
+   * Number of contents lost because the buffer was full or the file could not be replaced
+   */
+  inline uint64_t GetDroppedCount() const
+  {
+    return dropped_count_.load(std::memory_order_relaxed);
+  }
+
+  /*!
+   * Replaces the content of a file atomically: writes a temporary file next to it, syncs it,
+   * renames it over the file and syncs the directory
+   * @param filename file name
+   * @param content new content
+   * @return true, if the file was replaced
+   */
+  static bool ReplaceFile(const std::string &filename, const std::string &content);
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  tSPSCRingBuffer<tLogRecord> buffer_;
+  std::string filename_;
+
+  std::thread writer_thread_;
+  std::atomic<bool> stop_;
+  bool open_;
+
+  std::atomic<uint64_t> written_count_;
+  std::atomic<uint64_t> dropped_count_;
+
+  /*!
+   * Main loop of the writer thread
+   */
+  void Run();
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -0,0 +1,225 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/shared/tAsyncLogWriter.cpp
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ */
+//----------------------------------------------------------------------
+#include "projects/smart_home/shared/tAsyncLogWriter.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/logging/messages.h"
+#include <algorithm>
+#include <cstring>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace shared
+{
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+thread_local tLogRecord tLogLine::dropped_record_;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+tAsyncLogWriter::tAsyncLogWriter(std::size_t capacity, std::size_t commit_size, rrlib::time::tDuration commit_interval) :
+  buffer_(capacity),
+  commit_size_(commit_size),
+  commit_interval_(commit_interval),
+  stop_(false),
+  open_(false),
+  dropped_count_(0),
+  written_count_(0),
+  commit_count_(0)
+{}
+
+tAsyncLogWriter::~tAsyncLogWriter()
+{
+  Close();
+}
+
+bool tAsyncLogWriter::Open(const std::string &filename, std::size_t record_size, const std::string &header)
+{
+  Close();
+  open_ = journal_.Open(filename, record_size, header);
+  if (open_)
+  {
+    stop_ = false;
+    writer_thread_ = std::thread(&tAsyncLogWriter::Run, this);
+  }
+  return open_;
+}
+
+void tAsyncLogWriter::Close()
+{
+  if (writer_thread_.joinable())
+  {
+    stop_ = true;
+    writer_thread_.join();
+  }
+  open_ = false;
+  journal_.Close();
+}
+
+bool tAsyncLogWriter::Write(const void *data, std::size_t length, tLogDurability durability)
+{
+  assert(length <= sizeof(tLogRecord::text));
+  if (not open_)
+  {
+    return false;
+  }
+  tLogRecord *record = buffer_.Reserve();
+  if (not record)
+  {
+    dropped_count_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  std::memcpy(record->text, data, length);
+  record->length = static_cast<uint16_t>(length);
+  record->durability = durability;
+  buffer_.Commit();
+  return true;
+}
+
+void tAsyncLogWriter::Run()
+{
+  uint64_t reported_dropped_count = 0;
+  uint64_t journal_dropped_count = 0;
+  rrlib::time::tTimestamp last_drop_report_time = rrlib::time::cNO_TIME;
+  uint64_t pending_count = 0;
+  rrlib::time::tTimestamp first_pending_time = rrlib::time::cNO_TIME;
+  while (true)
+  {
+    // records committed before the stop request are still written
+    bool stop = stop_.load(std::memory_order_acquire);
+
+    bool durable = false;
+    for (const tLogRecord *record = buffer_.Front(); record; record = buffer_.Front())
+    {
+      journal_.Append(record->text, record->length);
+      durable |= (record->durability == eLOG_DURABLE);
+      buffer_.Pop();
+      if (pending_count++ == 0)
+      {
+        first_pending_time = rrlib::time::Now();
+      }
+    }
+
+    // lines dropped by the journal while the file cannot be written
+    uint64_t dropped_by_journal = journal_.GetDroppedCount() - journal_dropped_count;
+    if (dropped_by_journal > 0)
+    {
+      journal_dropped_count += dropped_by_journal;
+      pending_count -= std::min(pending_count, dropped_by_journal);
+      dropped_count_.fetch_add(dropped_by_journal, std::memory_order_relaxed);
+    }
+
+    if (pending_count > 0 and (durable or stop or journal_.GetPendingSize() >= commit_size_
+                               or rrlib::time::Now() - first_pending_time >= commit_interval_))
+    {
+      if (journal_.Commit())
+      {
+        written_count_.fetch_add(pending_count, std::memory_order_relaxed);
+        pending_count = 0;
+      }
+      commit_count_.store(journal_.GetCommitCount(), std::memory_order_relaxed);
+    }
+
+    uint64_t dropped_count = GetDroppedCount();
+    if (dropped_count != reported_dropped_count and (stop or last_drop_report_time == rrlib::time::cNO_TIME
+        or rrlib::time::Now() - last_drop_report_time >= cJOURNAL_ERROR_LOG_INTERVAL))
+    {
+      RRLIB_LOG_PRINT(WARNING, "Log lines dropped: ", dropped_count - reported_dropped_count, " (", dropped_count, " in total).");
+      reported_dropped_count = dropped_count;
+      last_drop_report_time = rrlib::time::Now();
+    }
+
+    if (stop)
+    {
+      return;
+    }
+    std::this_thread::sleep_for(cLOG_WRITER_PERIOD);
+  }
+}
+
+tLogLine::tLogLine(tAsyncLogWriter &writer, tLogDurability durability) :
+  std::ostream(nullptr),
+  writer_(writer),
+  record_(writer.IsOpen() ? writer.buffer_.Reserve() : nullptr)
+{
+  if (record_)
+  {
+    record_->durability = durability;
+  }
+  stream_buffer_.Reset(record_ ? *record_ : dropped_record_);
+
+  // the stream buffer is a member and constructed after the std::ostream base (rdbuf also clears the bad bit)
+  rdbuf(&stream_buffer_);
+}
+
+tLogLine::~tLogLine()
+{
+  if (record_)
+  {
+    record_->length = static_cast<uint16_t>(stream_buffer_.GetLength());
+    if (record_->length == sizeof(record_->text) and record_->text[record_->length - 1] != '\n')
+    {
+      // truncated line
+      record_->text[record_->length - 1] = '\n';
+    }
+    writer_.buffer_.Commit();
+  }
+  else if (writer_.IsOpen())
+  {
+    writer_.dropped_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
@@ -0,0 +1,279 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/shared/tAsyncLogWriter.h
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tAsyncLogWriter.h
+ *
+ * \b tAsyncLogWriter.h
+ *
+ * Text log file written by a background thread.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __projects__smart_home__shared__tAsyncLogWriter_h__
+#define __projects__smart_home__shared__tAsyncLogWriter_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/time/time.h"
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "projects/smart_home/shared/tJournal.h"
+#include "projects/smart_home/shared/tSPSCRingBuffer.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace shared
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//! When a log line has to be stored on the device
+enum tLogDurability
+{
+  eLOG_BATCHED,  //!< with the next group commit
+  eLOG_DURABLE   //!< immediately (safety relevant events)
+};
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+// size of one log record (longer lines are truncated)
+static constexpr std::size_t cLOG_RECORD_SIZE = 512;
+
+// default number of buffered records
+static constexpr std::size_t cLOG_DEFAULT_CAPACITY = 256;
+
+// period in which the writer thread drains the buffer
+static const rrlib::time::tDuration cLOG_WRITER_PERIOD = std::chrono::milliseconds(50);
+
+// default group commit thresholds: pending bytes and age of the oldest pending line
+static constexpr std::size_t cLOG_DEFAULT_COMMIT_SIZE = 32 * 1024;
+static const rrlib::time::tDuration cLOG_DEFAULT_COMMIT_INTERVAL = std::chrono::minutes(5);
+
+//! One line or binary record of a log file
+struct tLogRecord
+{
+  uint16_t length;
+  uint8_t durability;
+  char text[cLOG_RECORD_SIZE - sizeof(uint16_t) - sizeof(uint8_t)];
+};
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! SHORT_DESCRIPTION
+/*!
+ * Text log file written by a background thread.
+ *
+ * Lines are formatted by tLogLine directly into a lock-free ring buffer; a writer thread
+ * collects them in a tJournal and group commits them once the pending data exceeds the
+ * commit size or the oldest pending line the commit interval. Lines marked eLOG_DURABLE
+ * are committed (with everything before them) in the writer period they arrive in.
+ * The producing (control) thread therefore never waits for the storage. If the buffer is
+ * full, the line is dropped and counted. All lines have to be written by the same thread.
+ */
+class tAsyncLogWriter
+{
+  friend class tLogLine;
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * Constructor
+   * @param capacity number of buffered records
+   * @param commit_size pending bytes that trigger a commit
+   * @param commit_interval maximum time a line stays uncommitted
+   */
+  explicit tAsyncLogWriter(std::size_t capacity = cLOG_DEFAULT_CAPACITY,
+                           std::size_t commit_size = cLOG_DEFAULT_COMMIT_SIZE,
+                           rrlib::time::tDuration commit_interval = cLOG_DEFAULT_COMMIT_INTERVAL);
+
+  /*!
+   * Commits all buffered records and closes the file
+   */
+  ~tAsyncLogWriter();
+
+  /*!
+   * Opens a file for appending and starts the writer thread
+   * @param filename file name
+   * @param record_size size of binary records written with Write (0 for a text log)
+   * @param header header of a binary log (see tJournal::Open)
+   * @return true, if the file was opened
+   */
+  bool Open(const std::string &filename, std::size_t record_size = 0, const std::string &header = std::string());
+
+  /*!
+   * Commits all buffered records, stops the writer thread and closes the file
+   */
+  void Close();
+
+  inline bool IsOpen() const
+  {
+    return open_;
+  }
+
+  /*!
+   * Writes a binary record (instead of a tLogLine)
+   * @param data record
+   * @param length length of the record (at most sizeof(tLogRecord::text))
+   * @param durability when the record has to be stored on the device
+   * @return false, if the record was dropped
+   */
+  bool Write(const void *data, std::size_t length, tLogDurability durability = eLOG_BATCHED);
+
+  /*!
+   * Number of lines lost because the buffer was full or the file could not be written
+   */
+  inline uint64_t GetDroppedCount() const
+  {
+    return dropped_count_.load(std::memory_order_relaxed);
+  }
+
+  /*!
+   * Number of lines committed to the file
+   */
+  inline uint64_t GetWrittenCount() const
+  {
+    return written_count_.load(std::memory_order_relaxed);
+  }
+
+  /*!
+   * Number of group commits (write and sync calls)
+   */
+  inline uint64_t GetCommitCount() const
+  {
+    return commit_count_.load(std::memory_order_relaxed);
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  tSPSCRingBuffer<tLogRecord> buffer_;
+  const std::size_t commit_size_;
+  const rrlib::time::tDuration commit_interval_;
+
+  // only accessed by the writer thread while it runs
+  tJournal journal_;
+
+  std::thread writer_thread_;
+  std::atomic<bool> stop_;
+  bool open_;
+
+  std::atomic<uint64_t> dropped_count_;
+  std::atomic<uint64_t> written_count_;
+  std::atomic<uint64_t> commit_count_;
+
+  /*!
+   * Main loop of the writer thread
+   */
+  void Run();
+
+};
+
+//! SHORT_DESCRIPTION
+/*!
+ * One line of an asynchronous log, used like an output stream.
+ *
+ * The line is formatted in place into the ring buffer of the writer and handed over to the
+ * writer thread when the object is destroyed. Lines are expected to end with '\n'.
+ * Usage: tLogLine(log) << timestamp << " text\n";  or  tLogLine(log, eLOG_DURABLE) << ...
+ */
+class tLogLine : public std::ostream
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit tLogLine(tAsyncLogWriter &writer, tLogDurability durability = eLOG_BATCHED);
+
+  ~tLogLine();
+
+  tLogLine(const tLogLine &) = delete;
+  tLogLine &operator=(const tLogLine &) = delete;
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  //! Stream buffer on the text of a record (stops writing when full)
+  class tRecordBuffer : public std::streambuf
+  {
+  public:
+    void Reset(tLogRecord &record)
+    {
+      setp(record.text, record.text + sizeof(record.text));
+    }
+
+    inline std::size_t GetLength() const
+    {
+      return pptr() - pbase();
+    }
+  };
+
+  tAsyncLogWriter &writer_;
+  tLogRecord *record_;
+  tRecordBuffer stream_buffer_;
+
+  // target of lines that do not fit into the ring buffer
+  static thread_local tLogRecord dropped_record_;
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
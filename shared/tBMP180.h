@@ -0,0 +1,442 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/shared/tBMP180.h
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tBMP180.h
+ *
+ * \b tBMP180.h
+ *
+ * Driver for the BMP180 air pressure sensor which runs measurements without blocking.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __projects__smart_home__shared__tBMP180_h__
+#define __projects__smart_home__shared__tBMP180_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/logging/messages.h"
+#include "rrlib/time/time.h"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "projects/smart_home/shared/tI2CDevice.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace shared
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+enum tBMP180OSSMode
+{
+  tBMP180_OSS_ULTRA_LOW_POWER = 0x00,
+  tBMP180_OSS_STANDARD = 0x01,
+  tBMP180_OSS_HIGH_RESOLUTION = 0x02,
+  tBMP180_OSS_ULTRA_HIGH_RESOLUTION = 0x03
+};
+
+enum class tBMP180Phase
+{
+  eIDLE,
+  eTEMPERATURE_CONVERSION,
+  ePRESSURE_CONVERSION
+};
+
+static constexpr uint8_t cBMP180_I2C_ADDRESS = 0x77;
+static constexpr uint8_t cBMP180_ID = 0xD0;
+static constexpr uint8_t cBMP180_CTRL_MEAS = 0xF4;
+static constexpr uint8_t cBMP180_OUT_MSB = 0xF6;
+static constexpr uint8_t cBMP180_OUT_LSB = 0xF7;
+static constexpr uint8_t cBMP180_OUT_XLSB = 0xF8;
+static constexpr uint8_t cBMP180_SOFT_RESET = 0xE0;
+static constexpr uint8_t cBMP180_CALIBRATION = 0xAA;
+static constexpr std::size_t cBMP180_CALIBRATION_SIZE = 22;
+static constexpr unsigned int cBMP180_CALIBRATION_ATTEMPTS = 3;
+
+static constexpr uint8_t cBMP180_REGISTER_TEMPERATURE = 0x2E;
+static constexpr uint8_t cBMP180_REGISTER_AIR_PRESSURE = 0x34;
+
+// range of pressure ratio p / p0 covered by the altitude table (approx. -1800 m to 10000 m)
+static constexpr double cBMP180_ALTITUDE_TABLE_MIN_RATIO = 0.25;
+static constexpr double cBMP180_ALTITUDE_TABLE_MAX_RATIO = 1.25;
+static constexpr std::size_t cBMP180_ALTITUDE_TABLE_SIZE = 513;
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! SHORT_DESCRIPTION
+/*!
+ * Driver for the BMP180 air pressure sensor which runs measurements without blocking.
+ *
+ * Process() is called once per cycle. It starts a conversion, returns immediately, and
+ * collects the result in the first call after the conversion time of the sensor has passed.
+ * A complete measurement (temperature and air pressure) therefore spans several cycles.
+ */
+class tBMP180
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * Constructor
+   * @param device I2C device of the sensor (must outlive the driver)
+   */
+  tBMP180(tI2CDevice & device):
+    device_(device),
+    phase_(tBMP180Phase::eIDLE),
+    conversion_mode_(tBMP180OSSMode::tBMP180_OSS_STANDARD),
+    conversion_start_(rrlib::time::cNO_TIME),
+    raw_temperature_(0),
+    raw_pressure_(0),
+    temperature_time_(rrlib::time::cNO_TIME),
+    pressure_time_(rrlib::time::cNO_TIME),
+    ac1_(0),
+    ac2_(0),
+    ac3_(0),
+    ac4_(0),
+    ac5_(0),
+    ac6_(0),
+    b1_(0),
+    b2_(0),
+    mb_(0),
+    mc_(0),
+    md_(0)
+  {}
+
+  /*!
+   * Reads the calibration coefficients from the sensor's EEPROM in one block read
+   *
+   * Coefficients of 0x0000 or 0xFFFF are rejected, as the data sheet uses them to detect
+   * a failed communication.
+   *
+   * @return true, if valid coefficients were read (otherwise the previous ones are kept)
+   */
+  bool LoadCalibration()
+  {
+    std::array<uint8_t, cBMP180_CALIBRATION_SIZE> block;
+    device_.ReadBlock(cBMP180_CALIBRATION, block.data(), block.size());
+
+    std::array<int32_t, cBMP180_CALIBRATION_SIZE / 2> coefficients;
+    for (std::size_t i = 0; i < coefficients.size(); i++)
+    {
+      coefficients[i] = (block[2 * i] << 8) + block[2 * i + 1];
+      if (coefficients[i] == 0x0000 or coefficients[i] == 0xFFFF)
+      {
+        return false;
+      }
+    }
+    SetCalibration(coefficients);
+    return true;
+  }
+
+  /*!
+   * Advances the measurement without waiting for the sensor
+   * @param now current time
+   * @param mode oversampling mode for the next pressure conversion
+   * @return true, if a new pair of raw temperature and raw pressure is available
+   */
+  bool Process(const rrlib::time::tTimestamp & now, tBMP180OSSMode mode)
+  {
+    switch (phase_)
+    {
+    case tBMP180Phase::eTEMPERATURE_CONVERSION:
+      if (now - conversion_start_ < GetTemperatureConversionTime())
+      {
+        return false;
+      }
+      raw_temperature_ = static_cast<int16_t>((device_.ReadByte(cBMP180_OUT_MSB) << 8) + device_.ReadByte(cBMP180_OUT_LSB));
+      temperature_time_ = now;
+
+      // start air pressure measurement
+      conversion_mode_ = mode;
+      device_.WriteByte(cBMP180_CTRL_MEAS, cBMP180_REGISTER_AIR_PRESSURE + (static_cast<uint8_t>(conversion_mode_) << 6));
+      conversion_start_ = now;
+      phase_ = tBMP180Phase::ePRESSURE_CONVERSION;
+      return false;
+
+    case tBMP180Phase::ePRESSURE_CONVERSION:
+      if (now - conversion_start_ < GetPressureConversionTime(conversion_mode_))
+      {
+        return false;
+      }
+      raw_pressure_ = ((device_.ReadByte(cBMP180_OUT_MSB) << 16) +
+                       (device_.ReadByte(cBMP180_OUT_LSB) << 8) +
+                       device_.ReadByte(cBMP180_OUT_XLSB)) >> (8 - conversion_mode_);
+      pressure_time_ = now;
+
+      StartTemperatureConversion(now);
+      return true;
+
+    case tBMP180Phase::eIDLE:
+    default:
+      StartTemperatureConversion(now);
+      return false;
+    };
+  }
+
+  /*!
+   * Computes the intermediate value B5 of the data sheet compensation
+   * @param raw_temperature uncompensated temperature (UT)
+   * @return B5
+   */
+  inline int32_t ComputeB5(int32_t raw_temperature) const
+  {
+    int32_t x1 = ((raw_temperature - ac6_) * ac5_) >> 15;
+    int32_t x2 = (mc_ * 2048) / (x1 + md_);
+    return x1 + x2;
+  }
+
+  /*!
+   * Computes the temperature from a raw temperature value
+   * @param raw_temperature uncompensated temperature (UT)
+   * @return temperature in 0.1 degree Celsius
+   */
+  inline int32_t ComputeTemperature(int32_t raw_temperature) const
+  {
+    return (ComputeB5(raw_temperature) + 8) >> 4;
+  }
+
+  /*!
+   * Computes the air pressure following the integer algorithm of the data sheet
+   * @param raw_pressure uncompensated pressure (UP)
+   * @param raw_temperature uncompensated temperature (UT) of the same measurement
+   * @param mode oversampling mode used for the pressure conversion
+   * @return air pressure in Pa
+   */
+  inline int32_t ComputePressure(int32_t raw_pressure, int32_t raw_temperature, tBMP180OSSMode mode) const
+  {
+    const int oss = static_cast<int>(mode);
+
+    int32_t b6 = ComputeB5(raw_temperature) - 4000;
+    int32_t x1 = (b2_ * ((b6 * b6) >> 12)) >> 11;
+    int32_t x2 = (ac2_ * b6) >> 11;
+    int32_t x3 = x1 + x2;
+    int32_t b3 = ((((ac1_ * 4) + x3) << oss) + 2) / 4;
+
+    x1 = (ac3_ * b6) >> 13;
+    x2 = (b1_ * ((b6 * b6) >> 12)) >> 16;
+    x3 = ((x1 + x2) + 2) >> 2;
+    uint32_t b4 = (ac4_ * static_cast<uint32_t>(x3 + 32768)) >> 15;
+    uint32_t b7 = (static_cast<uint32_t>(raw_pressure) - b3) * (50000 >> oss);
+    if (b4 == 0)
+    {
+      return 0;
+    }
+
+    int32_t pressure = (b7 < 0x80000000) ? static_cast<int32_t>((b7 * 2) / b4) : static_cast<int32_t>((b7 / b4) * 2);
+    x1 = (pressure >> 8) * (pressure >> 8);
+    x1 = (x1 * 3038) >> 16;
+    x2 = (-7357 * pressure) >> 16;
+    RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "b3: ", b3, " b4: ", b4, " b7: ", b7);
+    return pressure + ((x1 + x2 + 3791) >> 4);
+  }
+
+  /*!
+   * Computes the altitude from the international barometric formula
+   *
+   * The term (p / p0)^(1 / 5.255) is linearly interpolated in a precomputed table.
+   * The approximation error is below 0.1 m inside the table range.
+   *
+   * @param pressure air pressure in Pa
+   * @param pressure_sea_level air pressure at sea level in Pa
+   * @return altitude in m
+   */
+  static inline double ComputeAltitude(double pressure, double pressure_sea_level)
+  {
+    static const std::array<double, cBMP180_ALTITUDE_TABLE_SIZE> cTABLE = []()
+    {
+      std::array<double, cBMP180_ALTITUDE_TABLE_SIZE> table;
+      for (std::size_t i = 0; i < table.size(); i++)
+      {
+        double ratio = cBMP180_ALTITUDE_TABLE_MIN_RATIO + i * cALTITUDE_TABLE_STEP;
+        table[i] = std::pow(ratio, 1 / 5.255);
+      }
+      return table;
+    }();
+
+    double ratio = pressure / pressure_sea_level;
+    if (not(ratio >= cBMP180_ALTITUDE_TABLE_MIN_RATIO and ratio < cBMP180_ALTITUDE_TABLE_MAX_RATIO))
+    {
+      return 44330.0 * (1.0 - std::pow(ratio, 1 / 5.255));
+    }
+
+    double index = (ratio - cBMP180_ALTITUDE_TABLE_MIN_RATIO) / cALTITUDE_TABLE_STEP;
+    std::size_t lower = static_cast<std::size_t>(index);
+    double fraction = index - static_cast<double>(lower);
+    return 44330.0 * (1.0 - (cTABLE[lower] + fraction * (cTABLE[lower + 1] - cTABLE[lower])));
+  }
+
+  /*!
+   * Getter for conversion time of temperature
+   * @return conversion time
+   */
+  static inline rrlib::time::tDuration GetTemperatureConversionTime()
+  {
+    return std::chrono::microseconds(4500);
+  }
+
+  /*!
+   * Getter for conversion time of air pressure
+   * @param mode oversampling mode
+   * @return conversion time
+   */
+  static inline rrlib::time::tDuration GetPressureConversionTime(tBMP180OSSMode mode)
+  {
+    switch (mode)
+    {
+    case tBMP180OSSMode::tBMP180_OSS_ULTRA_LOW_POWER:
+      return std::chrono::microseconds(4500);
+    case tBMP180OSSMode::tBMP180_OSS_STANDARD:
+      return std::chrono::microseconds(7500);
+    case tBMP180OSSMode::tBMP180_OSS_HIGH_RESOLUTION:
+      return std::chrono::microseconds(13500);
+    case tBMP180OSSMode::tBMP180_OSS_ULTRA_HIGH_RESOLUTION:
+    default:
+      return std::chrono::microseconds(25500);
+    };
+  }
+
+  inline tBMP180Phase GetPhase() const
+  {
+    return phase_;
+  }
+
+  inline int16_t GetRawTemperature() const
+  {
+    return raw_temperature_;
+  }
+
+  inline int32_t GetRawPressure() const
+  {
+    return raw_pressure_;
+  }
+
+  inline tBMP180OSSMode GetPressureMode() const
+  {
+    return conversion_mode_;
+  }
+
+  inline rrlib::time::tTimestamp GetTemperatureTime() const
+  {
+    return temperature_time_;
+  }
+
+  inline rrlib::time::tTimestamp GetPressureTime() const
+  {
+    return pressure_time_;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  static constexpr double cALTITUDE_TABLE_STEP = (cBMP180_ALTITUDE_TABLE_MAX_RATIO - cBMP180_ALTITUDE_TABLE_MIN_RATIO) / (cBMP180_ALTITUDE_TABLE_SIZE - 1);
+
+  tI2CDevice & device_;
+
+  tBMP180Phase phase_;
+  tBMP180OSSMode conversion_mode_;
+  rrlib::time::tTimestamp conversion_start_;
+
+  int16_t raw_temperature_;
+  int32_t raw_pressure_;
+  rrlib::time::tTimestamp temperature_time_;
+  rrlib::time::tTimestamp pressure_time_;
+
+  int16_t ac1_;
+  int16_t ac2_;
+  int16_t ac3_;
+  uint16_t ac4_;
+  uint16_t ac5_;
+  uint16_t ac6_;
+  int16_t b1_;
+  int16_t b2_;
+  int16_t mb_;
+  int16_t mc_;
+  int16_t md_;
+
+  /*!
+   * Assigns the calibration coefficients
+   * @param coefficients coefficients AC1 to MD in data sheet order (16 bit each)
+   */
+  void SetCalibration(const std::array<int32_t, cBMP180_CALIBRATION_SIZE / 2> & coefficients)
+  {
+    ac1_ = static_cast<int16_t>(coefficients[0]);
+    ac2_ = static_cast<int16_t>(coefficients[1]);
+    ac3_ = static_cast<int16_t>(coefficients[2]);
+    ac4_ = static_cast<uint16_t>(coefficients[3]);
+    ac5_ = static_cast<uint16_t>(coefficients[4]);
+    ac6_ = static_cast<uint16_t>(coefficients[5]);
+    b1_ = static_cast<int16_t>(coefficients[6]);
+    b2_ = static_cast<int16_t>(coefficients[7]);
+    mb_ = static_cast<int16_t>(coefficients[8]);
+    mc_ = static_cast<int16_t>(coefficients[9]);
+    md_ = static_cast<int16_t>(coefficients[10]);
+    RRLIB_LOG_PRINT(DEBUG, "Calibration: AC1 ", ac1_, " AC2 ", ac2_, " AC3 ", ac3_, " AC4 ", ac4_, " AC5 ", ac5_, " AC6 ", ac6_,
+                    " B1 ", b1_, " B2 ", b2_, " MB ", mb_, " MC ", mc_, " MD ", md_);
+  }
+
+  /*!
+   * Starts a temperature conversion
+   * @param now current time
+   */
+  inline void StartTemperatureConversion(const rrlib::time::tTimestamp & now)
+  {
+    device_.WriteByte(cBMP180_CTRL_MEAS, cBMP180_REGISTER_TEMPERATURE);
+    conversion_start_ = now;
+    phase_ = tBMP180Phase::eTEMPERATURE_CONVERSION;
+  }
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
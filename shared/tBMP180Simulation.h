@@ -0,0 +1,202 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/shared/tBMP180Simulation.h
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tBMP180Simulation.h
+ *
+ * \b tBMP180Simulation.h
+ *
+ * Simulated BMP180 on the I2C bus for hardware-free runs and tests.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __projects__smart_home__shared__tBMP180Simulation_h__
+#define __projects__smart_home__shared__tBMP180Simulation_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <array>
+#include <cstdint>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "projects/smart_home/shared/tBMP180.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace shared
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! SHORT_DESCRIPTION
+/*!
+ * Simulated BMP180 on the I2C bus for hardware-free runs and tests.
+ *
+ * Calibration and raw values default to the example of the BMP180 data sheet
+ * (UT = 27898, UP = 23843 with OSS = 0, i.e. 15.0 degree Celsius and 69964 Pa).
+ * Conversions complete instantly. Register accesses are counted per bus transaction,
+ * i.e. a block read counts as one read.
+ */
+class tBMP180Simulation : public tI2CDevice
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  tBMP180Simulation():
+    raw_temperature_(27898),
+    raw_pressure_(23843),
+    read_count_(0),
+    write_count_(0)
+  {
+    registers_.fill(0);
+    registers_[cBMP180_ID] = 0x55;
+    SetCalibration({{408, -72, -14383, 32741, 32757, 23153, 6190, 4, -32768, -8711, 2868}});
+  }
+
+  /*!
+   * Sets the calibration coefficients AC1 to MD in data sheet order
+   * @param coefficients calibration coefficients
+   */
+  void SetCalibration(const std::array<int32_t, cBMP180_CALIBRATION_SIZE / 2> & coefficients)
+  {
+    for (std::size_t i = 0; i < coefficients.size(); i++)
+    {
+      uint16_t value = static_cast<uint16_t>(coefficients[i]);
+      registers_[cBMP180_CALIBRATION + 2 * i] = static_cast<uint8_t>(value >> 8);
+      registers_[cBMP180_CALIBRATION + 2 * i + 1] = static_cast<uint8_t>(value & 0xFF);
+    }
+  }
+
+  /*!
+   * Sets the values returned by the next conversions
+   * @param raw_temperature uncompensated temperature (UT)
+   * @param raw_pressure uncompensated pressure (UP)
+   */
+  void SetRawValues(int32_t raw_temperature, int32_t raw_pressure)
+  {
+    raw_temperature_ = raw_temperature;
+    raw_pressure_ = raw_pressure;
+  }
+
+  virtual uint8_t ReadByte(uint8_t device_register) override
+  {
+    read_count_++;
+    return registers_[device_register];
+  }
+
+  virtual void ReadBlock(uint8_t start_register, uint8_t *buffer, std::size_t length) override
+  {
+    read_count_++;
+    for (std::size_t i = 0; i < length; i++)
+    {
+      buffer[i] = registers_[(start_register + i) & 0xFF];
+    }
+  }
+
+  virtual void WriteByte(uint8_t device_register, uint8_t value) override
+  {
+    write_count_++;
+    registers_[device_register] = value;
+    if (device_register != cBMP180_CTRL_MEAS)
+    {
+      return;
+    }
+
+    if (value == cBMP180_REGISTER_TEMPERATURE)
+    {
+      SetOutput(static_cast<uint32_t>(raw_temperature_) << 8);
+    }
+    else if ((value & 0x3F) == cBMP180_REGISTER_AIR_PRESSURE)
+    {
+      uint8_t oss = value >> 6;
+      SetOutput(static_cast<uint32_t>(raw_pressure_) << (8 - oss));
+    }
+  }
+
+  virtual uint8_t GetDeviceAddress() const override
+  {
+    return cBMP180_I2C_ADDRESS;
+  }
+
+  inline std::size_t GetReadCount() const
+  {
+    return read_count_;
+  }
+
+  inline std::size_t GetWriteCount() const
+  {
+    return write_count_;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  std::array<uint8_t, 256> registers_;
+  int32_t raw_temperature_;
+  int32_t raw_pressure_;
+  std::size_t read_count_;
+  std::size_t write_count_;
+
+  /*!
+   * Fills the output registers (MSB, LSB, XLSB)
+   * @param value 24 bit output value
+   */
+  inline void SetOutput(uint32_t value)
+  {
+    registers_[cBMP180_OUT_MSB] = static_cast<uint8_t>((value >> 16) & 0xFF);
+    registers_[cBMP180_OUT_LSB] = static_cast<uint8_t>((value >> 8) & 0xFF);
+    registers_[cBMP180_OUT_XLSB] = static_cast<uint8_t>(value & 0xFF);
+  }
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -0,0 +1,160 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/shared/tChangeGatedOutput.h
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tChangeGatedOutput.h
+ *
+ * \b tChangeGatedOutput.h
+ *
+ * Output port wrapper that publishes only changed values and an optional heartbeat.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __projects__smart_home__shared__tChangeGatedOutput_h__
+#define __projects__smart_home__shared__tChangeGatedOutput_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/time/time.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace shared
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! SHORT_DESCRIPTION
+/*!
+ * Output port wrapper that publishes only changed values and an optional heartbeat.
+ *
+ * Modules call Publish every cycle with the value and timestamp of the cycle. The value
+ * reaches the port only if it differs from the last published one or if the heartbeat
+ * interval has passed since then (e.g. for receivers that supervise their inputs).
+ * The first value is always published.
+ */
+template<typename T, typename TPort>
+class tChangeGatedOutput
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * Constructor
+   * @param port wrapped port
+   * @param heartbeat interval after which an unchanged value is published again (zero disables the heartbeat)
+   */
+  tChangeGatedOutput(TPort & port, const rrlib::time::tDuration & heartbeat = rrlib::time::tDuration::zero()):
+    port_(port),
+    heartbeat_(heartbeat),
+    value_(),
+    last_publish_time_(rrlib::time::cNO_TIME),
+    published_(false)
+  {}
+
+  /*!
+   * Publishes a value if it has changed or the heartbeat is due
+   * @param value value
+   * @param timestamp timestamp of the current cycle
+   * @return true, if the value was published
+   */
+  bool Publish(const T & value, const rrlib::time::tTimestamp & timestamp)
+  {
+    bool heartbeat_due = heartbeat_ > rrlib::time::tDuration::zero() and timestamp - last_publish_time_ >= heartbeat_;
+    if (published_ and value == value_ and not heartbeat_due)
+    {
+      return false;
+    }
+
+    port_.Publish(value, timestamp);
+    value_ = value;
+    last_publish_time_ = timestamp;
+    published_ = true;
+    return true;
+  }
+
+  /*!
+   * Publishes the next value unconditionally (e.g. after the port was written directly)
+   */
+  inline void Invalidate()
+  {
+    published_ = false;
+  }
+
+  /*!
+   * Getter for the last published value
+   * @return value
+   */
+  inline const T & Get() const
+  {
+    return value_;
+  }
+
+  inline void SetHeartbeat(const rrlib::time::tDuration & heartbeat)
+  {
+    heartbeat_ = heartbeat;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  TPort & port_;
+  rrlib::time::tDuration heartbeat_;
+  T value_;
+  rrlib::time::tTimestamp last_publish_time_;
+  bool published_;
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -0,0 +1,119 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/shared/tCycleClock.cpp
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ */
+//----------------------------------------------------------------------
+#include "projects/smart_home/shared/tCycleClock.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/logging/messages.h"
+#include <cstdlib>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace shared
+{
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+static tSystemClock cSYSTEM_CLOCK;
+
+static std::atomic<tCycleClock *> cycle_clock(&cSYSTEM_CLOCK);
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+tSimulatedClock::tSimulatedClock(const rrlib::time::tTimestamp & start, double time_scale) :
+  start_(start),
+  system_start_(rrlib::time::Now()),
+  time_scale_(time_scale > 0.0 ? time_scale : 0.0),
+  offset_(0)
+{}
+
+rrlib::time::tTimestamp tSimulatedClock::Now() const
+{
+  std::chrono::nanoseconds elapsed(offset_.load(std::memory_order_relaxed));
+  if (time_scale_ > 0.0)
+  {
+    auto system_elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(rrlib::time::Now() - system_start_);
+    elapsed += std::chrono::nanoseconds(static_cast<int64_t>(system_elapsed.count() * time_scale_));
+  }
+  return start_ + std::chrono::duration_cast<rrlib::time::tDuration>(elapsed);
+}
+
+void tSimulatedClock::Advance(const rrlib::time::tDuration & duration)
+{
+  if (duration > rrlib::time::tDuration::zero())
+  {
+    offset_.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count(), std::memory_order_relaxed);
+  }
+}
+
+tCycleClock &GetCycleClock()
+{
+  return *cycle_clock.load();
+}
+
+void SetCycleClock(tCycleClock &clock)
+{
+  cycle_clock.store(&clock);
+}
+
+bool ConfigureCycleClockFromEnvironment()
+{
+  const char *time_scale = std::getenv("SMART_HOME_TIME_SCALE");
+  double scale = time_scale ? std::atof(time_scale) : 0.0;
+  if (scale <= 0.0)
+  {
+    return false;
+  }
+
+  static tSimulatedClock simulated_clock(rrlib::time::Now(), scale);
+  SetCycleClock(simulated_clock);
+  RRLIB_LOG_PRINT(USER, "Running on simulated time (time scale ", scale, ")");
+  return true;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
@@ -0,0 +1,189 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/shared/tCycleClock.h
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tCycleClock.h
+ *
+ * \b tCycleClock.h
+ *
+ * Clock sampled by the modules once per cycle, either system time or simulated time.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __projects__smart_home__shared__tCycleClock_h__
+#define __projects__smart_home__shared__tCycleClock_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/time/time.h"
+#include <atomic>
+#include <cstdint>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace shared
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! SHORT_DESCRIPTION
+/*!
+ * Clock sampled by the modules once per cycle.
+ *
+ * All timing of a module (pump dwell times, log intervals, outdated detection) is derived
+ * from the timestamp taken at the beginning of its cycle. Replacing the clock lets the
+ * controllers run on simulated time.
+ */
+class tCycleClock
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  virtual ~tCycleClock()
+  {}
+
+  /*!
+   * Current time of the clock (thread safe)
+   * @return timestamp
+   */
+  virtual rrlib::time::tTimestamp Now() const = 0;
+
+};
+
+//! System time of rrlib::time
+class tSystemClock : public tCycleClock
+{
+public:
+
+  virtual rrlib::time::tTimestamp Now() const override
+  {
+    return rrlib::time::Now();
+  }
+
+};
+
+//! SHORT_DESCRIPTION
+/*!
+ * Simulated time starting at an arbitrary point in time.
+ *
+ * With a positive time scale, simulated time passes time_scale times faster than system
+ * time (e.g. 600.0 runs a week within about 17 minutes). With a time scale of zero, time
+ * only passes via Advance, which allows tests to step through days of controller behaviour
+ * cycle by cycle. Advance can be combined with a positive time scale.
+ */
+class tSimulatedClock : public tCycleClock
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * Constructor
+   * @param start simulated time at construction
+   * @param time_scale speed of simulated time relative to system time (zero: manually stepped)
+   */
+  explicit tSimulatedClock(const rrlib::time::tTimestamp & start = rrlib::time::Now(), double time_scale = 0.0);
+
+  virtual rrlib::time::tTimestamp Now() const override;
+
+  /*!
+   * Moves simulated time forward
+   * @param duration duration (negative durations are ignored)
+   */
+  void Advance(const rrlib::time::tDuration & duration);
+
+  inline double GetTimeScale() const
+  {
+    return time_scale_;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  const rrlib::time::tTimestamp start_;
+  const rrlib::time::tTimestamp system_start_;
+  const double time_scale_;
+
+  // time added by Advance in nanoseconds
+  std::atomic<int64_t> offset_;
+
+};
+
+//----------------------------------------------------------------------
+// Function declaration
+//----------------------------------------------------------------------
+
+/*!
+ * Clock of all modules that are not given a clock explicitly (system clock by default)
+ * @return clock
+ */
+tCycleClock &GetCycleClock();
+
+/*!
+ * Replaces the default clock (call before the modules are created)
+ * @param clock clock (has to outlive all modules using it)
+ */
+void SetCycleClock(tCycleClock &clock);
+
+/*!
+ * Installs a simulated clock as default clock if the environment variable
+ * SMART_HOME_TIME_SCALE contains a positive time scale (e.g. 60 for one simulated
+ * minute per second)
+ * @return true, if simulated time is used
+ */
+bool ConfigureCycleClockFromEnvironment();
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -0,0 +1,99 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/shared/tHeldInputFilter.h
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tHeldInputFilter.h
+ *
+ * \b tHeldInputFilter.h
+ *
+ * Exponential filter step for inputs that are published only now and then.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __projects__smart_home__shared__tHeldInputFilter_h__
+#define __projects__smart_home__shared__tHeldInputFilter_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cmath>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace shared
+{
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! SHORT_DESCRIPTION
+/*!
+ * Exponential filter step for inputs that are published only now and then.
+ *
+ * Input modules publish unchanged or decimated values less often than once per filter period.
+ * Between two publishes the input is held at the previous value, so the filter first decays
+ * toward the held value for all periods but the last and then takes one step toward the new
+ * value. The result equals one filter step per period with the input held.
+ */
+struct tHeldInputFilter
+{
+  /*!
+   * Filters a new input
+   * @param filtered current filter output
+   * @param held_input previous input
+   * @param input new input
+   * @param weight weight of the new input in one filter period
+   * @param periods filter periods since the previous input (at least one step is taken)
+   * @return new filter output
+   */
+  static inline double Step(double filtered, double held_input, double input, double weight, double periods)
+  {
+    if (periods > 1.0)
+    {
+      filtered = held_input + (filtered - held_input) * std::pow(1.0 - weight, periods - 1.0);
+    }
+    return filtered + weight * (input - filtered);
+  }
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -0,0 +1,212 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/shared/tI2CDevice.h
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tI2CDevice.h
+ *
+ * \b tI2CDevice.h
+ *
+ * Register access to an I2C device, either on the Raspberry Pi bus or simulated.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __projects__smart_home__shared__tI2CDevice_h__
+#define __projects__smart_home__shared__tI2CDevice_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#ifdef _LIB_WIRING_PI_PRESENT_
+#include "rrlib/gpio/tI2C.h"
+#include <wiringPiI2C.h>
+#include <unistd.h>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace shared
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! SHORT_DESCRIPTION
+/*!
+ * Register access to an I2C device, either on the Raspberry Pi bus or simulated.
+ */
+class tI2CDevice
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * Destructor
+   */
+  virtual ~tI2CDevice()
+  {}
+
+  /*!
+   * Reads one register
+   * @param device_register register address
+   * @return register value
+   */
+  virtual uint8_t ReadByte(uint8_t device_register) = 0;
+
+  /*!
+   * Writes one register
+   * @param device_register register address
+   * @param value register value
+   */
+  virtual void WriteByte(uint8_t device_register, uint8_t value) = 0;
+
+  /*!
+   * Reads consecutive registers
+   *
+   * Reads register by register unless a device supports burst reads.
+   *
+   * @param start_register address of first register
+   * @param buffer buffer for the register values
+   * @param length number of registers
+   */
+  virtual void ReadBlock(uint8_t start_register, uint8_t *buffer, std::size_t length)
+  {
+    for (std::size_t i = 0; i < length; i++)
+    {
+      buffer[i] = ReadByte(static_cast<uint8_t>(start_register + i));
+    }
+  }
+
+  /*!
+   * Getter for device address
+   * @return I2C address of device
+   */
+  virtual uint8_t GetDeviceAddress() const = 0;
+
+};
+
+#ifdef _LIB_WIRING_PI_PRESENT_
+//! SHORT_DESCRIPTION
+/*!
+ * I2C device on the Raspberry Pi bus.
+ */
+class tI2CDeviceRaspberryPi : public tI2CDevice
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * Constructor
+   * @param device_address I2C address of device
+   */
+  tI2CDeviceRaspberryPi(uint8_t device_address):
+    i2c_device_(device_address),
+    device_address_(device_address),
+    block_file_descriptor_(wiringPiI2CSetup(device_address))
+  {}
+
+  virtual ~tI2CDeviceRaspberryPi()
+  {
+    if (block_file_descriptor_ >= 0)
+    {
+      close(block_file_descriptor_);
+    }
+  }
+
+  virtual uint8_t ReadByte(uint8_t device_register) override
+  {
+    return i2c_device_.ReadByte(device_register);
+  }
+
+  virtual void WriteByte(uint8_t device_register, uint8_t value) override
+  {
+    i2c_device_.WriteByte(device_register, value);
+  }
+
+  /*!
+   * Reads consecutive registers in a single bus transaction
+   *
+   * Selects the start register and reads all bytes at once, the device increments the
+   * register address itself. Falls back to single reads if the transaction fails.
+   */
+  virtual void ReadBlock(uint8_t start_register, uint8_t *buffer, std::size_t length) override
+  {
+    if (block_file_descriptor_ >= 0 and
+        write(block_file_descriptor_, &start_register, 1) == 1 and
+        read(block_file_descriptor_, buffer, length) == static_cast<ssize_t>(length))
+    {
+      return;
+    }
+    tI2CDevice::ReadBlock(start_register, buffer, length);
+  }
+
+  virtual uint8_t GetDeviceAddress() const override
+  {
+    return device_address_;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  rrlib::gpio::tI2C i2c_device_;
+  uint8_t device_address_;
+  int block_file_descriptor_;
+
+};
+#endif
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -0,0 +1,340 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/shared/tJournal.cpp
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ */
+//----------------------------------------------------------------------
+#include "projects/smart_home/shared/tJournal.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/logging/messages.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <libgen.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace shared
+{
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+// block size for scanning the tail of a journal
+static constexpr std::size_t cRECOVERY_BLOCK_SIZE = 4096;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+tJournal::tJournal(std::size_t max_pending_size) :
+  file_descriptor_(-1),
+  max_pending_size_(max_pending_size),
+  first_entry_written_partially_(false),
+  commit_count_(0),
+  committed_bytes_(0),
+  dropped_count_(0),
+  failed_commit_count_(0),
+  last_error_log_time_(rrlib::time::cNO_TIME)
+{}
+
+tJournal::~tJournal()
+{
+  Close();
+}
+
+bool tJournal::Open(const std::string &filename, std::size_t record_size, const std::string &header)
+{
+  Close();
+
+  struct stat file_status;
+  bool created = stat(filename.c_str(), &file_status) != 0;
+  file_descriptor_ = open(filename.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+  if (file_descriptor_ < 0)
+  {
+    return false;
+  }
+
+  if (created)
+  {
+    // make the directory entry of a new file durable as well
+    std::vector<char> path(filename.begin(), filename.end());
+    path.push_back('\0');
+    int directory = open(dirname(path.data()), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (directory >= 0)
+    {
+      fsync(directory);
+      close(directory);
+    }
+  }
+  else
+  {
+    long removed = Recover(file_descriptor_, record_size, header.size());
+    if (removed > 0)
+    {
+      RRLIB_LOG_PRINT(WARNING, "Removed incomplete tail of ", removed, " bytes from journal ", filename);
+    }
+  }
+
+  if (not header.empty() and lseek(file_descriptor_, 0, SEEK_END) == 0)
+  {
+    Append(header.data(), header.size());
+    if (not Commit())
+    {
+      close(file_descriptor_);
+      file_descriptor_ = -1;
+      return false;
+    }
+  }
+  return true;
+}
+
+void tJournal::Close()
+{
+  if (IsOpen())
+  {
+    Commit();
+    close(file_descriptor_);
+    file_descriptor_ = -1;
+
+    // entries that could not be written are lost
+    dropped_count_ += pending_entries_.size();
+    pending_.clear();
+    pending_entries_.clear();
+    first_entry_written_partially_ = false;
+  }
+}
+
+void tJournal::Append(const char *data, std::size_t length)
+{
+  if (length > max_pending_size_)
+  {
+    dropped_count_++;
+    return;
+  }
+
+  // drop the oldest entries that have not been started to be written
+  std::size_t first = first_entry_written_partially_ ? 1 : 0;
+  std::size_t drop_begin = first ? pending_entries_.front() : 0;
+  std::size_t drop_end = drop_begin;
+  while (pending_.size() - (drop_end - drop_begin) + length > max_pending_size_ and pending_entries_.size() > first)
+  {
+    drop_end += pending_entries_[first];
+    pending_entries_.erase(pending_entries_.begin() + first);
+    dropped_count_++;
+  }
+  if (pending_.size() - (drop_end - drop_begin) + length > max_pending_size_)
+  {
+    dropped_count_++;
+    return;
+  }
+  pending_.erase(pending_.begin() + drop_begin, pending_.begin() + drop_end);
+
+  pending_.insert(pending_.end(), data, data + length);
+  pending_entries_.push_back(length);
+}
+
+bool tJournal::Commit()
+{
+  if (pending_.empty())
+  {
+    return true;
+  }
+  if (not IsOpen())
+  {
+    return false;
+  }
+
+  std::size_t written = 0;
+  bool write_failed = false;
+  while (written < pending_.size())
+  {
+    ssize_t result = write(file_descriptor_, pending_.data() + written, pending_.size() - written);
+    if (result < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      ReportError("Writing", errno);
+      write_failed = true;
+      break;
+    }
+    written += result;
+  }
+  pending_.erase(pending_.begin(), pending_.begin() + written);
+  committed_bytes_ += written;
+  for (std::size_t remaining = written; remaining > 0;)
+  {
+    std::size_t consumed = std::min(remaining, pending_entries_.front());
+    pending_entries_.front() -= consumed;
+    remaining -= consumed;
+    first_entry_written_partially_ = pending_entries_.front() > 0;
+    if (pending_entries_.front() == 0)
+    {
+      pending_entries_.pop_front();
+    }
+  }
+
+  if (fdatasync(file_descriptor_) != 0)
+  {
+    if (not write_failed)
+    {
+      ReportError("Syncing", errno);
+    }
+    return false;
+  }
+  commit_count_++;
+  if (write_failed)
+  {
+    return false;
+  }
+  if (failed_commit_count_ > 0)
+  {
+    RRLIB_LOG_PRINT(WARNING, "Journal written again after ", failed_commit_count_, " failed commits (", dropped_count_, " entries dropped in total).");
+    failed_commit_count_ = 0;
+    last_error_log_time_ = rrlib::time::cNO_TIME;
+  }
+  return true;
+}
+
+void tJournal::ReportError(const char *operation, int error)
+{
+  failed_commit_count_++;
+  auto now = rrlib::time::Now();
+  if (last_error_log_time_ == rrlib::time::cNO_TIME or now - last_error_log_time_ >= cJOURNAL_ERROR_LOG_INTERVAL)
+  {
+    RRLIB_LOG_PRINT(ERROR, operation, " journal failed: ", std::strerror(error), " (", failed_commit_count_, " failed commits, ", dropped_count_, " entries dropped in total).");
+    last_error_log_time_ = now;
+  }
+}
+
+long tJournal::Recover(int file_descriptor, std::size_t record_size, std::size_t header_size)
+{
+  off_t size = lseek(file_descriptor, 0, SEEK_END);
+  if (size < 0)
+  {
+    return -1;
+  }
+
+  // blocks of a torn commit may be stored out of order, leaving zero filled gaps:
+  // text journals are valid up to the last '\n' before the first zero byte,
+  // binary journals up to the first complete record before the first all zero record
+  off_t valid = 0;
+  off_t position = 0;
+  std::vector<char> block(record_size > 0 ? std::max<std::size_t>(1, cRECOVERY_BLOCK_SIZE / record_size) * record_size : cRECOVERY_BLOCK_SIZE);
+  if (record_size > 0)
+  {
+    if (size < static_cast<off_t>(header_size))
+    {
+      position = size;
+    }
+    else
+    {
+      valid = header_size;
+      position = header_size;
+    }
+  }
+  while (position < size)
+  {
+    ssize_t length = pread(file_descriptor, block.data(), block.size(), position);
+    if (length <= 0)
+    {
+      return -1;
+    }
+    if (record_size > 0)
+    {
+      bool complete = true;
+      for (ssize_t offset = 0; offset < length and complete; offset += record_size)
+      {
+        const char *record = block.data() + offset;
+        complete = offset + static_cast<ssize_t>(record_size) <= length
+                   and std::any_of(record, record + record_size, [](char c)
+        {
+          return c != '\0';
+        });
+        if (complete)
+        {
+          valid = position + offset + record_size;
+        }
+      }
+      if (not complete)
+      {
+        break;
+      }
+      position += length;
+      continue;
+    }
+
+    const char *zero = static_cast<const char *>(std::memchr(block.data(), '\0', length));
+    ssize_t scan_length = zero ? zero - block.data() : length;
+    for (ssize_t i = 0; i < scan_length; i++)
+    {
+      if (block[i] == '\n')
+      {
+        valid = position + i + 1;
+      }
+    }
+    if (zero)
+    {
+      break;
+    }
+    position += length;
+  }
+
+  if (valid == size)
+  {
+    return 0;
+  }
+  if (ftruncate(file_descriptor, valid) != 0 or fdatasync(file_descriptor) != 0)
+  {
+    return -1;
+  }
+  return size - valid;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
@@ -0,0 +1,219 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/shared/tJournal.h
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tJournal
+ *
+ * \b tJournal
+ *
+ * Append-only journal of lines or fixed size records with group commit.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __projects__smart_home__shared__tJournal_h__
+#define __projects__smart_home__shared__tJournal_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/time/time.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace shared
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+// default limit of the pending entries kept while commits fail
+static constexpr std::size_t cJOURNAL_DEFAULT_MAX_PENDING_SIZE = 1024 * 1024;
+
+// minimum time between two error messages of failing commits
+static const rrlib::time::tDuration cJOURNAL_ERROR_LOG_INTERVAL = std::chrono::minutes(1);
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! SHORT_DESCRIPTION
+/*!
+ * Append-only journal of lines or fixed size records with group commit.
+ *
+ * Appended entries are collected in memory and written to the file with a single write and
+ * fdatasync per Commit, so the storage sees few, large writes instead of one per entry.
+ * Committed entries are never rewritten. A power loss during a commit can only leave an
+ * incomplete last entry or zero filled blocks, which Open removes before appending.
+ * Text journals consist of lines without '\0'; binary journals of a header followed by
+ * records of a fixed size that are never all zero.
+ *
+ * If the file cannot be written (e.g. the device is full), entries stay pending up to a
+ * maximum size; beyond it, the oldest entries are dropped and counted. Errors are logged
+ * at most once per cJOURNAL_ERROR_LOG_INTERVAL.
+ * Not thread safe.
+ */
+class tJournal
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * @param max_pending_size maximum number of pending bytes (older entries are dropped)
+   */
+  explicit tJournal(std::size_t max_pending_size = cJOURNAL_DEFAULT_MAX_PENDING_SIZE);
+
+  /*!
+   * Commits pending lines and closes the file
+   */
+  ~tJournal();
+
+  /*!
+   * Opens a file for appending, removing an incomplete tail of a previous run
+   * @param filename file name
+   * @param record_size size of the records of a binary journal (0 for a text journal)
+   * @param header header of a binary journal, written if the file is empty (an existing header is kept)
+   * @return true, if the file was opened
+   */
+  bool Open(const std::string &filename, std::size_t record_size = 0, const std::string &header = std::string());
+
+  /*!
+   * Commits pending lines and closes the file
+   */
+  void Close();
+
+  inline bool IsOpen() const
+  {
+    return file_descriptor_ >= 0;
+  }
+
+  /*!
+   * Adds an entry to the pending batch (no I/O), dropping the oldest entries beyond the maximum pending size
+   * @param data line including the terminating '\n' or record
+   * @param length length of data
+   */
+  void Append(const char *data, std::size_t length);
+
+  /*!
+   * Writes the pending batch and waits until it is stored on the device
+   * @return true, if the batch is durable (also if nothing was pending)
+   */
+  bool Commit();
+
+  /*!
+   * Number of bytes appended, but not committed yet
+   */
+  inline std::size_t GetPendingSize() const
+  {
+    return pending_.size();
+  }
+
+  inline uint64_t GetCommitCount() const
+  {
+    return commit_count_;
+  }
+
+  inline uint64_t GetCommittedBytes() const
+  {
+    return committed_bytes_;
+  }
+
+  /*!
+   * Number of entries dropped because the pending batch exceeded its maximum size
+   */
+  inline uint64_t GetDroppedCount() const
+  {
+    return dropped_count_;
+  }
+
+  /*!
+   * Removes an incomplete tail (torn last entry or zero filled blocks) of a journal file
+   * @param file_descriptor file opened for reading and writing
+   * @param record_size size of the records of a binary journal (0 for a text journal)
+   * @param header_size size of the header of a binary journal
+   * @return number of bytes removed or -1 on error
+   */
+  static long Recover(int file_descriptor, std::size_t record_size = 0, std::size_t header_size = 0);
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  int file_descriptor_;
+  const std::size_t max_pending_size_;
+  std::vector<char> pending_;
+
+  // sizes of the pending entries (the first one may be partially written)
+  std::deque<std::size_t> pending_entries_;
+  bool first_entry_written_partially_;
+
+  uint64_t commit_count_;
+  uint64_t committed_bytes_;
+  uint64_t dropped_count_;
+
+  // failed commits since the last successful one
+  uint64_t failed_commit_count_;
+  rrlib::time::tTimestamp last_error_log_time_;
+
+  /*!
+   * Counts a failed commit and logs it (rate limited)
+   * @param operation failed operation
+   * @param error errno of the operation
+   */
+  void ReportError(const char *operation, int error);
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -41,6 +41,8 @@
 //----------------------------------------------------------------------
 #include "rrlib/si_units/si_units.h"
 
+#include <cstdint>
+
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
@@ -59,6 +61,7 @@ namespace shared
 // Forward declarations / typedefs / enums
 //----------------------------------------------------------------------
 static const unsigned short cMCP3008_RESOLUTION = 1024;
+static const unsigned int cMCP3008_MAX_OVERSAMPLING_BITS = 6;
 
 //----------------------------------------------------------------------
 // Class declaration
@@ -124,6 +127,27 @@ public:
     return reference_voltage_ * ratio;
   }
 
+  /*!
+   * Converts a decimated sum of oversampled MCP3008 outputs to a voltage
+   *
+   * 4^extra_bits summed 10 bit values shifted right by extra_bits give a value with
+   * 10 + extra_bits bit resolution.
+   *
+   * @param decimated_value decimated value (0 to 1023 * 2^extra_bits)
+   * @param extra_bits number of additional bits gained by oversampling
+   * @return voltage
+   */
+  inline rrlib::si_units::tVoltage<double> ConvertDecimatedValueToVoltage(uint32_t decimated_value, unsigned int extra_bits) const
+  {
+    uint32_t maximum = static_cast<uint32_t>(cMCP3008_RESOLUTION - 1) << extra_bits;
+    if (decimated_value > maximum)
+    {
+      return reference_voltage_;
+    }
+    double ratio = static_cast<double>(decimated_value) / static_cast<double>(maximum);
+    return reference_voltage_ * ratio;
+  }
+
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
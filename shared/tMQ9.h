@@ -19,28 +19,31 @@
 // 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 //
 //----------------------------------------------------------------------
-/*!\file    projects/smart_home/heat_control/tPT.h
+/*!\file    projects/smart_home/shared/tMQ9.h
  *
  * \author  Patrick Wolf
  *
  * \date    2015-05-07
  *
- * \brief   Contains tPT.h
+ * \brief   Contains tMQ9.h
  *
- * \b tPT.h
+ * \b tMQ9.h
  *
- * Class which calculates the temperature measured by a pt1000 resistor, based on measured voltage.
+ * Class which calculates gas concentrations measured by a MQ9 sensor, based on its resistance.
  *
  */
 //----------------------------------------------------------------------
-#ifndef __projects__smart_home__heat_control__tPT_h__
-#define __projects__smart_home__heat_control__tPT_h__
+#ifndef __projects__smart_home__shared__tMQ9_h__
+#define __projects__smart_home__shared__tMQ9_h__
 
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
 #include "rrlib/si_units/si_units.h"
 
+#include <array>
+#include <cmath>
+
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
@@ -58,81 +61,135 @@ namespace shared
 //----------------------------------------------------------------------
 // Forward declarations / typedefs / enums
 //----------------------------------------------------------------------
+enum class tMQ9Gas
+{
+  eCARBON_MONOXIDE,
+  eMETHANE,
+  eCOUNT
+};
+
+//! Point of a characteristic curve (concentration in ppm, sensor resistance ratio Rs / R0)
+struct tMQ9CurvePoint
+{
+  double concentration;
+  double ratio;
+};
 
-// factors according to DIN EN 60751
-static constexpr double cPT_A(3.90802 * 1E-3);
-static constexpr double cPT_B(-5.801 * 1E-7);
-static constexpr double cPT_C(-4.735 * 1E-12);
+// ratio Rs / R0 in clean air according to the data sheet
+static constexpr double cMQ9_CLEAN_AIR_RATIO = 9.6;
 
-static constexpr rrlib::si_units::tCelsius<double> cPT_TEMP_THRESHOLD_LOW(-200.0);
-static constexpr rrlib::si_units::tCelsius<double> cPT_TEMP_THRESHOLD_HIGH(850.0);
-static constexpr rrlib::si_units::tCelsius<double> cPT_TEMP_ZERO(0.0);
+// characteristic curves read from the data sheet (sorted by concentration)
+static constexpr std::array<tMQ9CurvePoint, 5> cMQ9_CURVE_CARBON_MONOXIDE {{
+    {100.0, 2.22}, {200.0, 1.63}, {500.0, 1.08}, {1000.0, 0.80}, {2000.0, 0.59}
+  }
+};
+static constexpr std::array<tMQ9CurvePoint, 6> cMQ9_CURVE_METHANE {{
+    {200.0, 3.18}, {500.0, 2.25}, {1000.0, 1.73}, {2000.0, 1.33}, {5000.0, 0.94}, {10000.0, 0.73}
+  }
+};
+
+// range of ratio Rs / R0 covered by the concentration tables
+static constexpr double cMQ9_TABLE_MIN_RATIO = 0.3;
+static constexpr double cMQ9_TABLE_MAX_RATIO = 10.0;
+static constexpr std::size_t cMQ9_TABLE_SIZE = 1024;
 
 //----------------------------------------------------------------------
 // Class declaration
 //----------------------------------------------------------------------
 //! SHORT_DESCRIPTION
 /*!
- * Class which calculates the temperature measured by a pt1000 resistor, based on measured voltage.
+ * Class which calculates gas concentrations measured by a MQ9 sensor, based on its resistance.
+ *
+ * The characteristic curves are straight lines in log-log scale between the points of the data
+ * sheet (and extended beyond the first and last point). They are sampled once into tables which
+ * are uniform in Rs / R0, so a conversion is a linear interpolation without any logarithm.
  */
-template<int TResistance>
-class tPT
+class tMQ9
 {
-public:
-  int cRESISTANCE = TResistance;
-  rrlib::si_units::tElectricResistance<double> cR_0 = static_cast<rrlib::si_units::tElectricResistance<double>>(TResistance);
 
 //----------------------------------------------------------------------
 // Public methods and typedefs
 //----------------------------------------------------------------------
 public:
 
-  tPT() {};
+  tMQ9()
+  {
+    BuildTable(cMQ9_CURVE_CARBON_MONOXIDE, tables_[static_cast<std::size_t>(tMQ9Gas::eCARBON_MONOXIDE)]);
+    BuildTable(cMQ9_CURVE_METHANE, tables_[static_cast<std::size_t>(tMQ9Gas::eMETHANE)]);
+  }
 
-  ~tPT() {};
+  ~tMQ9() {};
 
   /*!
-   * Determines a temperature estimate based on the current resistance
-   * @param resistance sensor resistance
-   * @return temperature estimate
+   * Determines resistance value of MQ9 sensor
+   * @param voltage A/D voltage over the load resistance
+   * @param reference_voltage reference voltage of A/D converter
+   * @param pre_resistance load resistance of MQ9 sensor
+   * @return resistance
    */
-  inline rrlib::si_units::tCelsius<double> GetTemperature(const rrlib::si_units::tElectricResistance<double> & resistance) const
+  static inline rrlib::si_units::tElectricResistance<double> GetResistance(
+    const rrlib::si_units::tVoltage<double> & voltage,
+    const rrlib::si_units::tVoltage<double> & reference_voltage,
+    const rrlib::si_units::tElectricResistance<double> & pre_resistance)
   {
-    if (resistance.Value() > 0.0)
-    {
-      return rrlib::si_units::tCelsius<double>((-cPT_A * cR_0.Value() + std::sqrt(std::pow(cPT_A * cR_0.Value(), 2) - 4.0 * cPT_B * cR_0.Value() * (cR_0 - resistance).Value())) / (2 * cPT_B * cR_0.Value()));
-    }
-    else
+    if (voltage.Value() == 0)
     {
-      return rrlib::si_units::tCelsius<double>(0);
+      return pre_resistance;
     }
+
+    return pre_resistance * ((reference_voltage / voltage).Value() - 1.0);
   }
 
   /*!
-   * Determines resistance based on the temperature
-   * @param temperature temperature
-   * @return resistance
+   * Determines a concentration estimate based on the resistance ratio
+   *
+   * Ratios outside of the table range are clamped to its ends.
+   *
+   * @param gas gas to estimate
+   * @param ratio sensor resistance divided by clean air resistance (Rs / R0)
+   * @return concentration in ppm
    */
-  inline rrlib::si_units::tElectricResistance<double> GetResistance(const rrlib::si_units::tCelsius<double> & temperature) const
+  inline double GetConcentration(tMQ9Gas gas, double ratio) const
   {
-    double t = temperature.ValueFactored();
-
-    if (temperature < cPT_TEMP_THRESHOLD_LOW)
+    const auto & table = tables_[static_cast<std::size_t>(gas)];
+    double index = (ratio - cMQ9_TABLE_MIN_RATIO) * cINDEX_SCALE;
+    if (not(index > 0.0))
     {
-      return rrlib::si_units::tElectricResistance<double>(0.0);
+      return table.front();
     }
-    else if (temperature < cPT_TEMP_ZERO)
+    if (index >= static_cast<double>(cMQ9_TABLE_SIZE - 1))
     {
-      return cR_0 * (1.0 + cPT_A * t + cPT_B * std::pow(t, 2) + cPT_C * (t - 100.0) * std::pow(t, 3));
+      return table.back();
     }
-    else if (temperature < cPT_TEMP_THRESHOLD_HIGH)
-    {
-      return cR_0 * (1.0 + cPT_A * t + cPT_B * std::pow(t, 2));
-    }
-    else
+
+    std::size_t lower = static_cast<std::size_t>(index);
+    double fraction = index - static_cast<double>(lower);
+    return table[lower] + fraction * (table[lower + 1] - table[lower]);
+  }
+
+  /*!
+   * Determines a concentration by interpolating the characteristic curve in log-log scale
+   *
+   * Reference for the tables, requires logarithms on each call.
+   *
+   * @param curve characteristic curve
+   * @param ratio sensor resistance divided by clean air resistance (Rs / R0)
+   * @return concentration in ppm
+   */
+  template<std::size_t Tpoints>
+  static double InterpolateCurve(const std::array<tMQ9CurvePoint, Tpoints> & curve, double ratio)
+  {
+    // ratio decreases with concentration, pick the segment containing ratio or the outermost one
+    std::size_t segment = 0;
+    while (segment + 2 < Tpoints and ratio < curve[segment + 1].ratio)
     {
-      return rrlib::si_units::tElectricResistance<double>(0.0);
+      segment++;
     }
+
+    const auto & a = curve[segment];
+    const auto & b = curve[segment + 1];
+    double slope = std::log(b.concentration / a.concentration) / std::log(b.ratio / a.ratio);
+    return a.concentration * std::exp(slope * std::log(ratio / a.ratio));
   }
 
 //----------------------------------------------------------------------
@@ -140,12 +197,20 @@ public:
 //----------------------------------------------------------------------
 private:
 
+  static constexpr double cINDEX_SCALE = (cMQ9_TABLE_SIZE - 1) / (cMQ9_TABLE_MAX_RATIO - cMQ9_TABLE_MIN_RATIO);
 
-};
+  std::array<std::array<double, cMQ9_TABLE_SIZE>, static_cast<std::size_t>(tMQ9Gas::eCOUNT)> tables_;
 
-using tPT1000 = tPT<1000>;
-using tPT500 = tPT<500>;
-using tPT100 = tPT<100>;
+  template<std::size_t Tpoints>
+  static void BuildTable(const std::array<tMQ9CurvePoint, Tpoints> & curve, std::array<double, cMQ9_TABLE_SIZE> & table)
+  {
+    for (std::size_t i = 0; i < cMQ9_TABLE_SIZE; i++)
+    {
+      table[i] = InterpolateCurve(curve, cMQ9_TABLE_MIN_RATIO + i / cINDEX_SCALE);
+    }
+  }
+
+};
 
 //----------------------------------------------------------------------
 // End of namespace declaration
@@ -41,6 +41,14 @@
 //----------------------------------------------------------------------
 #include "rrlib/si_units/si_units.h"
 
+#include <cstddef>
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
@@ -135,11 +143,158 @@ public:
     }
   }
 
+  /*!
+   * Determines temperature estimates for a contiguous array of resistances
+   *
+   * Results are bit-identical to calling GetTemperature for each value. Uses AVX, SSE2 or
+   * NEON (AArch64) if available and falls back to scalar code otherwise.
+   *
+   * @param resistances sensor resistances in Ohm
+   * @param temperatures output array for temperatures in degree Celsius (may alias resistances)
+   * @param count number of values
+   */
+  inline void GetTemperatures(const double *resistances, double *temperatures, std::size_t count) const
+  {
+    const double r0 = cR_0.Value();
+    const double offset = -cPT_A * r0;
+    const double square = std::pow(cPT_A * r0, 2);
+    const double factor = 4.0 * cPT_B * r0;
+    const double divisor = 2 * cPT_B * r0;
+    std::size_t i = 0;
+
+#if defined(__AVX__)
+    const __m256d v_r0 = _mm256_set1_pd(r0);
+    const __m256d v_offset = _mm256_set1_pd(offset);
+    const __m256d v_square = _mm256_set1_pd(square);
+    const __m256d v_factor = _mm256_set1_pd(factor);
+    const __m256d v_divisor = _mm256_set1_pd(divisor);
+    const __m256d v_zero = _mm256_setzero_pd();
+    for (; i + 4 <= count; i += 4)
+    {
+      __m256d r = _mm256_loadu_pd(resistances + i);
+      __m256d root = _mm256_sqrt_pd(_mm256_sub_pd(v_square, _mm256_mul_pd(v_factor, _mm256_sub_pd(v_r0, r))));
+      __m256d t = _mm256_div_pd(_mm256_add_pd(v_offset, root), v_divisor);
+      _mm256_storeu_pd(temperatures + i, _mm256_and_pd(t, _mm256_cmp_pd(r, v_zero, _CMP_GT_OQ)));
+    }
+#elif defined(__SSE2__)
+    const __m128d v_r0 = _mm_set1_pd(r0);
+    const __m128d v_offset = _mm_set1_pd(offset);
+    const __m128d v_square = _mm_set1_pd(square);
+    const __m128d v_factor = _mm_set1_pd(factor);
+    const __m128d v_divisor = _mm_set1_pd(divisor);
+    const __m128d v_zero = _mm_setzero_pd();
+    for (; i + 2 <= count; i += 2)
+    {
+      __m128d r = _mm_loadu_pd(resistances + i);
+      __m128d root = _mm_sqrt_pd(_mm_sub_pd(v_square, _mm_mul_pd(v_factor, _mm_sub_pd(v_r0, r))));
+      __m128d t = _mm_div_pd(_mm_add_pd(v_offset, root), v_divisor);
+      _mm_storeu_pd(temperatures + i, _mm_and_pd(t, _mm_cmpgt_pd(r, v_zero)));
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const float64x2_t v_r0 = vdupq_n_f64(r0);
+    const float64x2_t v_offset = vdupq_n_f64(offset);
+    const float64x2_t v_square = vdupq_n_f64(square);
+    const float64x2_t v_factor = vdupq_n_f64(factor);
+    const float64x2_t v_divisor = vdupq_n_f64(divisor);
+    const float64x2_t v_zero = vdupq_n_f64(0.0);
+    for (; i + 2 <= count; i += 2)
+    {
+      float64x2_t r = vld1q_f64(resistances + i);
+      float64x2_t root = vsqrtq_f64(vsubq_f64(v_square, vmulq_f64(v_factor, vsubq_f64(v_r0, r))));
+      float64x2_t t = vdivq_f64(vaddq_f64(v_offset, root), v_divisor);
+      vst1q_f64(temperatures + i, vbslq_f64(vcgtq_f64(r, v_zero), t, v_zero));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+      temperatures[i] = GetTemperature(rrlib::si_units::tElectricResistance<double>(resistances[i])).ValueFactored();
+    }
+  }
+
+  /*!
+   * Determines resistances for a contiguous array of temperatures
+   *
+   * Results are bit-identical to calling GetResistance for each value. Temperatures between
+   * 0 and 850 degree Celsius are computed with AVX, SSE2 or NEON (AArch64) if available,
+   * all other values use the scalar code.
+   *
+   * @param temperatures temperatures in degree Celsius
+   * @param resistances output array for resistances in Ohm (must not overlap with temperatures)
+   * @param count number of values
+   */
+  inline void GetResistances(const double *temperatures, double *resistances, std::size_t count) const
+  {
+    const double r0 = cR_0.Value();
+    std::size_t i = 0;
+
+#if defined(__AVX__)
+    const __m256d v_r0 = _mm256_set1_pd(r0);
+    const __m256d v_one = _mm256_set1_pd(1.0);
+    const __m256d v_a = _mm256_set1_pd(cPT_A);
+    const __m256d v_b = _mm256_set1_pd(cPT_B);
+    for (; i + 4 <= count; i += 4)
+    {
+      __m256d t = _mm256_loadu_pd(temperatures + i);
+      __m256d polynomial = _mm256_add_pd(_mm256_add_pd(v_one, _mm256_mul_pd(v_a, t)), _mm256_mul_pd(v_b, _mm256_mul_pd(t, t)));
+      _mm256_storeu_pd(resistances + i, _mm256_mul_pd(v_r0, polynomial));
+      FixResistancesOutOfPositiveRange(temperatures, resistances, i, 4);
+    }
+#elif defined(__SSE2__)
+    const __m128d v_r0 = _mm_set1_pd(r0);
+    const __m128d v_one = _mm_set1_pd(1.0);
+    const __m128d v_a = _mm_set1_pd(cPT_A);
+    const __m128d v_b = _mm_set1_pd(cPT_B);
+    for (; i + 2 <= count; i += 2)
+    {
+      __m128d t = _mm_loadu_pd(temperatures + i);
+      __m128d polynomial = _mm_add_pd(_mm_add_pd(v_one, _mm_mul_pd(v_a, t)), _mm_mul_pd(v_b, _mm_mul_pd(t, t)));
+      _mm_storeu_pd(resistances + i, _mm_mul_pd(v_r0, polynomial));
+      FixResistancesOutOfPositiveRange(temperatures, resistances, i, 2);
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const float64x2_t v_r0 = vdupq_n_f64(r0);
+    const float64x2_t v_one = vdupq_n_f64(1.0);
+    const float64x2_t v_a = vdupq_n_f64(cPT_A);
+    const float64x2_t v_b = vdupq_n_f64(cPT_B);
+    for (; i + 2 <= count; i += 2)
+    {
+      float64x2_t t = vld1q_f64(temperatures + i);
+      float64x2_t polynomial = vaddq_f64(vaddq_f64(v_one, vmulq_f64(v_a, t)), vmulq_f64(v_b, vmulq_f64(t, t)));
+      vst1q_f64(resistances + i, vmulq_f64(v_r0, polynomial));
+      FixResistancesOutOfPositiveRange(temperatures, resistances, i, 2);
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+      resistances[i] = GetResistance(rrlib::si_units::tCelsius<double>(temperatures[i])).Value();
+    }
+  }
+
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
 private:
 
+  /*!
+   * Replaces vector results for temperatures outside of [0, 850) by the scalar computation
+   * @param temperatures temperatures of the block
+   * @param resistances resistances of the block
+   * @param first index of the first value of the block
+   * @param block_size number of values in the block
+   */
+  inline void FixResistancesOutOfPositiveRange(const double *temperatures, double *resistances, std::size_t first, std::size_t block_size) const
+  {
+    for (std::size_t i = first; i < first + block_size; i++)
+    {
+      // negated comparison also catches NaN
+      if (not(temperatures[i] >= cPT_TEMP_ZERO.ValueFactored() and temperatures[i] < cPT_TEMP_THRESHOLD_HIGH.ValueFactored()))
+      {
+        resistances[i] = GetResistance(rrlib::si_units::tCelsius<double>(temperatures[i])).Value();
+      }
+    }
+  }
 
 };
 
@@ -0,0 +1,204 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/shared/tPTLookupTable.h
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tPTLookupTable.h
+ *
+ * \b tPTLookupTable.h
+ *
+ * Precomputed conversion table from MCP3008 output codes to PT sensor temperatures.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __projects__smart_home__shared__tPTLookupTable_h__
+#define __projects__smart_home__shared__tPTLookupTable_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/si_units/si_units.h"
+
+#include <array>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "projects/smart_home/shared/tMCP3008.h"
+#include "projects/smart_home/shared/tPT.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace shared
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! SHORT_DESCRIPTION
+/*!
+ * Precomputed conversion table from MCP3008 output codes to PT sensor temperatures.
+ * The table holds one entry per A/D code and has to be rebuilt whenever the
+ * sensor type, the pre resistance or the reference voltage of the voltage divider changes.
+ */
+class tPTLookupTable
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  tPTLookupTable():
+    index_scale_(0.0)
+  {
+    temperatures_.fill(0.0);
+  }
+
+  ~tPTLookupTable() {};
+
+  /*!
+   * Determines resistance value of PT sensor within the voltage divider
+   * @param voltage_adc A/D voltage
+   * @param voltage_ref reference voltage of A/D converter
+   * @param resistance_pre pre resistance of PT sensor
+   * @return resistance
+   */
+  static inline rrlib::si_units::tElectricResistance<double> GetResistance(
+    const rrlib::si_units::tVoltage<double> & voltage_adc,
+    const rrlib::si_units::tVoltage<double> & voltage_ref,
+    const rrlib::si_units::tElectricResistance<double> & resistance_pre)
+  {
+    /*
+     * _____ V_ref
+     *   |
+     *  [ ] R_pre
+     *   |____ V_adc
+     *   |
+     *  [ ] R_pt
+     * __|__
+     *        V_gnd
+     *
+     * R_pre / (V_ref - V_adc) = R_pt / (V_adc - V_gnf)
+     *
+     */
+    if (voltage_adc >= voltage_ref)
+    {
+      return resistance_pre;
+    }
+
+    return resistance_pre * voltage_adc / (voltage_ref - voltage_adc);
+  }
+
+  /*!
+   * Recomputes all table entries for a PT sensor with nominal resistance TResistance
+   * @param resistance_pre pre resistance of PT sensor
+   * @param voltage_ref reference voltage of A/D converter
+   */
+  template<int TResistance>
+  void Rebuild(const rrlib::si_units::tElectricResistance<double> & resistance_pre,
+               const rrlib::si_units::tVoltage<double> & voltage_ref)
+  {
+    tMCP3008 mcp3008(voltage_ref);
+    tPT<TResistance> pt;
+    for (unsigned short i = 0; i < cMCP3008_RESOLUTION; i++)
+    {
+      auto voltage = mcp3008.ConvertADValueToVoltage(i);
+      temperatures_[i] = pt.GetTemperature(GetResistance(voltage, voltage_ref, resistance_pre)).ValueFactored();
+    }
+    index_scale_ = (voltage_ref.Value() > 0.0) ? static_cast<double>(cMCP3008_RESOLUTION - 1) / voltage_ref.Value() : 0.0;
+  }
+
+  /*!
+   * Looks up the temperature of an A/D code
+   * @param ad_value value of MCP3008 output
+   * @return temperature estimate (NaN if the code is outside of the sensor range)
+   */
+  inline rrlib::si_units::tCelsius<double> GetTemperature(unsigned short ad_value) const
+  {
+    if (ad_value >= cMCP3008_RESOLUTION)
+    {
+      ad_value = cMCP3008_RESOLUTION - 1;
+    }
+    return rrlib::si_units::tCelsius<double>(temperatures_[ad_value]);
+  }
+
+  /*!
+   * Looks up the temperature of an A/D voltage
+   *
+   * Voltages between two codes (e.g. from oversampling) are linearly interpolated.
+   *
+   * @param voltage_adc A/D voltage
+   * @return temperature estimate (NaN if the voltage is outside of the sensor range)
+   */
+  inline rrlib::si_units::tCelsius<double> GetTemperature(const rrlib::si_units::tVoltage<double> & voltage_adc) const
+  {
+    double index = voltage_adc.Value() * index_scale_;
+    if (index <= 0.0)
+    {
+      return rrlib::si_units::tCelsius<double>(temperatures_.front());
+    }
+    if (index >= static_cast<double>(cMCP3008_RESOLUTION - 1))
+    {
+      return rrlib::si_units::tCelsius<double>(temperatures_.back());
+    }
+
+    std::size_t lower = static_cast<std::size_t>(index);
+    double fraction = index - static_cast<double>(lower);
+    if (fraction == 0.0)
+    {
+      return rrlib::si_units::tCelsius<double>(temperatures_[lower]);
+    }
+    return rrlib::si_units::tCelsius<double>(temperatures_[lower] + fraction * (temperatures_[lower + 1] - temperatures_[lower]));
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  std::array<double, cMCP3008_RESOLUTION> temperatures_;
+  double index_scale_;
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
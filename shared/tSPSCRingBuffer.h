@@ -0,0 +1,185 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/shared/tSPSCRingBuffer.h
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tSPSCRingBuffer.h
+ *
+ * \b tSPSCRingBuffer.h
+ *
+ * Lock-free ring buffer for exactly one producer and one consumer thread.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __projects__smart_home__shared__tSPSCRingBuffer_h__
+#define __projects__smart_home__shared__tSPSCRingBuffer_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace shared
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! SHORT_DESCRIPTION
+/*!
+ * Lock-free ring buffer for exactly one producer and one consumer thread.
+ *
+ * Elements are written and read in place: the producer fills the slot returned by Reserve
+ * and makes it visible with Commit, the consumer reads the slot returned by Front and
+ * releases it with Pop. Neither side ever blocks; a full buffer is reported by Reserve.
+ * The capacity is rounded up to a power of two.
+ */
+template<typename T>
+class tSPSCRingBuffer
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * Constructor
+   * @param capacity minimum number of elements
+   */
+  explicit tSPSCRingBuffer(std::size_t capacity):
+    slots_(RoundUpToPowerOfTwo(capacity)),
+    mask_(slots_.size() - 1),
+    head_(0),
+    tail_(0)
+  {}
+
+  /*!
+   * (Producer) Slot for the next element
+   * @return slot or nullptr, if the buffer is full
+   */
+  inline T *Reserve()
+  {
+    std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) == slots_.size())
+    {
+      return nullptr;
+    }
+    return &slots_[head & mask_];
+  }
+
+  /*!
+   * (Producer) Makes the element in the slot of the last Reserve available to the consumer
+   */
+  inline void Commit()
+  {
+    head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  /*!
+   * (Consumer) Oldest element
+   * @return element or nullptr, if the buffer is empty
+   */
+  inline const T *Front() const
+  {
+    std::size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail == head_.load(std::memory_order_acquire))
+    {
+      return nullptr;
+    }
+    return &slots_[tail & mask_];
+  }
+
+  /*!
+   * (Consumer) Releases the slot of the oldest element
+   */
+  inline void Pop()
+  {
+    tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  /*!
+   * Number of elements (exact only if called by producer or consumer while the other side is idle)
+   */
+  inline std::size_t Size() const
+  {
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+  }
+
+  inline std::size_t Capacity() const
+  {
+    return slots_.size();
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  std::vector<T> slots_;
+  const std::size_t mask_;
+
+  // written by producer and consumer respectively, on separate cache lines
+  alignas(64) std::atomic<std::size_t> head_;
+  alignas(64) std::atomic<std::size_t> tail_;
+
+  static std::size_t RoundUpToPowerOfTwo(std::size_t value)
+  {
+    std::size_t result = 1;
+    while (result < value)
+    {
+      result <<= 1;
+    }
+    return result;
+  }
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
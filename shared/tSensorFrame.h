@@ -0,0 +1,362 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/shared/tSensorFrame.h
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tSensorFrame.h
+ *
+ * \b tSensorFrame.h
+ *
+ * Snapshot of all temperature readings of the heating within one cache line.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __projects__smart_home__shared__tSensorFrame_h__
+#define __projects__smart_home__shared__tSensorFrame_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/serialization/serialization.h"
+#include "rrlib/si_units/si_units.h"
+#include "rrlib/time/time.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "projects/smart_home/shared/tTemperatures.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace shared
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//! Temperature sensors of a frame (order of heat_control::tTemperatureSensors, then external room sensor)
+enum tSensor
+{
+  eSENSOR_BOILER_BOTTOM = 0,
+  eSENSOR_BOILER_MIDDLE,
+  eSENSOR_BOILER_TOP,
+  eSENSOR_FURNACE,
+  eSENSOR_GARAGE,
+  eSENSOR_GROUND,
+  eSENSOR_ROOM,
+  eSENSOR_SOLAR,
+  eSENSOR_ROOM_EXTERNAL,
+  eSENSOR_FRAME_COUNT
+};
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//! Stored value of a missing reading
+static constexpr int16_t cSENSOR_FRAME_NO_READING = INT16_MIN;
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! SHORT_DESCRIPTION
+/*!
+ * Snapshot of all temperature readings of the heating within one cache line.
+ *
+ * Temperatures are stored in centi degree Celsius (-327.67 to 327.67 degree Celsius),
+ * the timestamp in nanoseconds since the epoch of rrlib::time. Valid, outdated and implausible
+ * flags are bit masks with one bit per tSensor. The frame is trivially copyable and is
+ * published as a single port value.
+ */
+class alignas(64) tSensorFrame
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  tSensorFrame():
+    timestamp_(0),
+    room_set_point_(2000),
+    valid_(0),
+    outdated_(0),
+    implausible_(0)
+  {
+    temperature_.fill(cSENSOR_FRAME_NO_READING);
+  }
+
+  /*!
+   * Getter for the time of the snapshot
+   * @return timestamp
+   */
+  inline rrlib::time::tTimestamp GetTimestamp() const
+  {
+    return rrlib::time::tTimestamp(std::chrono::duration_cast<rrlib::time::tTimestamp::duration>(std::chrono::nanoseconds(timestamp_)));
+  }
+
+  /*!
+   * Setter for the time of the snapshot
+   * @param timestamp timestamp
+   */
+  inline void SetTimestamp(const rrlib::time::tTimestamp & timestamp)
+  {
+    timestamp_ = std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count();
+  }
+
+  /*!
+   * Getter for a temperature
+   * @param sensor sensor
+   * @return temperature (NaN if there is no reading)
+   */
+  inline rrlib::si_units::tCelsius<double> GetTemperature(tSensor sensor) const
+  {
+    return rrlib::si_units::tCelsius<double>(ToDegree(temperature_[sensor]));
+  }
+
+  /*!
+   * Getter for the stored value of a temperature
+   * @param sensor sensor
+   * @return temperature in centi degree Celsius (cSENSOR_FRAME_NO_READING if there is no reading)
+   */
+  inline int16_t GetCentiDegree(tSensor sensor) const
+  {
+    return temperature_[sensor];
+  }
+
+  /*!
+   * Stores a temperature and marks the reading as valid
+   *
+   * Rounds to centi degrees and saturates at the limits. NaN clears the reading.
+   *
+   * @param sensor sensor
+   * @param temperature temperature
+   */
+  inline void SetTemperature(tSensor sensor, const rrlib::si_units::tCelsius<double> & temperature)
+  {
+    temperature_[sensor] = ToCentiDegree(temperature.ValueFactored());
+    SetValid(sensor, temperature_[sensor] != cSENSOR_FRAME_NO_READING);
+  }
+
+  /*!
+   * Getter for the set point of the room
+   * @return set point
+   */
+  inline rrlib::si_units::tCelsius<double> GetRoomSetPoint() const
+  {
+    return rrlib::si_units::tCelsius<double>(ToDegree(room_set_point_));
+  }
+
+  /*!
+   * Setter for the set point of the room
+   * @param set_point set point
+   */
+  inline void SetRoomSetPoint(const rrlib::si_units::tCelsius<double> & set_point)
+  {
+    room_set_point_ = ToCentiDegree(set_point.ValueFactored());
+  }
+
+  /*!
+   * Creates the input of the state machine
+   * @param room temperature of living area (e.g. combined with the external sensor)
+   * @return temperatures of boiler (middle), room, solar, ground and set point
+   */
+  inline tTemperatures GetTemperatures(const rrlib::si_units::tCelsius<double> & room) const
+  {
+    return tTemperatures(GetTemperature(eSENSOR_BOILER_MIDDLE), room, GetTemperature(eSENSOR_SOLAR), GetTemperature(eSENSOR_GROUND), GetRoomSetPoint());
+  }
+
+  inline bool IsValid(tSensor sensor) const
+  {
+    return (valid_ >> sensor) & 1;
+  }
+
+  inline bool IsOutdated(tSensor sensor) const
+  {
+    return (outdated_ >> sensor) & 1;
+  }
+
+  inline bool IsImplausible(tSensor sensor) const
+  {
+    return (implausible_ >> sensor) & 1;
+  }
+
+  inline void SetValid(tSensor sensor, bool valid)
+  {
+    SetBit(valid_, sensor, valid);
+  }
+
+  inline void SetOutdated(tSensor sensor, bool outdated)
+  {
+    SetBit(outdated_, sensor, outdated);
+  }
+
+  inline void SetImplausible(tSensor sensor, bool implausible)
+  {
+    SetBit(implausible_, sensor, implausible);
+  }
+
+  /*!
+   * Bit masks of all sensors (bit i belongs to tSensor i)
+   */
+  inline uint16_t GetValidMask() const
+  {
+    return valid_;
+  }
+
+  inline uint16_t GetOutdatedMask() const
+  {
+    return outdated_;
+  }
+
+  inline uint16_t GetImplausibleMask() const
+  {
+    return implausible_;
+  }
+
+  inline void SetOutdatedMask(uint16_t mask)
+  {
+    outdated_ = mask;
+  }
+
+  inline void SetImplausibleMask(uint16_t mask)
+  {
+    implausible_ = mask;
+  }
+
+  /*!
+   * Are the readings of all sensors in mask valid, up to date and plausible
+   * @param mask bit mask of sensors
+   * @return all usable
+   */
+  inline bool IsUsable(uint16_t mask) const
+  {
+    return ((valid_ & mask) == mask) and ((outdated_ | implausible_) & mask) == 0;
+  }
+
+  /*!
+   * Bit mask of all sensors with a valid, up to date and plausible reading
+   */
+  inline uint16_t GetUsableMask() const
+  {
+    return valid_ & ~(outdated_ | implausible_);
+  }
+
+  friend rrlib::serialization::tOutputStream &operator << (rrlib::serialization::tOutputStream & stream, const tSensorFrame & frame);
+  friend rrlib::serialization::tInputStream &operator >> (rrlib::serialization::tInputStream & stream, tSensorFrame & frame);
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  int64_t timestamp_;
+  std::array<int16_t, eSENSOR_FRAME_COUNT> temperature_;
+  int16_t room_set_point_;
+  uint16_t valid_;
+  uint16_t outdated_;
+  uint16_t implausible_;
+
+  static inline int16_t ToCentiDegree(double temperature)
+  {
+    if (std::isnan(temperature))
+    {
+      return cSENSOR_FRAME_NO_READING;
+    }
+    double centi_degree = std::round(temperature * 100.0);
+    return static_cast<int16_t>(std::max<double>(INT16_MIN + 1, std::min<double>(INT16_MAX, centi_degree)));
+  }
+
+  static inline double ToDegree(int16_t centi_degree)
+  {
+    return centi_degree == cSENSOR_FRAME_NO_READING ? NAN : centi_degree / 100.0;
+  }
+
+  static inline void SetBit(uint16_t & mask, tSensor sensor, bool value)
+  {
+    mask = value ? (mask | (1 << sensor)) : (mask & ~(1 << sensor));
+  }
+
+};
+
+static_assert(sizeof(tSensorFrame) == 64, "tSensorFrame has to fit into one cache line");
+static_assert(std::is_trivially_copyable<tSensorFrame>::value, "tSensorFrame has to be trivially copyable");
+static_assert(std::is_standard_layout<tSensorFrame>::value, "tSensorFrame has to have standard layout");
+
+//----------------------------------------------------------------------
+// Function declaration
+//----------------------------------------------------------------------
+
+/*!
+ * Binary serialization of all fields (34 bytes, without padding)
+ */
+inline rrlib::serialization::tOutputStream &operator << (rrlib::serialization::tOutputStream & stream, const tSensorFrame & frame)
+{
+  stream.WriteLong(frame.timestamp_);
+  for (int16_t temperature : frame.temperature_)
+  {
+    stream.WriteShort(temperature);
+  }
+  stream.WriteShort(frame.room_set_point_);
+  stream.WriteShort(frame.valid_);
+  stream.WriteShort(frame.outdated_);
+  stream.WriteShort(frame.implausible_);
+  return stream;
+}
+
+inline rrlib::serialization::tInputStream &operator >> (rrlib::serialization::tInputStream & stream, tSensorFrame & frame)
+{
+  frame.timestamp_ = stream.ReadLong();
+  for (int16_t & temperature : frame.temperature_)
+  {
+    temperature = stream.ReadShort();
+  }
+  frame.room_set_point_ = stream.ReadShort();
+  frame.valid_ = static_cast<uint16_t>(stream.ReadShort());
+  frame.outdated_ = static_cast<uint16_t>(stream.ReadShort());
+  frame.implausible_ = static_cast<uint16_t>(stream.ReadShort());
+  return stream;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
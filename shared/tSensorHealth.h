@@ -0,0 +1,184 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/shared/tSensorHealth.h
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tSensorHealth.h
+ *
+ * \b tSensorHealth.h
+ *
+ * Decodes the sensor health bit masks published by the heat control.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __projects__smart_home__shared__tSensorHealth_h__
+#define __projects__smart_home__shared__tSensorHealth_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "projects/smart_home/shared/tSensorFrame.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace shared
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//! Display names of the sensors (indexed by tSensor)
+static constexpr std::array<const char *, eSENSOR_FRAME_COUNT> cSENSOR_NAMES {{
+    "Boiler Bottom",
+    "Boiler Middle",
+    "Boiler Top",
+    "Furnace",
+    "Garage",
+    "Ground",
+    "Room",
+    "Solar",
+    "Room External"
+  }
+};
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! SHORT_DESCRIPTION
+/*!
+ * Decodes the sensor health bit masks published by the heat control.
+ *
+ * Bit i of a mask belongs to tSensor i (the order of heat_control::tTemperatureSensors
+ * followed by the external room sensor). A set bit flags the sensor as outdated or
+ * implausible, depending on the port the mask was read from.
+ */
+class tSensorHealth
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * Constructor
+   * @param mask bit mask of flagged sensors
+   */
+  tSensorHealth(uint16_t mask = 0):
+    mask_(mask)
+  {}
+
+  /*!
+   * Is a sensor flagged
+   * @param sensor sensor
+   * @return flagged
+   */
+  inline bool IsFlagged(tSensor sensor) const
+  {
+    return (mask_ >> sensor) & 1;
+  }
+
+  /*!
+   * Are all sensors healthy
+   * @return no sensor flagged
+   */
+  inline bool IsHealthy() const
+  {
+    return mask_ == 0;
+  }
+
+  /*!
+   * Getter for flagged sensors
+   * @return flagged sensors in ascending order
+   */
+  std::vector<tSensor> GetFlaggedSensors() const
+  {
+    std::vector<tSensor> sensors;
+    for (int i = 0; i < eSENSOR_FRAME_COUNT; i++)
+    {
+      if (IsFlagged(static_cast<tSensor>(i)))
+      {
+        sensors.push_back(static_cast<tSensor>(i));
+      }
+    }
+    return sensors;
+  }
+
+  /*!
+   * Names of the flagged sensors for displays and logs
+   * @param separator separator between names
+   * @return names of flagged sensors (empty if all healthy)
+   */
+  std::string ToString(const std::string & separator = "; ") const
+  {
+    std::string names;
+    for (tSensor sensor : GetFlaggedSensors())
+    {
+      names += (names.empty() ? "" : separator) + cSENSOR_NAMES[sensor];
+    }
+    return names;
+  }
+
+  inline uint16_t GetMask() const
+  {
+    return mask_;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  uint16_t mask_;
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -0,0 +1,182 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/shared/tSlidingWindowMaximum.h
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tSlidingWindowMaximum.h
+ *
+ * \b tSlidingWindowMaximum.h
+ *
+ * Maximum of a signal over a sliding time window.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __projects__smart_home__shared__tSlidingWindowMaximum_h__
+#define __projects__smart_home__shared__tSlidingWindowMaximum_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/time/time.h"
+
+#include <deque>
+#include <limits>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace shared
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! SHORT_DESCRIPTION
+/*!
+ * Maximum of a signal over a sliding time window.
+ *
+ * Samples are collected in buckets of window / number of buckets. The maxima of closed buckets
+ * are kept in a monotonic deque (decreasing from front to back), so each sample costs O(1)
+ * amortized and memory is bounded by the number of buckets, independent of the sample rate.
+ * The window is therefore exact to one bucket.
+ */
+class tSlidingWindowMaximum
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * Constructor
+   * @param window length of window
+   * @param buckets number of buckets per window
+   */
+  tSlidingWindowMaximum(const rrlib::time::tDuration & window, unsigned int buckets):
+    window_(window),
+    bucket_duration_(window / (buckets > 0 ? buckets : 1)),
+    bucket_start_(rrlib::time::cNO_TIME),
+    bucket_maximum_(-std::numeric_limits<double>::infinity())
+  {}
+
+  /*!
+   * Adds a sample
+   * @param value value of sample
+   * @param timestamp time of sample (has to be non-decreasing)
+   */
+  void Add(double value, const rrlib::time::tTimestamp & timestamp)
+  {
+    if (bucket_start_ == rrlib::time::cNO_TIME)
+    {
+      bucket_start_ = timestamp;
+    }
+    else if (timestamp - bucket_start_ >= bucket_duration_)
+    {
+      CloseBucket();
+      bucket_start_ = timestamp;
+    }
+
+    if (value > bucket_maximum_)
+    {
+      bucket_maximum_ = value;
+    }
+
+    while (not maxima_.empty() and timestamp - maxima_.front().start >= window_)
+    {
+      maxima_.pop_front();
+    }
+  }
+
+  /*!
+   * Getter for maximum within the window
+   * @return maximum (-infinity if there were no samples)
+   */
+  inline double GetMaximum() const
+  {
+    return (not maxima_.empty() and maxima_.front().maximum > bucket_maximum_) ? maxima_.front().maximum : bucket_maximum_;
+  }
+
+  /*!
+   * Removes all samples
+   */
+  void Clear()
+  {
+    maxima_.clear();
+    bucket_start_ = rrlib::time::cNO_TIME;
+    bucket_maximum_ = -std::numeric_limits<double>::infinity();
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  struct tBucket
+  {
+    rrlib::time::tTimestamp start;
+    double maximum;
+  };
+
+  rrlib::time::tDuration window_;
+  rrlib::time::tDuration bucket_duration_;
+  std::deque<tBucket> maxima_;
+  rrlib::time::tTimestamp bucket_start_;
+  double bucket_maximum_;
+
+  void CloseBucket()
+  {
+    // buckets with a smaller maximum expire earlier and can never become the maximum again
+    while (not maxima_.empty() and maxima_.back().maximum <= bucket_maximum_)
+    {
+      maxima_.pop_back();
+    }
+    maxima_.push_back(tBucket {bucket_start_, bucket_maximum_});
+    bucket_maximum_ = -std::numeric_limits<double>::infinity();
+  }
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
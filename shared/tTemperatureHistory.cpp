@@ -0,0 +1,475 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/shared/tTemperatureHistory.cpp
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ */
+//----------------------------------------------------------------------
+#include "projects/smart_home/shared/tTemperatureHistory.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/logging/messages.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace shared
+{
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+static const char cSEGMENT_PREFIX[] = "temperatures_";
+static const char cSEGMENT_SUFFIX[] = ".bin";
+static const char cINDEX_SUFFIX[] = ".idx";
+static constexpr std::array<char, 8> cINDEX_MAGIC {{'S', 'H', 'T', 'E', 'M', 'I', 'D', 'X'}};
+
+// version 2: summaries only contain usable readings
+// version 3: order of the records
+static constexpr uint32_t cINDEX_VERSION = 3;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+namespace
+{
+
+inline int64_t ToNanoseconds(const rrlib::time::tTimestamp &timestamp)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count();
+}
+
+inline rrlib::time::tTimestamp ToTimestamp(int64_t nanoseconds)
+{
+  return rrlib::time::tTimestamp(std::chrono::duration_cast<rrlib::time::tTimestamp::duration>(std::chrono::nanoseconds(nanoseconds)));
+}
+
+//! Header of an index file, followed by the index entries and the block summaries
+struct tIndexHeader
+{
+  std::array<char, 8> magic;
+  uint32_t version;
+  uint32_t stride;
+  uint32_t block_count;
+  uint32_t monotonic;                  //!< timestamps of the records in the indexed blocks never decrease
+  int64_t segment_start_time;
+  uint64_t summary_size;
+};
+
+//! Accumulated readings of a bucket (in centi degree)
+struct tAccumulator
+{
+  int16_t min = INT16_MAX;
+  int16_t max = INT16_MIN;
+  uint32_t count = 0;
+  int64_t sum = 0;
+};
+
+}
+
+tTemperatureHistory::tTemperatureHistory()
+{}
+
+tTemperatureHistory::~tTemperatureHistory()
+{}
+
+std::size_t tTemperatureHistory::AddDirectory(const std::string &directory)
+{
+  DIR *handle = opendir(directory.c_str());
+  if (not handle)
+  {
+    return 0;
+  }
+  std::vector<std::string> filenames;
+  for (struct dirent *entry = readdir(handle); entry; entry = readdir(handle))
+  {
+    std::string name = entry->d_name;
+    std::size_t prefix_length = sizeof(cSEGMENT_PREFIX) - 1;
+    std::size_t suffix_length = sizeof(cSEGMENT_SUFFIX) - 1;
+    if (name.size() > prefix_length + suffix_length and name.compare(0, prefix_length, cSEGMENT_PREFIX) == 0
+        and name.compare(name.size() - suffix_length, suffix_length, cSEGMENT_SUFFIX) == 0)
+    {
+      filenames.push_back(directory + "/" + name);
+    }
+  }
+  closedir(handle);
+
+  std::size_t count = 0;
+  for (const std::string & filename : filenames)
+  {
+    count += AddSegment(filename);
+  }
+  return count;
+}
+
+bool tTemperatureHistory::AddSegment(const std::string &filename, bool store_index)
+{
+  std::unique_ptr<tSegment> segment(new tSegment());
+  if (not segment->file.Open(filename))
+  {
+    return false;
+  }
+
+  std::size_t record_count = segment->file.GetRecordCount();
+  std::size_t block_count = (record_count + cHISTORY_INDEX_STRIDE - 1) / cHISTORY_INDEX_STRIDE;
+  segment->index.resize(block_count);
+  segment->summaries.resize(block_count);
+  segment->summarized.resize(block_count, false);
+
+  std::size_t loaded_blocks = store_index ? LoadIndex(*segment, filename + cINDEX_SUFFIX) : 0;
+  for (std::size_t block = loaded_blocks; block < block_count; block++)
+  {
+    segment->index[block] = segment->file[block * cHISTORY_INDEX_STRIDE].timestamp;
+  }
+
+  // records not covered by the stored index are checked for a clock set back while writing
+  for (std::size_t i = std::max<std::size_t>(loaded_blocks * cHISTORY_INDEX_STRIDE, 1); i < record_count and segment->monotonic; i++)
+  {
+    segment->monotonic = segment->file[i].timestamp >= segment->file[i - 1].timestamp;
+  }
+  if (record_count > 0)
+  {
+    segment->first_time = segment->file[0].timestamp;
+    segment->last_time = segment->file[record_count - 1].timestamp;
+  }
+  if (not segment->monotonic)
+  {
+    RRLIB_LOG_PRINT(WARNING, "Timestamps in ", filename, " decrease (clock set back while logging). Queries scan this segment linearly.");
+    for (const tTemperatureLogRecord & record : segment->file)
+    {
+      segment->first_time = std::min(segment->first_time, record.timestamp);
+      segment->last_time = std::max(segment->last_time, record.timestamp);
+    }
+  }
+  std::size_t complete_blocks = record_count / cHISTORY_INDEX_STRIDE;
+  if (store_index and loaded_blocks < complete_blocks)
+  {
+    for (std::size_t block = loaded_blocks; block < complete_blocks; block++)
+    {
+      GetSummary(*segment, block);
+    }
+    SaveIndex(*segment, filename + cINDEX_SUFFIX);
+  }
+
+  // keep segments in chronological order
+  auto start = segment->file.GetHeader().start_time;
+  auto position = std::upper_bound(segments_.begin(), segments_.end(), start, [](int64_t time, const std::unique_ptr<tSegment> &other)
+  {
+    return time < other->file.GetHeader().start_time;
+  });
+  segments_.insert(position, std::move(segment));
+  return true;
+}
+
+void tTemperatureHistory::Clear()
+{
+  segments_.clear();
+}
+
+std::string tTemperatureHistory::GetChannelName(tSensor channel) const
+{
+  return segments_.empty() ? std::string() : segments_.back()->file.GetChannelName(channel);
+}
+
+uint64_t tTemperatureHistory::GetRecordCount() const
+{
+  uint64_t count = 0;
+  for (auto & segment : segments_)
+  {
+    count += segment->file.GetRecordCount();
+  }
+  return count;
+}
+
+rrlib::time::tTimestamp tTemperatureHistory::GetBegin() const
+{
+  bool empty = true;
+  int64_t begin = 0;
+  for (auto & segment : segments_)
+  {
+    if (segment->file.GetRecordCount() > 0)
+    {
+      begin = empty ? segment->first_time : std::min(begin, segment->first_time);
+      empty = false;
+    }
+  }
+  return empty ? rrlib::time::cNO_TIME : ToTimestamp(begin);
+}
+
+rrlib::time::tTimestamp tTemperatureHistory::GetEnd() const
+{
+  bool empty = true;
+  int64_t last = 0;
+  for (auto & segment : segments_)
+  {
+    if (segment->file.GetRecordCount() > 0)
+    {
+      last = empty ? segment->last_time : std::max(last, segment->last_time);
+      empty = false;
+    }
+  }
+  return empty ? rrlib::time::cNO_TIME : ToTimestamp(last + 1);
+}
+
+std::size_t tTemperatureHistory::LowerBound(const tSegment &segment, int64_t timestamp)
+{
+  // index block containing the position, then the records of that block
+  auto block = std::lower_bound(segment.index.begin(), segment.index.end(), timestamp);
+  if (block == segment.index.begin())
+  {
+    return 0;
+  }
+  std::size_t first = (block - segment.index.begin() - 1) * cHISTORY_INDEX_STRIDE;
+  std::size_t last = std::min(first + cHISTORY_INDEX_STRIDE, segment.file.GetRecordCount());
+  const tTemperatureLogRecord *records = segment.file.begin();
+  return std::lower_bound(records + first, records + last, timestamp, [](const tTemperatureLogRecord & record, int64_t time)
+  {
+    return record.timestamp < time;
+  }) - records;
+}
+
+const tTemperatureHistory::tBlockSummary &tTemperatureHistory::GetSummary(const tSegment &segment, std::size_t block)
+{
+  tBlockSummary &summary = segment.summaries[block];
+  if (not segment.summarized[block])
+  {
+    std::fill(std::begin(summary.min), std::end(summary.min), INT16_MAX);
+    std::fill(std::begin(summary.max), std::end(summary.max), INT16_MIN);
+    std::fill(std::begin(summary.count), std::end(summary.count), 0);
+    std::fill(std::begin(summary.sum), std::end(summary.sum), 0);
+    std::size_t first = block * cHISTORY_INDEX_STRIDE;
+    std::size_t last = std::min(first + cHISTORY_INDEX_STRIDE, segment.file.GetRecordCount());
+    for (std::size_t i = first; i < last; i++)
+    {
+      const tTemperatureLogRecord &record = segment.file[i];
+      for (int channel = 0; channel < eSENSOR_FRAME_COUNT; channel++)
+      {
+        int16_t value = record.temperature[channel];
+        if (IsUsable(record, static_cast<tSensor>(channel)))
+        {
+          summary.min[channel] = std::min(summary.min[channel], value);
+          summary.max[channel] = std::max(summary.max[channel], value);
+          summary.count[channel]++;
+          summary.sum[channel] += value;
+        }
+      }
+    }
+    segment.summarized[block] = true;
+  }
+  return summary;
+}
+
+std::size_t tTemperatureHistory::LoadIndex(tSegment &segment, const std::string &filename)
+{
+  std::ifstream file(filename, std::ios::binary);
+  tIndexHeader header;
+  if (not file.read(reinterpret_cast<char *>(&header), sizeof(header)) or header.magic != cINDEX_MAGIC or header.version != cINDEX_VERSION or header.stride != cHISTORY_INDEX_STRIDE
+      or header.segment_start_time != segment.file.GetHeader().start_time or header.summary_size != sizeof(tBlockSummary)
+      or header.block_count > segment.file.GetRecordCount() / cHISTORY_INDEX_STRIDE)
+  {
+    return 0;
+  }
+
+  std::size_t block_count = header.block_count;
+  segment.monotonic = header.monotonic != 0;
+  if (not file.read(reinterpret_cast<char *>(segment.index.data()), block_count * sizeof(int64_t))
+      or not file.read(reinterpret_cast<char *>(segment.summaries.data()), block_count * sizeof(tBlockSummary)))
+  {
+    return 0;
+  }
+  std::fill(segment.summarized.begin(), segment.summarized.begin() + block_count, true);
+  return block_count;
+}
+
+void tTemperatureHistory::SaveIndex(const tSegment &segment, const std::string &filename)
+{
+  tIndexHeader header;
+  std::memset(&header, 0, sizeof(header));
+  header.magic = cINDEX_MAGIC;
+  header.version = cINDEX_VERSION;
+  header.stride = cHISTORY_INDEX_STRIDE;
+  header.block_count = segment.file.GetRecordCount() / cHISTORY_INDEX_STRIDE;
+  header.monotonic = segment.monotonic ? 1 : 0;
+  header.segment_start_time = segment.file.GetHeader().start_time;
+  header.summary_size = sizeof(tBlockSummary);
+
+  // replace the index atomically, readers see the old or the new one
+  std::string temporary_filename = filename + ".tmp";
+  {
+    std::ofstream file(temporary_filename, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(segment.index.data()), header.block_count * sizeof(int64_t));
+    file.write(reinterpret_cast<const char *>(segment.summaries.data()), header.block_count * sizeof(tBlockSummary));
+    if (not file.good())
+    {
+      file.close();
+      std::remove(temporary_filename.c_str());
+      return;
+    }
+  }
+  if (std::rename(temporary_filename.c_str(), filename.c_str()) != 0)
+  {
+    std::remove(temporary_filename.c_str());
+  }
+}
+
+std::vector<tHistoryRange> tTemperatureHistory::GetRecords(const rrlib::time::tTimestamp &begin, const rrlib::time::tTimestamp &end) const
+{
+  std::vector<tHistoryRange> ranges;
+  int64_t begin_time = ToNanoseconds(begin);
+  int64_t end_time = ToNanoseconds(end);
+  for (auto & segment : segments_)
+  {
+    if (not segment->monotonic)
+    {
+      // runs of consecutive records within the range
+      const tTemperatureLogRecord *run_begin = nullptr;
+      for (const tTemperatureLogRecord *record = segment->file.begin(); record != segment->file.end(); ++record)
+      {
+        bool inside = record->timestamp >= begin_time and record->timestamp < end_time;
+        if (inside and not run_begin)
+        {
+          run_begin = record;
+        }
+        else if (not inside and run_begin)
+        {
+          ranges.push_back(tHistoryRange { run_begin, record });
+          run_begin = nullptr;
+        }
+      }
+      if (run_begin)
+      {
+        ranges.push_back(tHistoryRange { run_begin, segment->file.end() });
+      }
+      continue;
+    }
+
+    std::size_t first = LowerBound(*segment, begin_time);
+    std::size_t last = LowerBound(*segment, end_time);
+    if (first < last)
+    {
+      ranges.push_back(tHistoryRange { segment->file.begin() + first, segment->file.begin() + last });
+    }
+  }
+  return ranges;
+}
+
+std::vector<tHistoryBucket> tTemperatureHistory::Aggregate(tSensor channel, const rrlib::time::tTimestamp &begin, const rrlib::time::tTimestamp &end,
+    const rrlib::time::tDuration &bucket_duration) const
+{
+  int64_t begin_time = ToNanoseconds(begin);
+  int64_t end_time = ToNanoseconds(end);
+  int64_t width = std::chrono::duration_cast<std::chrono::nanoseconds>(bucket_duration).count();
+  if (channel < 0 or channel >= eSENSOR_FRAME_COUNT or width <= 0 or end_time <= begin_time
+      or static_cast<uint64_t>((end_time - begin_time - 1) / width) >= cHISTORY_MAX_BUCKETS)
+  {
+    return std::vector<tHistoryBucket>();
+  }
+
+  std::vector<tAccumulator> accumulators((end_time - begin_time - 1) / width + 1);
+  for (auto & segment : segments_)
+  {
+    // segments with decreasing timestamps are scanned completely
+    const tTemperatureLogFile &file = segment->file;
+    bool indexed = segment->monotonic;
+    std::size_t i = indexed ? LowerBound(*segment, begin_time) : 0;
+    std::size_t last = indexed ? LowerBound(*segment, end_time) : file.GetRecordCount();
+    while (i < last)
+    {
+      // complete index blocks within one bucket use their summary
+      if (indexed and i % cHISTORY_INDEX_STRIDE == 0 and i + cHISTORY_INDEX_STRIDE <= last)
+      {
+        std::size_t bucket = (file[i].timestamp - begin_time) / width;
+        if (static_cast<std::size_t>((file[i + cHISTORY_INDEX_STRIDE - 1].timestamp - begin_time) / width) == bucket)
+        {
+          const tBlockSummary &summary = GetSummary(*segment, i / cHISTORY_INDEX_STRIDE);
+          tAccumulator &accumulator = accumulators[bucket];
+          accumulator.min = std::min(accumulator.min, summary.min[channel]);
+          accumulator.max = std::max(accumulator.max, summary.max[channel]);
+          accumulator.count += summary.count[channel];
+          accumulator.sum += summary.sum[channel];
+          i += cHISTORY_INDEX_STRIDE;
+          continue;
+        }
+      }
+
+      int16_t value = file[i].temperature[channel];
+      if (IsUsable(file[i], channel) and file[i].timestamp >= begin_time and file[i].timestamp < end_time)
+      {
+        tAccumulator &accumulator = accumulators[(file[i].timestamp - begin_time) / width];
+        accumulator.min = std::min(accumulator.min, value);
+        accumulator.max = std::max(accumulator.max, value);
+        accumulator.count++;
+        accumulator.sum += value;
+      }
+      i++;
+    }
+  }
+
+  std::vector<tHistoryBucket> buckets;
+  buckets.reserve(accumulators.size());
+  for (std::size_t i = 0; i < accumulators.size(); i++)
+  {
+    const tAccumulator &accumulator = accumulators[i];
+    bool empty = accumulator.count == 0;
+    buckets.push_back(tHistoryBucket
+    {
+      ToTimestamp(begin_time + static_cast<int64_t>(i) * width),
+      accumulator.count,
+      empty ? NAN : accumulator.min / 100.0,
+      empty ? NAN : accumulator.max / 100.0,
+      empty ? NAN : accumulator.sum / (100.0 * accumulator.count)
+    });
+  }
+  return buckets;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
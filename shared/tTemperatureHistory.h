@@ -0,0 +1,251 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/shared/tTemperatureHistory.h
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tTemperatureHistory
+ *
+ * \b tTemperatureHistory
+ *
+ * Indexed range queries over all binary temperature logs of a directory.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __projects__smart_home__shared__tTemperatureHistory_h__
+#define __projects__smart_home__shared__tTemperatureHistory_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/time/time.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "projects/smart_home/shared/tTemperatureLog.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace shared
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+// number of records per index entry
+static constexpr std::size_t cHISTORY_INDEX_STRIDE = 256;
+
+// maximum number of buckets of one aggregation
+static constexpr std::size_t cHISTORY_MAX_BUCKETS = 1000000;
+
+//! Consecutive records of one log file
+struct tHistoryRange
+{
+  const tTemperatureLogRecord *begin;
+  const tTemperatureLogRecord *end;
+};
+
+//! Readings of one channel aggregated over a time bucket
+struct tHistoryBucket
+{
+  rrlib::time::tTimestamp start;
+  uint32_t count;                      //!< number of usable readings (valid, up to date and plausible)
+  double min;                          //!< degree Celsius (NaN if count is 0)
+  double max;
+  double mean;
+};
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! SHORT_DESCRIPTION
+/*!
+ * Indexed range queries over all binary temperature logs of a directory.
+ *
+ * Each log file (segment) is memory mapped by tTemperatureLogFile. A sparse index stores the
+ * timestamp of every cHISTORY_INDEX_STRIDE-th record, so a time range is located with two
+ * binary searches without touching the records in between. Aggregations use a summary
+ * (minimum, maximum, sum, count per channel) of each index block that lies completely within
+ * one bucket. Index and summaries of complete blocks are stored next to the segment
+ * (<segment>.idx) when it is added for the first time and reused by later processes.
+ *
+ * Records of a segment are normally in chronological order (as written by heat_control::mController).
+ * If the system clock was set back while a segment was written (e.g. by NTP after boot), the
+ * timestamps of that segment decrease somewhere. Such a segment is detected when it is added and
+ * queried with linear scans instead of the index and the summaries.
+ * Not thread safe.
+ */
+class tTemperatureHistory
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  tTemperatureHistory();
+
+  ~tTemperatureHistory();
+
+  /*!
+   * Adds all temperature logs (temperatures_*.bin) of a directory
+   * @param directory directory
+   * @return number of added segments
+   */
+  std::size_t AddDirectory(const std::string &directory);
+
+  /*!
+   * Adds one temperature log
+   * @param filename file name
+   * @param store_index store index and summaries in <filename>.idx
+   * @return true, if the file is a valid temperature log
+   */
+  bool AddSegment(const std::string &filename, bool store_index = true);
+
+  /*!
+   * Removes all segments
+   */
+  void Clear();
+
+  inline std::size_t GetSegmentCount() const
+  {
+    return segments_.size();
+  }
+
+  /*!
+   * Name of a channel as stored in the newest segment
+   */
+  std::string GetChannelName(tSensor channel) const;
+
+  /*!
+   * Number of records of all segments
+   */
+  uint64_t GetRecordCount() const;
+
+  /*!
+   * Time of the first and after the last record of all segments (cNO_TIME if empty)
+   */
+  rrlib::time::tTimestamp GetBegin() const;
+  rrlib::time::tTimestamp GetEnd() const;
+
+  /*!
+   * Raw records of a time range in chronological order (without copying)
+   * @param begin start of range
+   * @param end end of range (exclusive)
+   * @return ranges of records, one per segment (in file order and possibly several per segment, if its timestamps decrease)
+   */
+  std::vector<tHistoryRange> GetRecords(const rrlib::time::tTimestamp &begin, const rrlib::time::tTimestamp &end) const;
+
+  /*!
+   * Minimum, maximum and mean of the usable readings of a channel per bucket (missing, outdated and implausible readings are skipped like in tTemperatureRollup)
+   * @param channel channel
+   * @param begin start of first bucket
+   * @param end end of range (exclusive)
+   * @param bucket_duration duration of a bucket
+   * @return buckets (also empty ones) or nothing, if the parameters are invalid or there are more than cHISTORY_MAX_BUCKETS
+   */
+  std::vector<tHistoryBucket> Aggregate(tSensor channel, const rrlib::time::tTimestamp &begin, const rrlib::time::tTimestamp &end,
+                                        const rrlib::time::tDuration &bucket_duration) const;
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  //! Aggregated usable readings of one index block
+  struct tBlockSummary
+  {
+    int16_t min[eSENSOR_FRAME_COUNT];
+    int16_t max[eSENSOR_FRAME_COUNT];
+    uint16_t count[eSENSOR_FRAME_COUNT];
+    int64_t sum[eSENSOR_FRAME_COUNT];
+  };
+
+  //! One mapped log file with its index
+  struct tSegment
+  {
+    tTemperatureLogFile file;
+    std::vector<int64_t> index;
+
+    // timestamps never decrease (index and summaries can be used for queries)
+    bool monotonic = true;
+
+    // time of the earliest and the latest record
+    int64_t first_time = 0;
+    int64_t last_time = 0;
+
+    // summaries of the index blocks, computed on first use
+    mutable std::vector<tBlockSummary> summaries;
+    mutable std::vector<bool> summarized;
+  };
+
+  std::vector<std::unique_ptr<tSegment>> segments_;
+
+  /*!
+   * Position of the first record of a segment not before a timestamp
+   */
+  static std::size_t LowerBound(const tSegment &segment, int64_t timestamp);
+
+  /*!
+   * Summary of an index block (computed on first use)
+   */
+  static const tBlockSummary &GetSummary(const tSegment &segment, std::size_t block);
+
+  /*!
+   * Loads index entries, summaries of complete blocks and the order of their records from an index file
+   * @return number of loaded blocks
+   */
+  static std::size_t LoadIndex(tSegment &segment, const std::string &filename);
+
+  /*!
+   * Stores index entries and summaries of all complete blocks in an index file
+   */
+  static void SaveIndex(const tSegment &segment, const std::string &filename);
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -0,0 +1,163 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/shared/tTemperatureLog.cpp
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ */
+//----------------------------------------------------------------------
+#include "projects/smart_home/shared/tTemperatureLog.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/logging/messages.h"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace shared
+{
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+std::string CreateTemperatureLogHeader(const rrlib::time::tTimestamp &start_time, const std::array<const char *, eSENSOR_FRAME_COUNT> &channel_names)
+{
+  tTemperatureLogHeader header;
+  std::memset(&header, 0, sizeof(header));
+  header.magic = cTEMPERATURE_LOG_MAGIC;
+  header.version = cTEMPERATURE_LOG_VERSION;
+  header.header_size = sizeof(tTemperatureLogHeader);
+  header.record_size = sizeof(tTemperatureLogRecord);
+  header.channel_count = eSENSOR_FRAME_COUNT;
+  header.start_time = std::chrono::duration_cast<std::chrono::nanoseconds>(start_time.time_since_epoch()).count();
+  header.values_per_degree = 100;
+  header.no_reading = cSENSOR_FRAME_NO_READING;
+  for (int i = 0; i < eSENSOR_FRAME_COUNT; i++)
+  {
+    std::strncpy(header.channel_names[i], channel_names[i], cTEMPERATURE_LOG_CHANNEL_NAME_SIZE - 1);
+  }
+  return std::string(reinterpret_cast<const char *>(&header), sizeof(header));
+}
+
+tTemperatureLogFile::tTemperatureLogFile() :
+  mapping_(nullptr),
+  mapping_size_(0),
+  header_(nullptr),
+  records_(nullptr),
+  record_count_(0)
+{}
+
+tTemperatureLogFile::~tTemperatureLogFile()
+{
+  Close();
+}
+
+bool tTemperatureLogFile::Open(const std::string &filename)
+{
+  Close();
+  int file_descriptor = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+  if (file_descriptor < 0)
+  {
+    RRLIB_LOG_PRINT(ERROR, "Failed to open file: ", filename);
+    return false;
+  }
+  struct stat file_status;
+  if (fstat(file_descriptor, &file_status) != 0 or file_status.st_size < static_cast<off_t>(sizeof(tTemperatureLogHeader)))
+  {
+    RRLIB_LOG_PRINT(ERROR, "Not a temperature log: ", filename);
+    close(file_descriptor);
+    return false;
+  }
+  mapping_size_ = file_status.st_size;
+  mapping_ = mmap(nullptr, mapping_size_, PROT_READ, MAP_SHARED, file_descriptor, 0);
+  close(file_descriptor);
+  if (mapping_ == MAP_FAILED)
+  {
+    RRLIB_LOG_PRINT(ERROR, "Failed to map file: ", filename);
+    mapping_ = nullptr;
+    return false;
+  }
+
+  const tTemperatureLogHeader *header = static_cast<const tTemperatureLogHeader *>(mapping_);
+  if (header->magic != cTEMPERATURE_LOG_MAGIC or header->version != cTEMPERATURE_LOG_VERSION
+      or header->header_size != sizeof(tTemperatureLogHeader) or header->record_size != sizeof(tTemperatureLogRecord)
+      or header->channel_count != eSENSOR_FRAME_COUNT)
+  {
+    RRLIB_LOG_PRINT(ERROR, "Not a temperature log of version ", cTEMPERATURE_LOG_VERSION, ": ", filename);
+    Close();
+    return false;
+  }
+
+  header_ = header;
+  records_ = reinterpret_cast<const tTemperatureLogRecord *>(static_cast<const char *>(mapping_) + header->header_size);
+  record_count_ = (mapping_size_ - header->header_size) / header->record_size;
+  madvise(mapping_, mapping_size_, MADV_SEQUENTIAL);
+  return true;
+}
+
+void tTemperatureLogFile::Close()
+{
+  if (mapping_)
+  {
+    munmap(mapping_, mapping_size_);
+  }
+  mapping_ = nullptr;
+  mapping_size_ = 0;
+  header_ = nullptr;
+  records_ = nullptr;
+  record_count_ = 0;
+}
+
+std::string tTemperatureLogFile::GetChannelName(tSensor channel) const
+{
+  const char *name = header_->channel_names[channel];
+  return std::string(name, strnlen(name, cTEMPERATURE_LOG_CHANNEL_NAME_SIZE));
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
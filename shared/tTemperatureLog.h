@@ -0,0 +1,262 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/shared/tTemperatureLog.h
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tTemperatureLogFile
+ *
+ * \b tTemperatureLogFile
+ *
+ * Binary temperature log with fixed size records.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __projects__smart_home__shared__tTemperatureLog_h__
+#define __projects__smart_home__shared__tTemperatureLog_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/time/time.h"
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "projects/smart_home/shared/tSensorFrame.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace shared
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+// file format identification
+static constexpr std::array<char, 8> cTEMPERATURE_LOG_MAGIC {{'S', 'H', 'T', 'E', 'M', 'P', 'L', 'G'}};
+static constexpr uint16_t cTEMPERATURE_LOG_VERSION = 1;
+
+// maximum length of a channel name (including terminating zero)
+static constexpr std::size_t cTEMPERATURE_LOG_CHANNEL_NAME_SIZE = 24;
+
+/*!
+ * Header at the beginning of a temperature log file
+ *
+ * All values are stored in the byte order of the writer (little endian on the Raspberry Pi).
+ * Channel i contains the temperatures of tSensor i.
+ */
+struct tTemperatureLogHeader
+{
+  std::array<char, 8> magic;
+  uint16_t version;
+  uint16_t header_size;
+  uint16_t record_size;
+  uint16_t channel_count;
+  int64_t start_time;                  //!< nanoseconds since the epoch of rrlib::time
+  int16_t values_per_degree;           //!< 100: temperatures are stored in centi degree Celsius
+  int16_t no_reading;                  //!< stored value of a missing reading
+  uint32_t reserved;
+  char channel_names[eSENSOR_FRAME_COUNT][cTEMPERATURE_LOG_CHANNEL_NAME_SIZE];
+  char padding[8];
+};
+
+/*!
+ * One record of a temperature log file: a tSensorFrame without the set point
+ */
+struct tTemperatureLogRecord
+{
+  int64_t timestamp;                   //!< nanoseconds since the epoch of rrlib::time
+  int16_t temperature[eSENSOR_FRAME_COUNT];
+  uint16_t valid;                      //!< bit masks, bit i belongs to channel i
+  uint16_t outdated;
+  uint16_t implausible;
+};
+
+static_assert(sizeof(tTemperatureLogHeader) == 256, "Unexpected size of tTemperatureLogHeader");
+static_assert(sizeof(tTemperatureLogRecord) == 32, "Unexpected size of tTemperatureLogRecord");
+
+//----------------------------------------------------------------------
+// Function declaration
+//----------------------------------------------------------------------
+
+/*!
+ * Creates the header of a new temperature log file
+ * @param start_time start of logging
+ * @param channel_names names of the channels (indexed by tSensor, truncated if too long)
+ * @return header as written to the file
+ */
+std::string CreateTemperatureLogHeader(const rrlib::time::tTimestamp &start_time, const std::array<const char *, eSENSOR_FRAME_COUNT> &channel_names);
+
+/*!
+ * Creates the log record of a sensor frame
+ */
+inline tTemperatureLogRecord ToTemperatureLogRecord(const tSensorFrame &frame)
+{
+  tTemperatureLogRecord record;
+  record.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(frame.GetTimestamp().time_since_epoch()).count();
+  for (int i = 0; i < eSENSOR_FRAME_COUNT; i++)
+  {
+    record.temperature[i] = frame.GetCentiDegree(static_cast<tSensor>(i));
+  }
+  record.valid = frame.GetValidMask();
+  record.outdated = frame.GetOutdatedMask();
+  record.implausible = frame.GetImplausibleMask();
+  return record;
+}
+
+/*!
+ * Temperature of one channel of a record
+ * @return temperature in degree Celsius (NaN if there is no reading)
+ */
+inline double GetTemperature(const tTemperatureLogRecord &record, tSensor channel)
+{
+  int16_t value = record.temperature[channel];
+  return value == cSENSOR_FRAME_NO_READING ? NAN : value / 100.0;
+}
+
+/*!
+ * Is the reading of one channel of a record valid, up to date and plausible (like tSensorFrame::GetUsableMask)
+ */
+inline bool IsUsable(const tTemperatureLogRecord &record, tSensor channel)
+{
+  return record.temperature[channel] != cSENSOR_FRAME_NO_READING and ((record.valid & ~(record.outdated | record.implausible)) >> channel) & 1;
+}
+
+inline rrlib::time::tTimestamp GetTimestamp(const tTemperatureLogRecord &record)
+{
+  return rrlib::time::tTimestamp(std::chrono::duration_cast<rrlib::time::tTimestamp::duration>(std::chrono::nanoseconds(record.timestamp)));
+}
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! SHORT_DESCRIPTION
+/*!
+ * Read only, memory mapped view of a temperature log file.
+ *
+ * The records are accessed in place without copying or parsing. The view covers the
+ * complete records present when the file was opened.
+ */
+class tTemperatureLogFile
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  tTemperatureLogFile();
+
+  ~tTemperatureLogFile();
+
+  tTemperatureLogFile(const tTemperatureLogFile &) = delete;
+  tTemperatureLogFile &operator=(const tTemperatureLogFile &) = delete;
+
+  /*!
+   * Maps a temperature log file
+   * @param filename file name
+   * @return true, if the file is a temperature log of a supported version
+   */
+  bool Open(const std::string &filename);
+
+  void Close();
+
+  inline bool IsOpen() const
+  {
+    return header_ != nullptr;
+  }
+
+  inline const tTemperatureLogHeader &GetHeader() const
+  {
+    return *header_;
+  }
+
+  inline rrlib::time::tTimestamp GetStartTime() const
+  {
+    return rrlib::time::tTimestamp(std::chrono::duration_cast<rrlib::time::tTimestamp::duration>(std::chrono::nanoseconds(header_->start_time)));
+  }
+
+  /*!
+   * Name of a channel
+   */
+  std::string GetChannelName(tSensor channel) const;
+
+  inline std::size_t GetRecordCount() const
+  {
+    return record_count_;
+  }
+
+  inline const tTemperatureLogRecord &operator[](std::size_t index) const
+  {
+    return records_[index];
+  }
+
+  inline const tTemperatureLogRecord *begin() const
+  {
+    return records_;
+  }
+
+  inline const tTemperatureLogRecord *end() const
+  {
+    return records_ + record_count_;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  void *mapping_;
+  std::size_t mapping_size_;
+  const tTemperatureLogHeader *header_;
+  const tTemperatureLogRecord *records_;
+  std::size_t record_count_;
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -0,0 +1,262 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/shared/tTemperatureRollup.cpp
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ */
+//----------------------------------------------------------------------
+#include "projects/smart_home/shared/tTemperatureRollup.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/rtti/rtti.h"
+#include <algorithm>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace shared
+{
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+// registers the type so buckets can be published via ports
+static rrlib::rtti::tDataType<tRollupBucket> cROLLUP_BUCKET_TYPE("TemperatureRollupBucket");
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+namespace
+{
+
+int64_t ToNanoseconds(const rrlib::time::tTimestamp &timestamp)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count();
+}
+
+/*!
+ * Start of the bucket of a level containing a timestamp
+ */
+int64_t GetBucketStart(tRollupLevel level, int64_t timestamp)
+{
+  int64_t duration = cROLLUP_BUCKET_DURATION_MS[level] * 1000000;
+  int64_t remainder = timestamp % duration;
+  return timestamp - (remainder < 0 ? remainder + duration : remainder);
+}
+
+void ResetBucket(tRollupBucket &bucket, int64_t start)
+{
+  bucket.start = start;
+  for (int i = 0; i < eSENSOR_FRAME_COUNT; i++)
+  {
+    bucket.sum[i] = 0;
+    bucket.min[i] = INT16_MAX;
+    bucket.max[i] = INT16_MIN;
+    bucket.count[i] = 0;
+  }
+}
+
+}
+
+//----------------------------------------------------------------------
+// tTemperatureRollup constructor
+//----------------------------------------------------------------------
+tTemperatureRollup::tTemperatureRollup() :
+  storage_(cROLLUP_MEMORY / sizeof(tRollupBucket))
+{
+  tRollupBucket *buckets = storage_.data();
+  for (int level = 0; level < eROLLUP_LEVEL_COUNT; level++)
+  {
+    levels_[level].buckets = buckets;
+    levels_[level].first = 0;
+    levels_[level].size = 0;
+    buckets += cROLLUP_CAPACITY[level];
+  }
+}
+
+//----------------------------------------------------------------------
+// tTemperatureRollup Add
+//----------------------------------------------------------------------
+void tTemperatureRollup::Add(const tSensorFrame &frame)
+{
+  int64_t timestamp = ToNanoseconds(frame.GetTimestamp());
+  if (levels_[eROLLUP_RAW].size > 0)
+  {
+    int64_t current = GetBucket(eROLLUP_RAW, levels_[eROLLUP_RAW].size - 1).start;
+    if (timestamp < current)
+    {
+      Clear();
+    }
+    else if (GetBucketStart(eROLLUP_RAW, timestamp) == current)
+    {
+      return;
+    }
+  }
+
+  uint16_t usable = frame.GetUsableMask();
+  for (int i = 0; i < eROLLUP_LEVEL_COUNT; i++)
+  {
+    tRollupLevel level = static_cast<tRollupLevel>(i);
+    tLevel &ring = levels_[level];
+    int64_t start = GetBucketStart(level, timestamp);
+    if (ring.size == 0 or GetBucket(level, ring.size - 1).start != start)
+    {
+      // a full ring overwrites its oldest bucket
+      if (ring.size == cROLLUP_CAPACITY[level])
+      {
+        ring.first = (ring.first + 1) % cROLLUP_CAPACITY[level];
+      }
+      else
+      {
+        ring.size++;
+      }
+      ResetBucket(ring.buckets[(ring.first + ring.size - 1) % cROLLUP_CAPACITY[level]], start);
+    }
+
+    tRollupBucket &bucket = ring.buckets[(ring.first + ring.size - 1) % cROLLUP_CAPACITY[level]];
+    for (int channel = 0; channel < eSENSOR_FRAME_COUNT; channel++)
+    {
+      if (usable & (1 << channel))
+      {
+        int16_t value = frame.GetCentiDegree(static_cast<tSensor>(channel));
+        bucket.sum[channel] += value;
+        bucket.min[channel] = std::min(bucket.min[channel], value);
+        bucket.max[channel] = std::max(bucket.max[channel], value);
+        bucket.count[channel]++;
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+// tTemperatureRollup Clear
+//----------------------------------------------------------------------
+void tTemperatureRollup::Clear()
+{
+  for (auto & ring : levels_)
+  {
+    ring.first = 0;
+    ring.size = 0;
+  }
+}
+
+//----------------------------------------------------------------------
+// tTemperatureRollup SelectLevel
+//----------------------------------------------------------------------
+tRollupLevel tTemperatureRollup::SelectLevel(const rrlib::time::tDuration &duration)
+{
+  int64_t duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+  for (int i = 0; i < eROLLUP_HOUR; i++)
+  {
+    if (duration_ms <= cROLLUP_BUCKET_DURATION_MS[i] * static_cast<int64_t>(cROLLUP_TREND_MAX_BUCKETS))
+    {
+      return static_cast<tRollupLevel>(i);
+    }
+  }
+  return eROLLUP_HOUR;
+}
+
+//----------------------------------------------------------------------
+// tTemperatureRollup GetBuckets
+//----------------------------------------------------------------------
+std::vector<tRollupBucket> tTemperatureRollup::GetBuckets(tRollupLevel level, const rrlib::time::tTimestamp &begin, const rrlib::time::tTimestamp &end) const
+{
+  std::vector<tRollupBucket> result;
+  if (level < 0 or level >= eROLLUP_LEVEL_COUNT)
+  {
+    return result;
+  }
+  std::size_t last = LowerBound(level, ToNanoseconds(end));
+  for (std::size_t i = LowerBound(level, ToNanoseconds(begin)); i < last; i++)
+  {
+    result.push_back(GetBucket(level, i));
+  }
+  return result;
+}
+
+//----------------------------------------------------------------------
+// tTemperatureRollup GetTrend
+//----------------------------------------------------------------------
+std::vector<tHistoryBucket> tTemperatureRollup::GetTrend(tSensor channel, const rrlib::time::tTimestamp &begin, const rrlib::time::tTimestamp &end) const
+{
+  std::vector<tHistoryBucket> result;
+  if (channel < 0 or channel >= eSENSOR_FRAME_COUNT)
+  {
+    return result;
+  }
+  tRollupLevel level = SelectLevel(end - begin);
+  std::size_t last = LowerBound(level, ToNanoseconds(end));
+  for (std::size_t i = LowerBound(level, ToNanoseconds(begin)); i < last; i++)
+  {
+    const tRollupBucket &bucket = GetBucket(level, i);
+    result.push_back(tHistoryBucket {GetStart(bucket), bucket.count[channel], GetMin(bucket, channel), GetMax(bucket, channel), GetMean(bucket, channel)});
+  }
+  return result;
+}
+
+//----------------------------------------------------------------------
+// tTemperatureRollup LowerBound
+//----------------------------------------------------------------------
+std::size_t tTemperatureRollup::LowerBound(tRollupLevel level, int64_t timestamp) const
+{
+  std::size_t low = 0;
+  std::size_t high = levels_[level].size;
+  while (low < high)
+  {
+    std::size_t middle = low + (high - low) / 2;
+    if (GetBucket(level, middle).start < timestamp)
+    {
+      low = middle + 1;
+    }
+    else
+    {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
@@ -0,0 +1,297 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/shared/tTemperatureRollup.h
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tTemperatureRollup
+ *
+ * \b tTemperatureRollup
+ *
+ * Live temperature history at several resolutions in ring buffers of fixed size.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __projects__smart_home__shared__tTemperatureRollup_h__
+#define __projects__smart_home__shared__tTemperatureRollup_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/serialization/serialization.h"
+#include "rrlib/time/time.h"
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "projects/smart_home/shared/tSensorFrame.h"
+#include "projects/smart_home/shared/tTemperatureHistory.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace shared
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//! Resolutions of tTemperatureRollup (finest first)
+enum tRollupLevel
+{
+  eROLLUP_RAW = 0,     //!< 200 ms (one sample per control cycle) for 10 minutes
+  eROLLUP_SECOND,      //!< 1 s for 1 hour
+  eROLLUP_MINUTE,      //!< 1 min for 1 day
+  eROLLUP_HOUR,        //!< 1 h for 1 year
+  eROLLUP_LEVEL_COUNT
+};
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+// duration of one bucket per level in milliseconds
+static constexpr std::array<int64_t, eROLLUP_LEVEL_COUNT> cROLLUP_BUCKET_DURATION_MS {{200, 1000, 60 * 1000, 60 * 60 * 1000}};
+
+// number of buckets per level
+static constexpr std::array<std::size_t, eROLLUP_LEVEL_COUNT> cROLLUP_CAPACITY {{10 * 60 * 5, 60 * 60, 24 * 60, 365 * 24}};
+
+// maximum number of buckets of a trend (one day at minute resolution)
+static constexpr std::size_t cROLLUP_TREND_MAX_BUCKETS = 24 * 60;
+
+static_assert(cROLLUP_TREND_MAX_BUCKETS <= cROLLUP_CAPACITY[eROLLUP_MINUTE] and cROLLUP_TREND_MAX_BUCKETS <= cROLLUP_CAPACITY[eROLLUP_RAW],
+              "A level selected for a trend has to keep the complete trend duration");
+
+/*!
+ * Usable readings of all channels within one time bucket
+ *
+ * Temperatures are stored in centi degree Celsius like in tSensorFrame.
+ */
+struct tRollupBucket
+{
+  int64_t start;                       //!< nanoseconds since the epoch of rrlib::time
+  int32_t sum[eSENSOR_FRAME_COUNT];
+  int16_t min[eSENSOR_FRAME_COUNT];
+  int16_t max[eSENSOR_FRAME_COUNT];
+  uint16_t count[eSENSOR_FRAME_COUNT]; //!< number of usable readings
+};
+
+// memory of all levels, allocated once
+static constexpr std::size_t cROLLUP_MEMORY = sizeof(tRollupBucket) * (cROLLUP_CAPACITY[eROLLUP_RAW] + cROLLUP_CAPACITY[eROLLUP_SECOND] +
+    cROLLUP_CAPACITY[eROLLUP_MINUTE] + cROLLUP_CAPACITY[eROLLUP_HOUR]);
+
+static_assert(cROLLUP_MEMORY <= 2 * 1024 * 1024, "The live history has to stay below 2 MiB");
+static_assert(cROLLUP_BUCKET_DURATION_MS[eROLLUP_HOUR] / cROLLUP_BUCKET_DURATION_MS[eROLLUP_RAW] <= UINT16_MAX, "Sample count of a bucket overflows");
+static_assert(cROLLUP_BUCKET_DURATION_MS[eROLLUP_HOUR] / cROLLUP_BUCKET_DURATION_MS[eROLLUP_RAW] * INT16_MAX <= INT32_MAX, "Sum of a bucket overflows");
+
+//----------------------------------------------------------------------
+// Function declaration
+//----------------------------------------------------------------------
+
+inline rrlib::time::tTimestamp GetStart(const tRollupBucket &bucket)
+{
+  return rrlib::time::tTimestamp(std::chrono::duration_cast<rrlib::time::tTimestamp::duration>(std::chrono::nanoseconds(bucket.start)));
+}
+
+/*!
+ * Minimum, maximum and mean of one channel of a bucket
+ * @return temperature in degree Celsius (NaN if there is no usable reading)
+ */
+inline double GetMin(const tRollupBucket &bucket, tSensor channel)
+{
+  return bucket.count[channel] ? bucket.min[channel] / 100.0 : NAN;
+}
+
+inline double GetMax(const tRollupBucket &bucket, tSensor channel)
+{
+  return bucket.count[channel] ? bucket.max[channel] / 100.0 : NAN;
+}
+
+inline double GetMean(const tRollupBucket &bucket, tSensor channel)
+{
+  return bucket.count[channel] ? bucket.sum[channel] / (100.0 * bucket.count[channel]) : NAN;
+}
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! SHORT_DESCRIPTION
+/*!
+ * Live temperature history at several resolutions in ring buffers of fixed size.
+ *
+ * Every sensor frame updates the newest bucket of each level (minimum, maximum, sum and count
+ * per channel), so adding a frame costs the same no matter how much history is kept. At most one
+ * frame per 200 ms is taken, which bounds the counts and sums of the coarser levels. Readings that
+ * are missing, outdated or implausible are not counted. All buckets are allocated on construction
+ * (cROLLUP_MEMORY); when a level is full, its oldest bucket is overwritten.
+ *
+ * Buckets are aligned to multiples of their duration since the epoch. Periods without frames
+ * leave no buckets, so a level may reach back further than its nominal duration. If the clock
+ * goes backwards (e.g. when it is set after booting), the history is cleared.
+ * Not thread safe.
+ */
+class tTemperatureRollup
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  tTemperatureRollup();
+
+  /*!
+   * Adds the readings of a frame to all levels
+   * @param frame frame (ignored, if there is already a frame of its 200 ms)
+   */
+  void Add(const tSensorFrame &frame);
+
+  /*!
+   * Removes all buckets
+   */
+  void Clear();
+
+  static inline rrlib::time::tDuration GetBucketDuration(tRollupLevel level)
+  {
+    return std::chrono::milliseconds(cROLLUP_BUCKET_DURATION_MS[level]);
+  }
+
+  inline std::size_t GetBucketCount(tRollupLevel level) const
+  {
+    return levels_[level].size;
+  }
+
+  /*!
+   * Bucket of a level
+   * @param index index (0 is the oldest bucket, GetBucketCount(level) - 1 the current one)
+   */
+  inline const tRollupBucket &GetBucket(tRollupLevel level, std::size_t index) const
+  {
+    const tLevel &ring = levels_[level];
+    return ring.buckets[(ring.first + index) % cROLLUP_CAPACITY[level]];
+  }
+
+  /*!
+   * Finest level that divides a time span into at most cROLLUP_TREND_MAX_BUCKETS buckets
+   *
+   * The selected level always keeps the complete time span, so the size of a trend only depends
+   * on the requested duration.
+   *
+   * @param duration time span
+   * @return level (eROLLUP_HOUR for time spans beyond cROLLUP_TREND_MAX_BUCKETS hours)
+   */
+  static tRollupLevel SelectLevel(const rrlib::time::tDuration &duration);
+
+  /*!
+   * Buckets of a level that start within a time range
+   * @param level level
+   * @param begin start of range
+   * @param end end of range (exclusive)
+   * @return copies of the buckets in chronological order
+   */
+  std::vector<tRollupBucket> GetBuckets(tRollupLevel level, const rrlib::time::tTimestamp &begin, const rrlib::time::tTimestamp &end) const;
+
+  /*!
+   * Minimum, maximum and mean of a channel within a time range at the level selected for its duration
+   * @param channel channel
+   * @param begin start of range
+   * @param end end of range (exclusive)
+   * @return stored buckets of the level (periods without frames are left out)
+   */
+  std::vector<tHistoryBucket> GetTrend(tSensor channel, const rrlib::time::tTimestamp &begin, const rrlib::time::tTimestamp &end) const;
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  //! Ring buffer of one level
+  struct tLevel
+  {
+    tRollupBucket *buckets;
+    std::size_t first;
+    std::size_t size;
+  };
+
+  std::vector<tRollupBucket> storage_;
+  std::array<tLevel, eROLLUP_LEVEL_COUNT> levels_;
+
+  /*!
+   * Position of the first bucket of a level not starting before a timestamp
+   */
+  std::size_t LowerBound(tRollupLevel level, int64_t timestamp) const;
+
+};
+
+//----------------------------------------------------------------------
+// Function declaration
+//----------------------------------------------------------------------
+
+/*!
+ * Binary serialization of all fields
+ */
+inline rrlib::serialization::tOutputStream &operator << (rrlib::serialization::tOutputStream & stream, const tRollupBucket & bucket)
+{
+  stream.WriteLong(bucket.start);
+  for (int i = 0; i < eSENSOR_FRAME_COUNT; i++)
+  {
+    stream.WriteInt(bucket.sum[i]);
+    stream.WriteShort(bucket.min[i]);
+    stream.WriteShort(bucket.max[i]);
+    stream.WriteShort(bucket.count[i]);
+  }
+  return stream;
+}
+
+inline rrlib::serialization::tInputStream &operator >> (rrlib::serialization::tInputStream & stream, tRollupBucket & bucket)
+{
+  bucket.start = stream.ReadLong();
+  for (int i = 0; i < eSENSOR_FRAME_COUNT; i++)
+  {
+    bucket.sum[i] = stream.ReadInt();
+    bucket.min[i] = stream.ReadShort();
+    bucket.max[i] = stream.ReadShort();
+    bucket.count[i] = static_cast<uint16_t>(stream.ReadShort());
+  }
+  return stream;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -0,0 +1,257 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/test/async_log_writer.cpp
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tUnitTestSuite.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include <cassert>
+
+#include "projects/smart_home/shared/tAsyncFileWriter.h"
+#include "projects/smart_home/shared/tAsyncLogWriter.h"
+#include "projects/smart_home/shared/tSPSCRingBuffer.h"
+#include "projects/smart_home/tests/test_utils.h"
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace tests
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+class AsyncLogWriter : public rrlib::util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(AsyncLogWriter);
+  RRLIB_UNIT_TESTS_ADD_TEST(RingBuffer);
+  RRLIB_UNIT_TESTS_ADD_TEST(RingBufferThreads);
+  RRLIB_UNIT_TESTS_ADD_TEST(Lines);
+  RRLIB_UNIT_TESTS_ADD_TEST(Overflow);
+  RRLIB_UNIT_TESTS_ADD_TEST(FileReplacement);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+private:
+
+  static std::vector<std::string> ReadLines(const std::string &filename)
+  {
+    std::vector<std::string> lines;
+    std::ifstream file(filename);
+    for (std::string line; std::getline(file, line);)
+    {
+      lines.push_back(line);
+    }
+    return lines;
+  }
+
+  void RingBuffer()
+  {
+    shared::tSPSCRingBuffer<int> buffer(5);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(8), buffer.Capacity());
+    RRLIB_UNIT_TESTS_ASSERT(buffer.Front() == nullptr);
+
+    for (int i = 0; i < 8; i++)
+    {
+      int *slot = buffer.Reserve();
+      RRLIB_UNIT_TESTS_ASSERT(slot != nullptr);
+      *slot = i;
+      buffer.Commit();
+    }
+    RRLIB_UNIT_TESTS_ASSERT(buffer.Reserve() == nullptr);
+
+    RRLIB_UNIT_TESTS_EQUALITY(0, *buffer.Front());
+    buffer.Pop();
+    RRLIB_UNIT_TESTS_ASSERT(buffer.Reserve() != nullptr);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(7), buffer.Size());
+  }
+
+  void RingBufferThreads()
+  {
+    // the consumer has to receive every element exactly once and in order
+    const uint64_t count = 1000000;
+    shared::tSPSCRingBuffer<uint64_t> buffer(64);
+    std::thread producer([&]
+    {
+      for (uint64_t i = 0; i < count;)
+      {
+        uint64_t *slot = buffer.Reserve();
+        if (slot)
+        {
+          *slot = i++;
+          buffer.Commit();
+        }
+        else
+        {
+          std::this_thread::yield();
+        }
+      }
+    });
+
+    bool in_order = true;
+    for (uint64_t expected = 0; expected < count;)
+    {
+      const uint64_t *element = buffer.Front();
+      if (element)
+      {
+        in_order &= (*element == expected);
+        buffer.Pop();
+        expected++;
+      }
+      else
+      {
+        std::this_thread::yield();
+      }
+    }
+    producer.join();
+    RRLIB_UNIT_TESTS_ASSERT(in_order);
+    RRLIB_UNIT_TESTS_ASSERT(buffer.Front() == nullptr);
+  }
+
+  void Lines()
+  {
+    std::string filename = TemporaryFilename("async_log_lines", ".txt");
+    std::remove(filename.c_str());
+    {
+      shared::tAsyncLogWriter writer;
+      RRLIB_UNIT_TESTS_ASSERT(writer.Open(filename));
+      shared::tLogLine(writer) << "first " << 1 << "\n";
+      {
+        shared::tLogLine line(writer);
+        line << "second";
+        for (int i = 0; i < 3; i++)
+        {
+          line << " " << i;
+        }
+        line << "\n";
+      }
+      shared::tLogLine(writer) << std::string(2 * shared::cLOG_RECORD_SIZE, 'x') << "\n";
+      writer.Close();
+      RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint64_t>(3), writer.GetWrittenCount());
+      RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint64_t>(0), writer.GetDroppedCount());
+
+      // closed writers ignore lines
+      shared::tLogLine(writer) << "ignored\n";
+      RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint64_t>(0), writer.GetDroppedCount());
+    }
+
+    auto lines = ReadLines(filename);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(3), lines.size());
+    RRLIB_UNIT_TESTS_EQUALITY(std::string("first 1"), lines[0]);
+    RRLIB_UNIT_TESTS_EQUALITY(std::string("second 0 1 2"), lines[1]);
+    RRLIB_UNIT_TESTS_EQUALITY(sizeof(shared::tLogRecord::text) - 1, lines[2].size());
+    std::remove(filename.c_str());
+  }
+
+  void Overflow()
+  {
+    // a burst larger than the buffer loses lines, but never blocks and never corrupts the file
+    std::string filename = TemporaryFilename("async_log_overflow", ".txt");
+    std::remove(filename.c_str());
+    const uint64_t count = 10000;
+    shared::tAsyncLogWriter writer(16);
+    RRLIB_UNIT_TESTS_ASSERT(writer.Open(filename));
+    for (uint64_t i = 0; i < count; i++)
+    {
+      shared::tLogLine(writer) << "line " << i << "\n";
+    }
+    writer.Close();
+
+    RRLIB_UNIT_TESTS_ASSERT(writer.GetDroppedCount() > 0);
+    RRLIB_UNIT_TESTS_EQUALITY(count, writer.GetWrittenCount() + writer.GetDroppedCount());
+    auto lines = ReadLines(filename);
+    RRLIB_UNIT_TESTS_EQUALITY(writer.GetWrittenCount(), static_cast<uint64_t>(lines.size()));
+    for (auto & line : lines)
+    {
+      RRLIB_UNIT_TESTS_ASSERT(line.compare(0, 5, "line ") == 0);
+    }
+    std::remove(filename.c_str());
+  }
+
+  void FileReplacement()
+  {
+    std::string filename = TemporaryFilename("async_file", ".txt");
+    std::ofstream(filename) << "old content with more text\n";
+    RRLIB_UNIT_TESTS_ASSERT(shared::tAsyncFileWriter::ReplaceFile(filename, "new\n"));
+    RRLIB_UNIT_TESTS_ASSERT(ReadLines(filename) == std::vector<std::string>({ "new" }));
+
+    // the newest content of a burst is stored, the temporary file is gone
+    shared::tAsyncFileWriter writer;
+    writer.Open(filename);
+    for (int i = 0; i < 3; i++)
+    {
+      RRLIB_UNIT_TESTS_ASSERT(writer.Write(std::to_string(i) + "\n"));
+    }
+    writer.Close();
+    RRLIB_UNIT_TESTS_ASSERT(writer.GetWrittenCount() >= 1);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint64_t>(0), writer.GetDroppedCount());
+    RRLIB_UNIT_TESTS_ASSERT(ReadLines(filename) == std::vector<std::string>({ "2" }));
+    RRLIB_UNIT_TESTS_ASSERT(not std::ifstream(filename + ".tmp").good());
+    RRLIB_UNIT_TESTS_ASSERT(not writer.Write("closed\n"));
+
+    // a missing directory leaves nothing behind
+    RRLIB_UNIT_TESTS_ASSERT(not shared::tAsyncFileWriter::ReplaceFile(filename + ".missing/file", "x\n"));
+    std::remove(filename.c_str());
+  }
+
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(AsyncLogWriter);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
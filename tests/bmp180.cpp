@@ -0,0 +1,154 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/test/bmp180.cpp
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tUnitTestSuite.h"
+#include <cmath>
+#include <cstdio>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include <cassert>
+
+#include "projects/smart_home/shared/tBMP180.h"
+#include "projects/smart_home/shared/tBMP180Simulation.h"
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace tests
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+class BMP180 : public rrlib::util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(BMP180);
+  RRLIB_UNIT_TESTS_ADD_TEST(DataSheetExample);
+  RRLIB_UNIT_TESTS_ADD_TEST(Altitude);
+  RRLIB_UNIT_TESTS_ADD_TEST(Measurement);
+  RRLIB_UNIT_TESTS_ADD_TEST(InvalidCalibration);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+private:
+
+  void DataSheetExample()
+  {
+    // the simulation defaults to the calibration of the data sheet example
+    shared::tBMP180Simulation simulation;
+    shared::tBMP180 bmp180(simulation);
+    bmp180.LoadCalibration();
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<std::size_t>(1), simulation.GetReadCount());
+
+    RRLIB_UNIT_TESTS_EQUALITY(150, bmp180.ComputeTemperature(27898));
+    RRLIB_UNIT_TESTS_EQUALITY(69964, bmp180.ComputePressure(23843, 27898, shared::tBMP180OSSMode::tBMP180_OSS_ULTRA_LOW_POWER));
+
+    // same pressure measured with higher oversampling (differs by rounding only)
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(69964, bmp180.ComputePressure(23843 << 1, 27898, shared::tBMP180OSSMode::tBMP180_OSS_STANDARD), 2);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(69964, bmp180.ComputePressure(23843 << 3, 27898, shared::tBMP180OSSMode::tBMP180_OSS_ULTRA_HIGH_RESOLUTION), 2);
+  }
+
+  void Altitude()
+  {
+    for (double pressure = 30000.0; pressure <= 110000.0; pressure += 37.0)
+    {
+      double expected = 44330.0 * (1.0 - std::pow(pressure / 101325.0, 1 / 5.255));
+      RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(expected, shared::tBMP180::ComputeAltitude(pressure, 101325.0), 0.1);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.0, shared::tBMP180::ComputeAltitude(101325.0, 101325.0), 0.01);
+  }
+
+  void Measurement()
+  {
+    shared::tBMP180Simulation simulation;
+    shared::tBMP180 bmp180(simulation);
+    bmp180.LoadCalibration();
+
+    // a measurement is collected in the first cycle after the conversion times have passed
+    auto now = rrlib::time::Now();
+    RRLIB_UNIT_TESTS_ASSERT(!bmp180.Process(now, shared::tBMP180OSSMode::tBMP180_OSS_ULTRA_LOW_POWER));
+    RRLIB_UNIT_TESTS_ASSERT(bmp180.GetPhase() == shared::tBMP180Phase::eTEMPERATURE_CONVERSION);
+    RRLIB_UNIT_TESTS_ASSERT(!bmp180.Process(now + std::chrono::milliseconds(1), shared::tBMP180OSSMode::tBMP180_OSS_ULTRA_LOW_POWER));
+    RRLIB_UNIT_TESTS_ASSERT(bmp180.GetPhase() == shared::tBMP180Phase::eTEMPERATURE_CONVERSION);
+    RRLIB_UNIT_TESTS_ASSERT(!bmp180.Process(now + std::chrono::milliseconds(5), shared::tBMP180OSSMode::tBMP180_OSS_ULTRA_LOW_POWER));
+    RRLIB_UNIT_TESTS_ASSERT(bmp180.GetPhase() == shared::tBMP180Phase::ePRESSURE_CONVERSION);
+    RRLIB_UNIT_TESTS_ASSERT(bmp180.Process(now + std::chrono::milliseconds(10), shared::tBMP180OSSMode::tBMP180_OSS_ULTRA_LOW_POWER));
+
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<int16_t>(27898), bmp180.GetRawTemperature());
+    RRLIB_UNIT_TESTS_EQUALITY(23843, bmp180.GetRawPressure());
+    RRLIB_UNIT_TESTS_EQUALITY(69964, bmp180.ComputePressure(bmp180.GetRawPressure(), bmp180.GetRawTemperature(), bmp180.GetPressureMode()));
+  }
+
+  void InvalidCalibration()
+  {
+    // coefficients of 0x0000 or 0xFFFF indicate a failed read and are rejected
+    for (int32_t invalid : {0x0000, 0xFFFF})
+    {
+      shared::tBMP180Simulation simulation;
+      shared::tBMP180 bmp180(simulation);
+      RRLIB_UNIT_TESTS_ASSERT(bmp180.LoadCalibration());
+      simulation.SetCalibration({{408, -72, -14383, 32741, 32757, 23153, 6190, 4, -32768, invalid, 2868}});
+      RRLIB_UNIT_TESTS_ASSERT(!bmp180.LoadCalibration());
+
+      // the valid calibration is kept
+      RRLIB_UNIT_TESTS_EQUALITY(69964, bmp180.ComputePressure(23843, 27898, shared::tBMP180OSSMode::tBMP180_OSS_ULTRA_LOW_POWER));
+    }
+  }
+
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(BMP180);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
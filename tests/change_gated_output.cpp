@@ -0,0 +1,144 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/test/change_gated_output.cpp
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tUnitTestSuite.h"
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include <cassert>
+
+#include "projects/smart_home/shared/tChangeGatedOutput.h"
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace tests
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//! Records all published values
+template<typename T>
+struct tRecordingPort
+{
+  std::vector<std::pair<T, rrlib::time::tTimestamp>> published;
+
+  void Publish(const T & value, const rrlib::time::tTimestamp & timestamp)
+  {
+    published.emplace_back(value, timestamp);
+  }
+};
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+class ChangeGatedOutput : public rrlib::util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(ChangeGatedOutput);
+  RRLIB_UNIT_TESTS_ADD_TEST(ChangesOnly);
+  RRLIB_UNIT_TESTS_ADD_TEST(Heartbeat);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+private:
+
+  void ChangesOnly()
+  {
+    tRecordingPort<int> port;
+    shared::tChangeGatedOutput<int, tRecordingPort<int>> output(port);
+    auto start = rrlib::time::Now();
+
+    // first value is always published, also if it equals the default value
+    RRLIB_UNIT_TESTS_ASSERT(output.Publish(0, start));
+    for (int cycle = 1; cycle < 100; cycle++)
+    {
+      output.Publish(cycle < 50 ? 0 : 7, start + std::chrono::milliseconds(200 * cycle));
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(2), port.published.size());
+    RRLIB_UNIT_TESTS_EQUALITY(7, port.published.back().first);
+    RRLIB_UNIT_TESTS_ASSERT(port.published.back().second == start + std::chrono::milliseconds(200 * 50));
+    RRLIB_UNIT_TESTS_EQUALITY(7, output.Get());
+
+    output.Invalidate();
+    RRLIB_UNIT_TESTS_ASSERT(output.Publish(7, start + std::chrono::seconds(30)));
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(3), port.published.size());
+  }
+
+  void Heartbeat()
+  {
+    tRecordingPort<bool> port;
+    shared::tChangeGatedOutput<bool, tRecordingPort<bool>> output(port, std::chrono::seconds(2));
+    auto start = rrlib::time::Now();
+
+    // 10 s of unchanged values in 200 ms cycles: initial value and a heartbeat every 2 s
+    for (int cycle = 0; cycle <= 50; cycle++)
+    {
+      output.Publish(true, start + std::chrono::milliseconds(200 * cycle));
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(6), port.published.size());
+    for (size_t i = 1; i < port.published.size(); i++)
+    {
+      RRLIB_UNIT_TESTS_ASSERT(port.published[i].second - port.published[i - 1].second == std::chrono::seconds(2));
+    }
+
+    // a change restarts the heartbeat interval
+    output.Publish(false, start + std::chrono::milliseconds(10200));
+    RRLIB_UNIT_TESTS_ASSERT(not output.Publish(false, start + std::chrono::milliseconds(12000)));
+    RRLIB_UNIT_TESTS_ASSERT(output.Publish(false, start + std::chrono::milliseconds(12200)));
+  }
+
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(ChangeGatedOutput);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
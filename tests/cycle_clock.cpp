@@ -0,0 +1,163 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/test/cycle_clock.cpp
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tUnitTestSuite.h"
+#include <thread>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include <cassert>
+
+#include "projects/smart_home/shared/tChangeGatedOutput.h"
+#include "projects/smart_home/shared/tCycleClock.h"
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace tests
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//! Counts published values
+struct tCountingPort
+{
+  size_t count = 0;
+
+  void Publish(bool, const rrlib::time::tTimestamp &)
+  {
+    count++;
+  }
+};
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+class CycleClock : public rrlib::util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(CycleClock);
+  RRLIB_UNIT_TESTS_ADD_TEST(Stepped);
+  RRLIB_UNIT_TESTS_ADD_TEST(Accelerated);
+  RRLIB_UNIT_TESTS_ADD_TEST(DefaultClock);
+  RRLIB_UNIT_TESTS_ADD_TEST(SimulatedWeek);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+private:
+
+  void Stepped()
+  {
+    auto start = rrlib::time::Now() - std::chrono::hours(24 * 365);
+    shared::tSimulatedClock clock(start);
+
+    // without time scale, time only passes via Advance
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    RRLIB_UNIT_TESTS_ASSERT(clock.Now() == start);
+    clock.Advance(std::chrono::minutes(90));
+    RRLIB_UNIT_TESTS_ASSERT(clock.Now() == start + std::chrono::minutes(90));
+    clock.Advance(-std::chrono::minutes(10));
+    RRLIB_UNIT_TESTS_ASSERT(clock.Now() == start + std::chrono::minutes(90));
+  }
+
+  void Accelerated()
+  {
+    auto start = rrlib::time::Now();
+    shared::tSimulatedClock clock(start, 1000.0);
+    auto system_start = rrlib::time::Now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    auto simulated = clock.Now() - start;
+    auto system = rrlib::time::Now() - system_start;
+
+    // at least 20 s simulated, but not more than the scaled system time
+    RRLIB_UNIT_TESTS_ASSERT(simulated >= std::chrono::seconds(20));
+    RRLIB_UNIT_TESTS_ASSERT(simulated <= system * 1000 + std::chrono::milliseconds(1));
+
+    clock.Advance(std::chrono::hours(1));
+    RRLIB_UNIT_TESTS_ASSERT(clock.Now() - start >= std::chrono::hours(1) + simulated);
+  }
+
+  void DefaultClock()
+  {
+    shared::tCycleClock &system_clock = shared::GetCycleClock();
+    auto before = rrlib::time::Now();
+    RRLIB_UNIT_TESTS_ASSERT(system_clock.Now() >= before);
+
+    auto start = rrlib::time::Now() + std::chrono::hours(48);
+    shared::tSimulatedClock clock(start);
+    shared::SetCycleClock(clock);
+    RRLIB_UNIT_TESTS_ASSERT(shared::GetCycleClock().Now() == start);
+    shared::SetCycleClock(system_clock);
+    RRLIB_UNIT_TESTS_ASSERT(shared::GetCycleClock().Now() < start);
+  }
+
+  void SimulatedWeek()
+  {
+    // one week of 200 ms cycles of an unchanged output with 10 s heartbeat
+    shared::tSimulatedClock clock(rrlib::time::Now());
+    tCountingPort port;
+    shared::tChangeGatedOutput<bool, tCountingPort> output(port, std::chrono::seconds(10));
+    const size_t cycles = 7 * 24 * 3600 * 5;
+    auto system_start = rrlib::time::Now();
+    for (size_t i = 0; i < cycles; i++)
+    {
+      output.Publish(true, clock.Now());
+      clock.Advance(std::chrono::milliseconds(200));
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(7 * 24 * 360), port.count);
+    RRLIB_UNIT_TESTS_ASSERT(rrlib::time::Now() - system_start < std::chrono::seconds(10));
+  }
+
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(CycleClock);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
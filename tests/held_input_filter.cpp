@@ -0,0 +1,136 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/test/held_input_filter.cpp
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tUnitTestSuite.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include <cassert>
+
+#include "projects/smart_home/shared/tHeldInputFilter.h"
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace tests
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+static const double cWEIGHT = 0.05;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+class HeldInputFilter : public rrlib::util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(HeldInputFilter);
+  RRLIB_UNIT_TESTS_ADD_TEST(GappedInput);
+  RRLIB_UNIT_TESTS_ADD_TEST(FractionalPeriods);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+private:
+
+  /*!
+   * Input in period i, changes every 7 periods
+   */
+  static double GetInput(int i)
+  {
+    return 20.0 + ((i / 7) % 5) * 3.5;
+  }
+
+  void GappedInput()
+  {
+    // inputs only published every gap periods have to give the same output as one step per period with the input held
+    for (int gap : {1, 2, 5, 25, 64})
+    {
+      double reference = 20.0;
+      double held = 20.0;
+      double filtered = 20.0;
+      double last_input = 20.0;
+      int last_publish = 0;
+      for (int i = 1; i <= 500; i++)
+      {
+        if (i % gap == 0)
+        {
+          held = GetInput(i);
+        }
+        reference = shared::tHeldInputFilter::Step(reference, held, held, cWEIGHT, 1.0);
+        if (i % gap == 0)
+        {
+          filtered = shared::tHeldInputFilter::Step(filtered, last_input, held, cWEIGHT, i - last_publish);
+          last_input = held;
+          last_publish = i;
+          RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(reference, filtered, 1e-9);
+        }
+      }
+    }
+
+    // a late sample only takes one step toward the new value
+    double filtered = shared::tHeldInputFilter::Step(20.0, 20.0, 100.0, cWEIGHT, 100.0);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(20.0 + cWEIGHT * 80.0, filtered, 1e-9);
+  }
+
+  void FractionalPeriods()
+  {
+    // less than one period still takes one step
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(20.0 + cWEIGHT * 10.0, shared::tHeldInputFilter::Step(20.0, 25.0, 30.0, cWEIGHT, 0.5), 1e-9);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(20.0 + cWEIGHT * 10.0, shared::tHeldInputFilter::Step(20.0, 25.0, 30.0, cWEIGHT, 1.0), 1e-9);
+
+    // weight 1 follows the input
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(30.0, shared::tHeldInputFilter::Step(20.0, 25.0, 30.0, 1.0, 12.0), 1e-9);
+  }
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(HeldInputFilter);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
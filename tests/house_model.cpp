@@ -0,0 +1,232 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/test/house_model.cpp
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tUnitTestSuite.h"
+#include <cmath>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include <cassert>
+
+#include "projects/smart_home/heat_control/tHouseModel.h"
+#include "projects/smart_home/heat_control_states/tHeatingCircuits.h"
+#include "projects/smart_home/shared/tCycleClock.h"
+#include "projects/smart_home/shared/tPTLookupTable.h"
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace tests
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+// midnight (UTC), some years after the epoch
+static const rrlib::time::tTimestamp cMIDNIGHT(std::chrono::hours(24 * 20000));
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+class HouseModel : public rrlib::util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(HouseModel);
+  RRLIB_UNIT_TESTS_ADD_TEST(ADValues);
+  RRLIB_UNIT_TESTS_ADD_TEST(Weather);
+  RRLIB_UNIT_TESTS_ADD_TEST(Relaxation);
+  RRLIB_UNIT_TESTS_ADD_TEST(Pumps);
+  RRLIB_UNIT_TESTS_ADD_TEST(ClosedLoopWeek);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+private:
+
+  void ADValues()
+  {
+    // codes of the simulation are converted back by the lookup table of the PT array (about 1 K per code)
+    shared::tPTLookupTable pt100;
+    shared::tPTLookupTable pt1000;
+    pt100.Rebuild<100>(94.0, 5.0);
+    pt1000.Rebuild<1000>(993.0, 5.0);
+    for (double temperature = -20.0; temperature <= 120.0; temperature += 0.7)
+    {
+      RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(temperature, pt100.GetTemperature(heat_control::tHouseModel::GetADValue(temperature, 100.0, 94.0)).ValueFactored(), 1.0);
+      RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(temperature, pt1000.GetTemperature(heat_control::tHouseModel::GetADValue(temperature, 1000.0, 993.0)).ValueFactored(), 1.0);
+    }
+  }
+
+  void Weather()
+  {
+    heat_control::tHouseModel model;
+    model.SetWeather(10.0, 6.0, 800.0);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(4.0, model.GetAmbientTemperature(5.0 * 3600.0), 1E-9);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(16.0, model.GetAmbientTemperature(17.0 * 3600.0), 1E-9);
+    RRLIB_UNIT_TESTS_EQUALITY(0.0, model.GetIrradiance(3.0 * 3600.0));
+    RRLIB_UNIT_TESTS_EQUALITY(0.0, model.GetIrradiance(21.0 * 3600.0));
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(800.0, model.GetIrradiance(13.0 * 3600.0), 1E-9);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(13.0 * 3600.0, heat_control::tHouseModel::GetSecondsOfDay(cMIDNIGHT + std::chrono::hours(24 * 3 + 13)), 1E-9);
+  }
+
+  void Relaxation()
+  {
+    // without sun, furnace and pumps, all nodes approach the ambient and earth temperature monotonically
+    heat_control::tHouseModel model;
+    model.SetWeather(5.0, 0.0, 0.0);
+    model.SetFurnacePower(0.0);
+    double previous_room = model.GetTemperature(shared::eSENSOR_ROOM);
+    auto time = cMIDNIGHT;
+    for (int day = 0; day < 60; day++)
+    {
+      model.Advance(time, std::chrono::hours(24));
+      time += std::chrono::hours(24);
+      double room = model.GetTemperature(shared::eSENSOR_ROOM);
+      RRLIB_UNIT_TESTS_ASSERT(room <= previous_room);
+      previous_room = room;
+      for (std::size_t i = 0; i < heat_control::cHOUSE_SENSOR_COUNT; i++)
+      {
+        double temperature = model.GetTemperature(static_cast<shared::tSensor>(i));
+        RRLIB_UNIT_TESTS_ASSERT(temperature >= 4.999 and temperature <= 55.0);
+      }
+    }
+    RRLIB_UNIT_TESTS_ASSERT(model.GetTemperature(shared::eSENSOR_BOILER_TOP) < 15.0);
+    RRLIB_UNIT_TESTS_ASSERT(model.GetTemperature(shared::eSENSOR_BOILER_BOTTOM) <= model.GetTemperature(shared::eSENSOR_BOILER_MIDDLE));
+    RRLIB_UNIT_TESTS_ASSERT(model.GetTemperature(shared::eSENSOR_BOILER_MIDDLE) <= model.GetTemperature(shared::eSENSOR_BOILER_TOP));
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint64_t>(60 * 24 * 720), model.GetStepCount());
+  }
+
+  void Pumps()
+  {
+    // one hour around noon, each pump moves heat along its circuit
+    auto noon = cMIDNIGHT + std::chrono::hours(12);
+    heat_control::tHouseModel off;
+    off.SetTemperature(shared::eSENSOR_SOLAR, 60.0);
+    off.Advance(noon, std::chrono::hours(1));
+
+    heat_control::tHouseModel solar;
+    solar.SetTemperature(shared::eSENSOR_SOLAR, 60.0);
+    solar.SetPumps(true, false, false);
+    solar.Advance(noon, std::chrono::hours(1));
+    RRLIB_UNIT_TESTS_ASSERT(solar.GetTemperature(shared::eSENSOR_BOILER_BOTTOM) > off.GetTemperature(shared::eSENSOR_BOILER_BOTTOM) + 1.0);
+    RRLIB_UNIT_TESTS_ASSERT(solar.GetTemperature(shared::eSENSOR_SOLAR) < off.GetTemperature(shared::eSENSOR_SOLAR));
+
+    heat_control::tHouseModel room;
+    room.SetPumps(false, true, false);
+    room.Advance(noon, std::chrono::hours(1));
+    RRLIB_UNIT_TESTS_ASSERT(room.GetTemperature(shared::eSENSOR_ROOM) > off.GetTemperature(shared::eSENSOR_ROOM) + 0.5);
+    RRLIB_UNIT_TESTS_ASSERT(room.GetTemperature(shared::eSENSOR_BOILER_TOP) < off.GetTemperature(shared::eSENSOR_BOILER_TOP));
+
+    heat_control::tHouseModel ground;
+    ground.SetPumps(false, false, true);
+    ground.Advance(noon, std::chrono::hours(1));
+    RRLIB_UNIT_TESTS_ASSERT(ground.GetTemperature(shared::eSENSOR_GROUND) > off.GetTemperature(shared::eSENSOR_GROUND) + 0.1);
+    RRLIB_UNIT_TESTS_ASSERT(ground.GetTemperature(shared::eSENSOR_BOILER_MIDDLE) < off.GetTemperature(shared::eSENSOR_BOILER_MIDDLE));
+  }
+
+  void ClosedLoopWeek()
+  {
+    // state machine and house on a stepped simulated clock, one 10 s cycle after another
+    shared::tSimulatedClock clock(cMIDNIGHT);
+    heat_control::tHouseModel model;
+    heat_control_states::tHeatingCircuits circuits;
+    const rrlib::si_units::tCelsius<double> set_point(23.0);
+    const auto cycle = std::chrono::seconds(10);
+
+    std::array<bool, 3> pumps {{false, false, false}};
+    size_t switches = 0;
+    double room_min = 100.0;
+    double room_max = -100.0;
+    double maximum = -100.0;
+    auto system_start = rrlib::time::Now();
+    for (auto time = clock.Now(); time < cMIDNIGHT + std::chrono::hours(7 * 24); time = clock.Now())
+    {
+      circuits.ComputeControlState(shared::tTemperatures(rrlib::si_units::tCelsius<double>(model.GetTemperature(shared::eSENSOR_BOILER_MIDDLE)),
+                                   rrlib::si_units::tCelsius<double>(model.GetTemperature(shared::eSENSOR_ROOM)),
+                                   rrlib::si_units::tCelsius<double>(model.GetTemperature(shared::eSENSOR_SOLAR)),
+                                   rrlib::si_units::tCelsius<double>(model.GetTemperature(shared::eSENSOR_GROUND)),
+                                   set_point));
+      auto settings = circuits.GetPumpSettings();
+      std::array<bool, 3> next {{settings.IsSolarOnline(), settings.IsRoomOnline(), settings.IsGroundOnline()}};
+      for (std::size_t i = 0; i < pumps.size(); i++)
+      {
+        switches += (pumps[i] != next[i]) ? 1 : 0;
+      }
+      pumps = next;
+
+      model.SetPumps(pumps[0], pumps[1], pumps[2]);
+      model.Advance(time, cycle);
+      clock.Advance(cycle);
+
+      // first day warms up the house
+      if (time > cMIDNIGHT + std::chrono::hours(24))
+      {
+        room_min = std::min(room_min, model.GetTemperature(shared::eSENSOR_ROOM));
+        room_max = std::max(room_max, model.GetTemperature(shared::eSENSOR_ROOM));
+      }
+      for (std::size_t i = 0; i < heat_control::cHOUSE_SENSOR_COUNT; i++)
+      {
+        maximum = std::max(maximum, model.GetTemperature(static_cast<shared::tSensor>(i)));
+      }
+    }
+    double system = std::chrono::duration_cast<std::chrono::duration<double>>(rrlib::time::Now() - system_start).count();
+    RRLIB_LOG_PRINT(USER, "Simulated week: room ", room_min, " to ", room_max, " degree Celsius, maximum ", maximum, " degree Celsius, ", switches, " pump switches, ",
+                    (7 * 24 * 3600.0) / std::max(system, 1E-6), "x real time");
+
+    // the controller regards temperatures above 100 degree Celsius as implausible
+    RRLIB_UNIT_TESTS_ASSERT(maximum < 95.0);
+    RRLIB_UNIT_TESTS_ASSERT(room_min > 17.0 and room_max < 26.0);
+    RRLIB_UNIT_TESTS_ASSERT(switches > 14 and switches < 500);
+  }
+
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(HouseModel);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
@@ -0,0 +1,230 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/test/journal.cpp
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tUnitTestSuite.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include <cassert>
+
+#include "projects/smart_home/shared/tAsyncLogWriter.h"
+#include "projects/smart_home/shared/tJournal.h"
+#include "projects/smart_home/tests/test_utils.h"
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace tests
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+class Journal : public rrlib::util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(Journal);
+  RRLIB_UNIT_TESTS_ADD_TEST(GroupCommit);
+  RRLIB_UNIT_TESTS_ADD_TEST(TornTail);
+  RRLIB_UNIT_TESTS_ADD_TEST(ZeroFilledGap);
+  RRLIB_UNIT_TESTS_ADD_TEST(WriterCommitPolicy);
+  RRLIB_UNIT_TESTS_ADD_TEST(FailingDevice);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+private:
+
+  static std::string ReadFile(const std::string &filename)
+  {
+    std::ifstream file(filename, std::ios::binary);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+  }
+
+  static void WriteFile(const std::string &filename, const std::string &content)
+  {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    file << content;
+  }
+
+  void GroupCommit()
+  {
+    std::string filename = TemporaryFilename("journal_commit", ".txt");
+    std::remove(filename.c_str());
+    shared::tJournal journal;
+    RRLIB_UNIT_TESTS_ASSERT(journal.Open(filename));
+    for (int i = 0; i < 100; i++)
+    {
+      std::string line = "line " + std::to_string(i) + "\n";
+      journal.Append(line.data(), line.size());
+    }
+
+    // nothing reaches the file before the commit
+    RRLIB_UNIT_TESTS_ASSERT(ReadFile(filename).empty());
+    RRLIB_UNIT_TESTS_ASSERT(journal.Commit());
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint64_t>(1), journal.GetCommitCount());
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(0), journal.GetPendingSize());
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint64_t>(ReadFile(filename).size()), journal.GetCommittedBytes());
+
+    // empty commits do not touch the file
+    RRLIB_UNIT_TESTS_ASSERT(journal.Commit());
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint64_t>(1), journal.GetCommitCount());
+    journal.Close();
+    std::remove(filename.c_str());
+  }
+
+  void TornTail()
+  {
+    std::string filename = TemporaryFilename("journal_torn", ".txt");
+    WriteFile(filename, "first\nsecond\nthi");
+    shared::tJournal journal;
+    RRLIB_UNIT_TESTS_ASSERT(journal.Open(filename));
+    journal.Append("third\n", 6);
+    journal.Close();
+    RRLIB_UNIT_TESTS_EQUALITY(std::string("first\nsecond\nthird\n"), ReadFile(filename));
+
+    // intact journals are left alone
+    RRLIB_UNIT_TESTS_ASSERT(journal.Open(filename));
+    journal.Close();
+    RRLIB_UNIT_TESTS_EQUALITY(std::string("first\nsecond\nthird\n"), ReadFile(filename));
+    std::remove(filename.c_str());
+  }
+
+  void ZeroFilledGap()
+  {
+    // a torn commit whose blocks were stored out of order
+    std::string filename = TemporaryFilename("journal_gap", ".txt");
+    WriteFile(filename, std::string("first\nsec") + std::string(4100, '\0') + "ond\nthird\n");
+    shared::tJournal journal;
+    RRLIB_UNIT_TESTS_ASSERT(journal.Open(filename));
+    journal.Close();
+    RRLIB_UNIT_TESTS_EQUALITY(std::string("first\n"), ReadFile(filename));
+    std::remove(filename.c_str());
+  }
+
+  void WriterCommitPolicy()
+  {
+    std::string filename = TemporaryFilename("journal_writer", ".txt");
+    std::remove(filename.c_str());
+    shared::tAsyncLogWriter writer(256, 1024, std::chrono::hours(1));
+    RRLIB_UNIT_TESTS_ASSERT(writer.Open(filename));
+
+    // batched lines below the commit size stay in memory
+    for (int i = 0; i < 10; i++)
+    {
+      shared::tLogLine(writer) << "batched " << i << "\n";
+    }
+    std::this_thread::sleep_for(shared::cLOG_WRITER_PERIOD * 4);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint64_t>(0), writer.GetCommitCount());
+    RRLIB_UNIT_TESTS_ASSERT(ReadFile(filename).empty());
+
+    // a durable line commits everything before it
+    shared::tLogLine(writer, shared::eLOG_DURABLE) << "durable\n";
+    std::this_thread::sleep_for(shared::cLOG_WRITER_PERIOD * 4);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint64_t>(1), writer.GetCommitCount());
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint64_t>(11), writer.GetWrittenCount());
+
+    // the commit size bounds the memory used for pending lines
+    for (int i = 0; i < 200; i++)
+    {
+      shared::tLogLine(writer) << "batched line with some more text " << i << "\n";
+      if (i % 50 == 0)
+      {
+        std::this_thread::sleep_for(shared::cLOG_WRITER_PERIOD * 2);
+      }
+    }
+    std::this_thread::sleep_for(shared::cLOG_WRITER_PERIOD * 4);
+    RRLIB_UNIT_TESTS_ASSERT(writer.GetCommitCount() > 1);
+    RRLIB_UNIT_TESTS_ASSERT(writer.GetCommitCount() < 20);
+
+    writer.Close();
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint64_t>(211), writer.GetWrittenCount());
+    std::remove(filename.c_str());
+  }
+
+  void FailingDevice()
+  {
+    // every write to /dev/full fails with ENOSPC
+    shared::tJournal journal(1000);
+    RRLIB_UNIT_TESTS_ASSERT(journal.Open("/dev/full"));
+    for (int i = 0; i < 1000; i++)
+    {
+      std::string line = "line " + std::to_string(i % 10) + "\n";
+      journal.Append(line.data(), line.size());
+      RRLIB_UNIT_TESTS_ASSERT(not journal.Commit());
+      RRLIB_UNIT_TESTS_ASSERT(journal.GetPendingSize() <= 1000);
+    }
+
+    // the newest entries are kept, the oldest are dropped
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(1000 / 7 * 7), journal.GetPendingSize());
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint64_t>(1000 - 1000 / 7), journal.GetDroppedCount());
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint64_t>(0), journal.GetCommittedBytes());
+
+    // entries larger than the limit are dropped on their own
+    std::string long_line(2000, 'x');
+    journal.Append(long_line.data(), long_line.size());
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint64_t>(1000 - 1000 / 7 + 1), journal.GetDroppedCount());
+    journal.Close();
+  }
+
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(Journal);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
@@ -0,0 +1,127 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/test/mcp3008.cpp
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tUnitTestSuite.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include <cassert>
+
+#include "projects/smart_home/shared/tMCP3008.h"
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace tests
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+class MCP3008 : public rrlib::util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(MCP3008);
+  RRLIB_UNIT_TESTS_ADD_TEST(DecimatedValues);
+  RRLIB_UNIT_TESTS_ADD_TEST(Decimation);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+private:
+
+  void DecimatedValues()
+  {
+    shared::tMCP3008 mcp3008(5.0);
+    for (unsigned int bits = 0; bits <= shared::cMCP3008_MAX_OVERSAMPLING_BITS; bits++)
+    {
+      uint32_t maximum = static_cast<uint32_t>(shared::cMCP3008_RESOLUTION - 1) << bits;
+      RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.0, mcp3008.ConvertDecimatedValueToVoltage(0, bits).Value(), 1e-12);
+      RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(5.0, mcp3008.ConvertDecimatedValueToVoltage(maximum, bits).Value(), 1e-12);
+      RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(2.5, mcp3008.ConvertDecimatedValueToVoltage(maximum / 2, bits).Value(), 5.0 / maximum);
+
+      // values beyond the range are limited to the reference voltage
+      RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(5.0, mcp3008.ConvertDecimatedValueToVoltage(maximum + 1, bits).Value(), 1e-12);
+
+      // a constant input gives the same voltage as without oversampling
+      for (unsigned short ad_value = 0; ad_value < shared::cMCP3008_RESOLUTION; ad_value++)
+      {
+        RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(mcp3008.ConvertADValueToVoltage(ad_value).Value(),
+                                         mcp3008.ConvertDecimatedValueToVoltage(static_cast<uint32_t>(ad_value) << bits, bits).Value(), 1e-12);
+      }
+    }
+
+    mcp3008.SetReferenceVoltage(3.3);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(3.3, mcp3008.ConvertDecimatedValueToVoltage(1023 << 2, 2).Value(), 1e-12);
+  }
+
+  void Decimation()
+  {
+    // the sum of 4^n alternating codes shifted right by n resolves the value between them
+    shared::tMCP3008 mcp3008(5.0);
+    for (unsigned int bits = 1; bits <= shared::cMCP3008_MAX_OVERSAMPLING_BITS; bits++)
+    {
+      uint32_t samples = 1u << (2 * bits);
+      uint32_t sum = 0;
+      for (uint32_t i = 0; i < samples; i++)
+      {
+        sum += 511 + (i % 2);
+      }
+      double expected = (mcp3008.ConvertADValueToVoltage(511).Value() + mcp3008.ConvertADValueToVoltage(512).Value()) / 2.0;
+      RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(expected, mcp3008.ConvertDecimatedValueToVoltage(sum >> bits, bits).Value(), 1e-9);
+    }
+  }
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(MCP3008);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
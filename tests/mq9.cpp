@@ -0,0 +1,151 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/test/mq9.cpp
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tUnitTestSuite.h"
+#include <cmath>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include <cassert>
+
+#include "projects/smart_home/shared/tMQ9.h"
+#include "projects/smart_home/shared/tSlidingWindowMaximum.h"
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace tests
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+class MQ9 : public rrlib::util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(MQ9);
+  RRLIB_UNIT_TESTS_ADD_TEST(CharacteristicCurves);
+  RRLIB_UNIT_TESTS_ADD_TEST(ConcentrationTables);
+  RRLIB_UNIT_TESTS_ADD_TEST(Baseline);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+private:
+
+  void CharacteristicCurves()
+  {
+    // curves pass through the points of the data sheet
+    for (auto & point : shared::cMQ9_CURVE_CARBON_MONOXIDE)
+    {
+      RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(point.concentration, shared::tMQ9::InterpolateCurve(shared::cMQ9_CURVE_CARBON_MONOXIDE, point.ratio), 0.001);
+    }
+    for (auto & point : shared::cMQ9_CURVE_METHANE)
+    {
+      RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(point.concentration, shared::tMQ9::InterpolateCurve(shared::cMQ9_CURVE_METHANE, point.ratio), 0.001);
+    }
+
+    // concentration decreases with increasing resistance
+    RRLIB_UNIT_TESTS_ASSERT(shared::tMQ9::InterpolateCurve(shared::cMQ9_CURVE_CARBON_MONOXIDE, shared::cMQ9_CLEAN_AIR_RATIO) < 10.0);
+    RRLIB_UNIT_TESTS_ASSERT(shared::tMQ9::InterpolateCurve(shared::cMQ9_CURVE_CARBON_MONOXIDE, 0.5) > 2000.0);
+  }
+
+  void ConcentrationTables()
+  {
+    shared::tMQ9 mq9;
+    for (double ratio = shared::cMQ9_TABLE_MIN_RATIO; ratio < shared::cMQ9_TABLE_MAX_RATIO; ratio += 0.0123)
+    {
+      double carbon_monoxide = shared::tMQ9::InterpolateCurve(shared::cMQ9_CURVE_CARBON_MONOXIDE, ratio);
+      double methane = shared::tMQ9::InterpolateCurve(shared::cMQ9_CURVE_METHANE, ratio);
+      RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(carbon_monoxide, mq9.GetConcentration(shared::tMQ9Gas::eCARBON_MONOXIDE, ratio), carbon_monoxide * 0.005);
+      RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(methane, mq9.GetConcentration(shared::tMQ9Gas::eMETHANE, ratio), methane * 0.005);
+    }
+
+    // ratios outside of the tables are clamped
+    RRLIB_UNIT_TESTS_EQUALITY(mq9.GetConcentration(shared::tMQ9Gas::eCARBON_MONOXIDE, shared::cMQ9_TABLE_MIN_RATIO), mq9.GetConcentration(shared::tMQ9Gas::eCARBON_MONOXIDE, 0.01));
+    RRLIB_UNIT_TESTS_EQUALITY(mq9.GetConcentration(shared::tMQ9Gas::eCARBON_MONOXIDE, shared::cMQ9_TABLE_MAX_RATIO), mq9.GetConcentration(shared::tMQ9Gas::eCARBON_MONOXIDE, 100.0));
+  }
+
+  void Baseline()
+  {
+    shared::tSlidingWindowMaximum baseline(std::chrono::hours(1), 60);
+    auto start = rrlib::time::Now();
+
+    // clean air for ten minutes, afterwards gas lowers the resistance
+    for (int i = 0; i < 600; i++)
+    {
+      baseline.Add(100.0 + (i % 7), start + std::chrono::seconds(i));
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(106.0, baseline.GetMaximum());
+    for (int i = 600; i < 3600; i++)
+    {
+      baseline.Add(50.0, start + std::chrono::seconds(i));
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(106.0, baseline.GetMaximum());
+
+    // clean air leaves the window after one hour
+    for (int i = 3600; i < 4300; i++)
+    {
+      baseline.Add(50.0 - (i - 3600) * 0.01, start + std::chrono::seconds(i));
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(50.0, baseline.GetMaximum());
+
+    baseline.Clear();
+    baseline.Add(42.0, start + std::chrono::seconds(5000));
+    RRLIB_UNIT_TESTS_EQUALITY(42.0, baseline.GetMaximum());
+  }
+
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(MQ9);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
@@ -34,6 +34,7 @@
 #include "rrlib/util/tUnitTestSuite.h"
 #include <memory>
 #include <iostream>
+#include <vector>
 
 //----------------------------------------------------------------------
 // Internal includes with ""
@@ -41,6 +42,7 @@
 #include <cassert>
 
 #include "projects/smart_home/shared/tPT.h"
+#include "projects/smart_home/shared/tPTLookupTable.h"
 
 //----------------------------------------------------------------------
 // Namespace usage
@@ -71,6 +73,8 @@ class PT1000 : public rrlib::util::tUnitTestSuite
 {
   RRLIB_UNIT_TESTS_BEGIN_SUITE(PT1000);
   RRLIB_UNIT_TESTS_ADD_TEST(Coversions);
+  RRLIB_UNIT_TESTS_ADD_TEST(LookupTable);
+  RRLIB_UNIT_TESTS_ADD_TEST(BatchConversions);
   RRLIB_UNIT_TESTS_END_SUITE;
 
 private:
@@ -121,6 +125,82 @@ private:
 
   }
 
+  void LookupTable()
+  {
+    shared::tPT100 pt100;
+    shared::tPTLookupTable table;
+    shared::tMCP3008 mcp3008(5.0);
+    rrlib::si_units::tVoltage<double> reference_voltage(5.0);
+    rrlib::si_units::tElectricResistance<double> pre_resistance(94.0);
+    table.Rebuild<100>(pre_resistance, reference_voltage);
+
+    // every code has to match the direct conversion chain
+    for (unsigned short i = 0; i < shared::cMCP3008_RESOLUTION; i++)
+    {
+      auto voltage = mcp3008.ConvertADValueToVoltage(i);
+      auto expected = pt100.GetTemperature(shared::tPTLookupTable::GetResistance(voltage, reference_voltage, pre_resistance)).ValueFactored();
+      if (std::isnan(expected))
+      {
+        RRLIB_UNIT_TESTS_ASSERT(std::isnan(table.GetTemperature(i).ValueFactored()));
+        continue;
+      }
+      RRLIB_UNIT_TESTS_EQUALITY(expected, table.GetTemperature(i).ValueFactored());
+      RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(expected, table.GetTemperature(voltage).ValueFactored(), 0.001);
+    }
+
+    // voltages between two codes are interpolated
+    auto lower = table.GetTemperature(static_cast<unsigned short>(510)).ValueFactored();
+    auto upper = table.GetTemperature(static_cast<unsigned short>(511)).ValueFactored();
+    auto between = table.GetTemperature(mcp3008.ConvertADValueToVoltage(510) + (mcp3008.ConvertADValueToVoltage(511) - mcp3008.ConvertADValueToVoltage(510)) * 0.5).ValueFactored();
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE((lower + upper) / 2.0, between, 0.001);
+
+    // rebuilding with a different pre resistance changes the table
+    table.Rebuild<100>(rrlib::si_units::tElectricResistance<double>(92.4), reference_voltage);
+    RRLIB_UNIT_TESTS_ASSERT(table.GetTemperature(static_cast<unsigned short>(510)).ValueFactored() != lower);
+  }
+
+  void BatchConversions()
+  {
+    shared::tPT1000 pt1000;
+    shared::tPT100 pt100;
+
+    // odd count so that the scalar tail is used as well
+    std::vector<double> temperatures;
+    for (double t = -250.0; t < 900.0; t += 0.7)
+    {
+      temperatures.push_back(t);
+    }
+    temperatures.push_back(0.0);
+    temperatures.push_back(50.0);
+    if (temperatures.size() % 2 == 0)
+    {
+      temperatures.push_back(13.3);
+    }
+
+    std::vector<double> resistances(temperatures.size());
+    std::vector<double> estimates(temperatures.size());
+
+    pt1000.GetResistances(temperatures.data(), resistances.data(), temperatures.size());
+    pt1000.GetTemperatures(resistances.data(), estimates.data(), resistances.size());
+    for (std::size_t i = 0; i < temperatures.size(); i++)
+    {
+      RRLIB_UNIT_TESTS_EQUALITY(pt1000.GetResistance(rrlib::si_units::tCelsius<double>(temperatures[i])).Value(), resistances[i]);
+      RRLIB_UNIT_TESTS_EQUALITY(pt1000.GetTemperature(rrlib::si_units::tElectricResistance<double>(resistances[i])).ValueFactored(), estimates[i]);
+    }
+
+    pt100.GetResistances(temperatures.data(), resistances.data(), temperatures.size());
+    pt100.GetTemperatures(resistances.data(), estimates.data(), resistances.size());
+    for (std::size_t i = 0; i < temperatures.size(); i++)
+    {
+      RRLIB_UNIT_TESTS_EQUALITY(pt100.GetResistance(rrlib::si_units::tCelsius<double>(temperatures[i])).Value(), resistances[i]);
+      RRLIB_UNIT_TESTS_EQUALITY(pt100.GetTemperature(rrlib::si_units::tElectricResistance<double>(resistances[i])).ValueFactored(), estimates[i]);
+      if (temperatures[i] > -50.0 and temperatures[i] < 850.0)
+      {
+        RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(temperatures[i], estimates[i], 0.1);
+      }
+    }
+  }
+
 };
 
 RRLIB_UNIT_TESTS_REGISTER_SUITE(PT1000);
@@ -0,0 +1,204 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/test/sensor_frame.cpp
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tUnitTestSuite.h"
+#include <cmath>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include <cassert>
+
+#include "projects/smart_home/shared/tSensorFrame.h"
+#include "projects/smart_home/shared/tSensorHealth.h"
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace tests
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+class SensorFrame : public rrlib::util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(SensorFrame);
+  RRLIB_UNIT_TESTS_ADD_TEST(Layout);
+  RRLIB_UNIT_TESTS_ADD_TEST(FixedPoint);
+  RRLIB_UNIT_TESTS_ADD_TEST(Flags);
+  RRLIB_UNIT_TESTS_ADD_TEST(Serialization);
+  RRLIB_UNIT_TESTS_ADD_TEST(Health);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+private:
+
+  void Layout()
+  {
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(64), sizeof(shared::tSensorFrame));
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(64), alignof(shared::tSensorFrame));
+
+    shared::tSensorFrame frame;
+    for (int i = 0; i < shared::eSENSOR_FRAME_COUNT; i++)
+    {
+      RRLIB_UNIT_TESTS_ASSERT(std::isnan(frame.GetTemperature(static_cast<shared::tSensor>(i)).ValueFactored()));
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(0, static_cast<int>(frame.GetValidMask()));
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(20.0, frame.GetRoomSetPoint().ValueFactored(), 1e-9);
+  }
+
+  void FixedPoint()
+  {
+    shared::tSensorFrame frame;
+    frame.SetTemperature(shared::eSENSOR_SOLAR, rrlib::si_units::tCelsius<double>(-12.344));
+    frame.SetTemperature(shared::eSENSOR_BOILER_MIDDLE, rrlib::si_units::tCelsius<double>(54.995));
+    frame.SetTemperature(shared::eSENSOR_FURNACE, rrlib::si_units::tCelsius<double>(1000.0));
+    frame.SetTemperature(shared::eSENSOR_GARAGE, rrlib::si_units::tCelsius<double>(-1000.0));
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(-12.34, frame.GetTemperature(shared::eSENSOR_SOLAR).ValueFactored(), 1e-9);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(55.0, frame.GetTemperature(shared::eSENSOR_BOILER_MIDDLE).ValueFactored(), 1e-9);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(327.67, frame.GetTemperature(shared::eSENSOR_FURNACE).ValueFactored(), 1e-9);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(-327.67, frame.GetTemperature(shared::eSENSOR_GARAGE).ValueFactored(), 1e-9);
+
+    // every centi degree of the plausible range survives the round trip
+    for (int centi_degree = -4000; centi_degree <= 15000; centi_degree++)
+    {
+      frame.SetTemperature(shared::eSENSOR_ROOM, rrlib::si_units::tCelsius<double>(centi_degree / 100.0));
+      RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(centi_degree / 100.0, frame.GetTemperature(shared::eSENSOR_ROOM).ValueFactored(), 1e-9);
+    }
+
+    frame.SetTemperature(shared::eSENSOR_GROUND, rrlib::si_units::tCelsius<double>(20.0));
+    frame.SetRoomSetPoint(rrlib::si_units::tCelsius<double>(21.5));
+    auto temperatures = frame.GetTemperatures(rrlib::si_units::tCelsius<double>(19.0));
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(55.0, temperatures.GetBoiler().ValueFactored(), 1e-9);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(19.0, temperatures.GetRoom().ValueFactored(), 1e-9);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(-12.34, temperatures.GetSolar().ValueFactored(), 1e-9);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(20.0, temperatures.GetGround().ValueFactored(), 1e-9);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(21.5, temperatures.GetRoomSetPoint().ValueFactored(), 1e-9);
+  }
+
+  void Flags()
+  {
+    shared::tSensorFrame frame;
+    frame.SetTemperature(shared::eSENSOR_ROOM, rrlib::si_units::tCelsius<double>(21.0));
+    frame.SetTemperature(shared::eSENSOR_ROOM_EXTERNAL, rrlib::si_units::tCelsius<double>(21.0));
+    frame.SetTemperature(shared::eSENSOR_SOLAR, rrlib::si_units::tCelsius<double>(NAN));
+    RRLIB_UNIT_TESTS_ASSERT(frame.IsValid(shared::eSENSOR_ROOM));
+    RRLIB_UNIT_TESTS_ASSERT(not frame.IsValid(shared::eSENSOR_SOLAR));
+    RRLIB_UNIT_TESTS_EQUALITY((1 << shared::eSENSOR_ROOM) | (1 << shared::eSENSOR_ROOM_EXTERNAL), static_cast<int>(frame.GetValidMask()));
+
+    frame.SetOutdated(shared::eSENSOR_ROOM_EXTERNAL, true);
+    frame.SetImplausible(shared::eSENSOR_ROOM, true);
+    frame.SetImplausible(shared::eSENSOR_ROOM, false);
+    RRLIB_UNIT_TESTS_ASSERT(frame.IsOutdated(shared::eSENSOR_ROOM_EXTERNAL));
+    RRLIB_UNIT_TESTS_ASSERT(not frame.IsImplausible(shared::eSENSOR_ROOM));
+    RRLIB_UNIT_TESTS_ASSERT(frame.IsUsable(1 << shared::eSENSOR_ROOM));
+    RRLIB_UNIT_TESTS_ASSERT(not frame.IsUsable((1 << shared::eSENSOR_ROOM) | (1 << shared::eSENSOR_ROOM_EXTERNAL)));
+    RRLIB_UNIT_TESTS_ASSERT(not frame.IsUsable(1 << shared::eSENSOR_SOLAR));
+  }
+
+  void Serialization()
+  {
+    shared::tSensorFrame frame;
+    frame.SetTimestamp(rrlib::time::Now());
+    for (int i = 0; i < shared::eSENSOR_FRAME_COUNT; i++)
+    {
+      frame.SetTemperature(static_cast<shared::tSensor>(i), rrlib::si_units::tCelsius<double>(10.0 * i - 20.01));
+    }
+    frame.SetTemperature(shared::eSENSOR_GARAGE, rrlib::si_units::tCelsius<double>(NAN));
+    frame.SetRoomSetPoint(rrlib::si_units::tCelsius<double>(22.5));
+    frame.SetOutdated(shared::eSENSOR_FURNACE, true);
+    frame.SetImplausible(shared::eSENSOR_SOLAR, true);
+
+    rrlib::serialization::tMemoryBuffer buffer;
+    rrlib::serialization::tOutputStream output(buffer);
+    output << frame;
+    output.Close();
+
+    shared::tSensorFrame copy;
+    rrlib::serialization::tInputStream input(buffer);
+    input >> copy;
+
+    RRLIB_UNIT_TESTS_ASSERT(frame.GetTimestamp() == copy.GetTimestamp());
+    for (int i = 0; i < shared::eSENSOR_FRAME_COUNT; i++)
+    {
+      auto expected = frame.GetTemperature(static_cast<shared::tSensor>(i)).ValueFactored();
+      auto actual = copy.GetTemperature(static_cast<shared::tSensor>(i)).ValueFactored();
+      RRLIB_UNIT_TESTS_ASSERT(expected == actual or (std::isnan(expected) and std::isnan(actual)));
+    }
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(22.5, copy.GetRoomSetPoint().ValueFactored(), 1e-9);
+    RRLIB_UNIT_TESTS_EQUALITY(frame.GetValidMask(), copy.GetValidMask());
+    RRLIB_UNIT_TESTS_EQUALITY(frame.GetOutdatedMask(), copy.GetOutdatedMask());
+    RRLIB_UNIT_TESTS_EQUALITY(frame.GetImplausibleMask(), copy.GetImplausibleMask());
+  }
+
+  void Health()
+  {
+    shared::tSensorHealth healthy;
+    RRLIB_UNIT_TESTS_ASSERT(healthy.IsHealthy());
+    RRLIB_UNIT_TESTS_EQUALITY(std::string(""), healthy.ToString());
+
+    shared::tSensorHealth health((1 << shared::eSENSOR_BOILER_TOP) | (1 << shared::eSENSOR_ROOM_EXTERNAL));
+    RRLIB_UNIT_TESTS_ASSERT(not health.IsHealthy());
+    RRLIB_UNIT_TESTS_ASSERT(health.IsFlagged(shared::eSENSOR_BOILER_TOP));
+    RRLIB_UNIT_TESTS_ASSERT(not health.IsFlagged(shared::eSENSOR_BOILER_MIDDLE));
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(2), health.GetFlaggedSensors().size());
+    RRLIB_UNIT_TESTS_EQUALITY(std::string("Boiler Top; Room External"), health.ToString());
+    RRLIB_UNIT_TESTS_EQUALITY(std::string("Boiler Top, Room External"), health.ToString(", "));
+  }
+
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(SensorFrame);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
@@ -0,0 +1,195 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/test/sensor_supervision.cpp
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tUnitTestSuite.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include <cassert>
+
+#include "projects/smart_home/heat_control/tSensorSupervision.h"
+#include "projects/smart_home/shared/tCycleClock.h"
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace tests
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+static const rrlib::time::tTimestamp cSTART(std::chrono::duration_cast<rrlib::time::tTimestamp::duration>(std::chrono::hours(24 * 20000)));
+
+static const rrlib::time::tDuration cCYCLE = std::chrono::milliseconds(200);
+
+static const rrlib::time::tDuration cMAX_UPDATE_DURATION = std::chrono::seconds(10);
+
+// cycles between two publishes of an unchanged channel (refresh interval of mMCP3008)
+static const int cREFRESH_CYCLES = 25;
+
+static const uint8_t cSOLAR_PUMP = 1;
+
+// speed of simulated time relative to the system time of the sensor timestamps
+static const int cTIME_SCALE = 600;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+class SensorSupervision : public rrlib::util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(SensorSupervision);
+  RRLIB_UNIT_TESTS_ADD_TEST(ConstantImplausibleReading);
+  RRLIB_UNIT_TESTS_ADD_TEST(Recovery);
+  RRLIB_UNIT_TESTS_ADD_TEST(Outdated);
+  RRLIB_UNIT_TESTS_ADD_TEST(ScaledClock);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+private:
+
+  /*!
+   * Runs one control cycle with a solar sensor (bounds -40 to 150 degree Celsius)
+   */
+  static void RunCycle(heat_control::tSensorSupervision &supervision, int cycle, bool new_reading, double temperature, const rrlib::time::tTimestamp &reading_time)
+  {
+    auto now = cSTART + cycle * cCYCLE;
+    supervision.StartCycle(new_reading);
+    supervision.Check(0, temperature, reading_time, now, cMAX_UPDATE_DURATION, -40.0, 150.0, cSOLAR_PUMP);
+  }
+
+  void ConstantImplausibleReading()
+  {
+    // the channel is held at an implausible value, so it is only published every refresh interval
+    heat_control::tSensorSupervision supervision;
+    rrlib::time::tTimestamp reading_time = cSTART;
+    for (int cycle = 0; cycle < 10 * cREFRESH_CYCLES; cycle++)
+    {
+      bool new_reading = (cycle % cREFRESH_CYCLES) == 0;
+      if (new_reading)
+      {
+        reading_time = cSTART + cycle * cCYCLE;
+      }
+      RunCycle(supervision, cycle, new_reading, 200.0, reading_time);
+      RRLIB_UNIT_TESTS_ASSERT(supervision.IsImplausible(1));
+      RRLIB_UNIT_TESTS_ASSERT(not supervision.IsOutdated(1));
+      RRLIB_UNIT_TESTS_EQUALITY(cSOLAR_PUMP, supervision.GetPumpErrorMask());
+    }
+  }
+
+  void Recovery()
+  {
+    heat_control::tSensorSupervision supervision;
+    RunCycle(supervision, 0, true, 200.0, cSTART);
+    RunCycle(supervision, 1, false, 200.0, cSTART);
+    RRLIB_UNIT_TESTS_ASSERT(supervision.IsImplausible(1));
+
+    // only a new plausible reading clears the sensor
+    RunCycle(supervision, 2, true, 60.0, cSTART + 2 * cCYCLE);
+    RRLIB_UNIT_TESTS_ASSERT(not supervision.IsImplausible(1));
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint8_t>(0), supervision.GetPumpErrorMask());
+    RunCycle(supervision, 3, false, 60.0, cSTART + 2 * cCYCLE);
+    RRLIB_UNIT_TESTS_ASSERT(not supervision.IsImplausible(1));
+  }
+
+  void Outdated()
+  {
+    // without publishes, the sensor becomes outdated after the maximum update duration
+    heat_control::tSensorSupervision supervision;
+    int cycles = static_cast<int>(cMAX_UPDATE_DURATION / cCYCLE);
+    RunCycle(supervision, 0, true, 60.0, cSTART);
+    for (int cycle = 1; cycle <= cycles; cycle++)
+    {
+      RunCycle(supervision, cycle, false, 60.0, cSTART);
+      RRLIB_UNIT_TESTS_ASSERT(not supervision.IsOutdated(1));
+    }
+    RunCycle(supervision, cycles + 1, false, 60.0, cSTART);
+    RRLIB_UNIT_TESTS_ASSERT(supervision.IsOutdated(1));
+    RRLIB_UNIT_TESTS_EQUALITY(cSOLAR_PUMP, supervision.GetPumpErrorMask());
+    RRLIB_UNIT_TESTS_ASSERT(not supervision.IsImplausible(1));
+  }
+
+  void ScaledClock()
+  {
+    // the cycle clock runs on accelerated simulated time, the sensor stamps its readings with system time
+    shared::tSimulatedClock clock(cSTART, 0.0);
+    const rrlib::time::tTimestamp system_start = cSTART - std::chrono::hours(72);
+    heat_control::tSensorSupervision supervision;
+    rrlib::time::tTimestamp reading_time = rrlib::time::cNO_TIME;
+    int cycle = 0;
+    for (; cycle < 20 * cREFRESH_CYCLES; cycle++)
+    {
+      if ((cycle % cREFRESH_CYCLES) == 0)
+      {
+        reading_time = system_start + cycle * cCYCLE / cTIME_SCALE;
+      }
+      supervision.StartCycle((cycle % cREFRESH_CYCLES) == 0);
+      supervision.Check(0, 60.0, reading_time, clock.Now(), cMAX_UPDATE_DURATION, -40.0, 150.0, cSOLAR_PUMP);
+      RRLIB_UNIT_TESTS_ASSERT(not supervision.IsOutdated(1));
+      RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint8_t>(0), supervision.GetPumpErrorMask());
+      clock.Advance(cCYCLE);
+    }
+
+    // without new readings, the sensor becomes outdated after the maximum update duration of simulated time
+    int last_reading = cycle - cREFRESH_CYCLES;
+    int cycles = static_cast<int>(cMAX_UPDATE_DURATION / cCYCLE);
+    for (; cycle <= last_reading + cycles + 1; cycle++)
+    {
+      supervision.StartCycle(false);
+      supervision.Check(0, 60.0, reading_time, clock.Now(), cMAX_UPDATE_DURATION, -40.0, 150.0, cSOLAR_PUMP);
+      RRLIB_UNIT_TESTS_EQUALITY(cycle > last_reading + cycles, supervision.IsOutdated(1));
+      clock.Advance(cCYCLE);
+    }
+  }
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(SensorSupervision);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
@@ -33,7 +33,10 @@
 //----------------------------------------------------------------------
 #include "rrlib/util/tUnitTestSuite.h"
 #include <memory>
+#include <cmath>
 #include <iostream>
+#include <random>
+#include <vector>
 
 //----------------------------------------------------------------------
 // Internal includes with ""
@@ -48,6 +51,8 @@
 #include "projects/smart_home/heat_control_states/tGroundSolar.h"
 #include "projects/smart_home/heat_control_states/tRoomSolar.h"
 #include "projects/smart_home/heat_control_states/tGroundRoomSolar.h"
+#include "projects/smart_home/heat_control_states/tStateMachine.h"
+#include "projects/smart_home/heat_control_states/tHeatingCircuits.h"
 
 //----------------------------------------------------------------------
 // Namespace usage
@@ -80,6 +85,10 @@ class StateMachine : public rrlib::util::tUnitTestSuite
   RRLIB_UNIT_TESTS_ADD_TEST(Functions);
   RRLIB_UNIT_TESTS_ADD_TEST(PumpValues);
   RRLIB_UNIT_TESTS_ADD_TEST(StateChange);
+  RRLIB_UNIT_TESTS_ADD_TEST(TransitionTable);
+  RRLIB_UNIT_TESTS_ADD_TEST(Circuits);
+  RRLIB_UNIT_TESTS_ADD_TEST(CircuitInterlocks);
+  RRLIB_UNIT_TESTS_ADD_TEST(Batch);
   RRLIB_UNIT_TESTS_END_SUITE;
 
 private:
@@ -240,6 +249,205 @@ private:
     }
     RRLIB_UNIT_TESTS_EQUALITY(static_cast<int>(heat_control_states::tCurrentState::eREADY), static_cast<int>(state->GetCurrentState()));
   }
+
+  std::unique_ptr<heat_control_states::tState> CreateState(heat_control_states::tCurrentState state)
+  {
+    switch (state)
+    {
+    case heat_control_states::tCurrentState::eSOLAR:
+      return std::unique_ptr<heat_control_states::tState>(new heat_control_states::tSolar());
+    case heat_control_states::tCurrentState::eROOM:
+      return std::unique_ptr<heat_control_states::tState>(new heat_control_states::tRoom());
+    case heat_control_states::tCurrentState::eGROUND:
+      return std::unique_ptr<heat_control_states::tState>(new heat_control_states::tGround());
+    case heat_control_states::tCurrentState::eSOLAR_ROOM:
+      return std::unique_ptr<heat_control_states::tState>(new heat_control_states::tRoomSolar());
+    case heat_control_states::tCurrentState::eSOLAR_GROUND:
+      return std::unique_ptr<heat_control_states::tState>(new heat_control_states::tGroundSolar());
+    case heat_control_states::tCurrentState::eROOM_GROUND:
+      return std::unique_ptr<heat_control_states::tState>(new heat_control_states::tRoomGround());
+    case heat_control_states::tCurrentState::eSOLAR_ROOM_GROUND:
+      return std::unique_ptr<heat_control_states::tState>(new heat_control_states::tGroundRoomSolar());
+    case heat_control_states::tCurrentState::eREADY:
+    default:
+      return std::unique_ptr<heat_control_states::tState>(new heat_control_states::tReady());
+    }
+  }
+
+  void TransitionTable()
+  {
+    // temperatures around all thresholds (including exact hits) and an invalid value
+    std::vector<double> values = { -10.0, 0.0, 20.0, std::nan("") };
+    for (double t = 42.0; t <= 56.0; t += 1.0)
+    {
+      values.push_back(t);
+    }
+    std::vector<double> set_points = { 19.5, 19.9, 19.95, 20.0, 20.5, 21.0 };
+
+    for (std::size_t s = 0; s < heat_control_states::cSTATE_COUNT; s++)
+    {
+      auto current = static_cast<heat_control_states::tCurrentState>(s);
+
+      // pump settings
+      auto pumps = CreateState(current)->GetPumpSettings();
+      auto table_pumps = heat_control_states::tStateMachine::GetPumpSettings(current);
+      RRLIB_UNIT_TESTS_EQUALITY(pumps.IsGroundOnline(), table_pumps.IsGroundOnline());
+      RRLIB_UNIT_TESTS_EQUALITY(pumps.IsRoomOnline(), table_pumps.IsRoomOnline());
+      RRLIB_UNIT_TESTS_EQUALITY(pumps.IsSolarOnline(), table_pumps.IsSolarOnline());
+
+      // transitions
+      for (double boiler : values)
+      {
+        for (double solar : values)
+        {
+          for (double ground : values)
+          {
+            for (double room : { 15.0, 19.5, 19.9, 20.0, 44.0, 48.0, std::nan("") })
+            {
+              for (double room_set_point : set_points)
+              {
+                shared::tTemperatures temperatures(boiler, room, solar, ground, room_set_point);
+
+                auto state = CreateState(current);
+                std::unique_ptr<heat_control_states::tState> new_state;
+                state->ComputeControlState(new_state, temperatures);
+                auto expected = state->HasChanged() ? new_state->GetCurrentState() : current;
+
+                heat_control_states::tStateMachine state_machine(current);
+                RRLIB_UNIT_TESTS_EQUALITY(state->HasChanged(), state_machine.ComputeControlState(temperatures));
+                RRLIB_UNIT_TESTS_EQUALITY(static_cast<int>(expected), static_cast<int>(state_machine.GetCurrentState()));
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  void Circuits()
+  {
+    // every state and every combination of conditions
+    for (std::size_t s = 0; s < heat_control_states::cSTATE_COUNT; s++)
+    {
+      auto current = static_cast<heat_control_states::tCurrentState>(s);
+      heat_control_states::tHeatingCircuits circuits;
+      circuits.SetCurrentState(current);
+      RRLIB_UNIT_TESTS_EQUALITY(static_cast<int>(current), static_cast<int>(circuits.GetCurrentState()));
+
+      auto pumps = circuits.GetPumpSettings();
+      auto table_pumps = heat_control_states::tStateMachine::GetPumpSettings(current);
+      RRLIB_UNIT_TESTS_EQUALITY(pumps.IsGroundOnline(), table_pumps.IsGroundOnline());
+      RRLIB_UNIT_TESTS_EQUALITY(pumps.IsRoomOnline(), table_pumps.IsRoomOnline());
+      RRLIB_UNIT_TESTS_EQUALITY(pumps.IsSolarOnline(), table_pumps.IsSolarOnline());
+
+      for (uint32_t conditions = 0; conditions < (1 << 14); conditions++)
+      {
+        auto running = circuits.GetRunningCircuits();
+        auto next = heat_control_states::tHeatingCircuitPriority::GetNext(conditions, running);
+        auto expected = heat_control_states::tStateMachine::GetNextState(current, conditions);
+        RRLIB_UNIT_TESTS_EQUALITY(static_cast<int>(expected), static_cast<int>(heat_control_states::cCIRCUIT_STATES[next]));
+      }
+    }
+  }
+
+  //! Additional circuit that never switches by itself
+  struct tDummyRule
+  {
+    static constexpr heat_control_states::tCircuitSet cCIRCUIT = 1 << 3;
+
+    static inline bool Start(uint16_t, heat_control_states::tCircuitSet)
+    {
+      return false;
+    }
+
+    static inline bool Stop(uint16_t, heat_control_states::tCircuitSet)
+    {
+      return false;
+    }
+
+    static inline heat_control_states::tCircuitSet OnStart(heat_control_states::tCircuitSet running)
+    {
+      return running | cCIRCUIT;
+    }
+  };
+
+  void CircuitInterlocks()
+  {
+    // a running additional circuit leaves the switching of the other circuits unchanged
+    typedef heat_control_states::tCircuitPriority<heat_control_states::tCircuitController<heat_control_states::tSolarRule>,
+            heat_control_states::tCircuitController<heat_control_states::tRoomRule>, heat_control_states::tCircuitController<heat_control_states::tGroundRule>,
+            heat_control_states::tCircuitController<tDummyRule>> tExtendedPriority;
+    for (heat_control_states::tCircuitSet running = 0; running < heat_control_states::cSTATE_COUNT; running++)
+    {
+      bool equal = true;
+      for (uint32_t conditions = 0; conditions < (1 << heat_control_states::cCONDITION_COUNT); conditions++)
+      {
+        auto expected = heat_control_states::tHeatingCircuitPriority::GetNext(conditions, running);
+        equal &= tExtendedPriority::GetNext(conditions, running) == expected;
+        equal &= tExtendedPriority::GetNext(conditions, running | tDummyRule::cCIRCUIT) == (expected | tDummyRule::cCIRCUIT);
+      }
+      RRLIB_UNIT_TESTS_ASSERT(equal);
+    }
+  }
+
+  void Batch()
+  {
+    // odd row count to cover a partial block, temperatures in half degrees to hit the thresholds
+    const std::size_t cROWS = 100003;
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> half_degrees(0, 180);
+    std::uniform_int_distribution<int> states(0, heat_control_states::cSTATE_COUNT - 1);
+
+    std::vector<double> boiler(cROWS), room(cROWS), solar(cROWS), ground(cROWS), set_point(cROWS);
+    std::vector<heat_control_states::tCurrentState> state(cROWS);
+    for (std::size_t i = 0; i < cROWS; i++)
+    {
+      boiler[i] = 0.5 * half_degrees(random);
+      room[i] = 0.5 * half_degrees(random);
+      solar[i] = 0.5 * half_degrees(random);
+      ground[i] = 0.5 * half_degrees(random);
+      set_point[i] = 19.0 + 0.1 * (i % 20);
+      state[i] = static_cast<heat_control_states::tCurrentState>(states(random));
+    }
+
+    // invalid states are treated like eREADY
+    for (std::size_t i = 0; i < cROWS; i += 1000)
+    {
+      state[i] = static_cast<heat_control_states::tCurrentState>((i % 2000 == 0) ? heat_control_states::cSTATE_COUNT + i % 7 : -1);
+    }
+    heat_control_states::tTemperatureColumns temperatures {boiler.data(), room.data(), solar.data(), ground.data(), set_point.data()};
+
+    // the tState classes with their si_units expressions are the oracle (independent of tStateMachine::EvaluateConditions)
+    std::vector<heat_control_states::tCurrentState> expected(cROWS);
+    std::vector<shared::tPumps> expected_pumps;
+    expected_pumps.reserve(cROWS);
+    for (std::size_t i = 0; i < cROWS; i++)
+    {
+      auto current = static_cast<std::size_t>(state[i]) < heat_control_states::cSTATE_COUNT ? state[i] : heat_control_states::tCurrentState::eREADY;
+      auto oracle = CreateState(current);
+      std::unique_ptr<heat_control_states::tState> new_state;
+      oracle->ComputeControlState(new_state, shared::tTemperatures(boiler[i], room[i], solar[i], ground[i], set_point[i]));
+      const heat_control_states::tState &next = oracle->HasChanged() ? *new_state : *oracle;
+      expected[i] = next.GetCurrentState();
+      expected_pumps.push_back(next.GetPumpSettings());
+    }
+
+    for (unsigned int thread_count : {1u, 4u, 0u})
+    {
+      std::vector<heat_control_states::tCurrentState> next_state(cROWS);
+      std::unique_ptr<bool[]> ground_pump(new bool[cROWS]), room_pump(new bool[cROWS]), solar_pump(new bool[cROWS]);
+      heat_control_states::tControlStateColumns result {next_state.data(), ground_pump.get(), room_pump.get(), solar_pump.get()};
+      heat_control_states::tStateMachine::ComputeControlStates(temperatures, state.data(), result, cROWS, thread_count);
+
+      for (std::size_t i = 0; i < cROWS; i++)
+      {
+        RRLIB_UNIT_TESTS_EQUALITY(static_cast<int>(expected[i]), static_cast<int>(next_state[i]));
+        RRLIB_UNIT_TESTS_EQUALITY(expected_pumps[i].IsGroundOnline(), ground_pump[i]);
+        RRLIB_UNIT_TESTS_EQUALITY(expected_pumps[i].IsRoomOnline(), room_pump[i]);
+        RRLIB_UNIT_TESTS_EQUALITY(expected_pumps[i].IsSolarOnline(), solar_pump[i]);
+      }
+    }
+  }
 };
 
 RRLIB_UNIT_TESTS_REGISTER_SUITE(StateMachine);
@@ -0,0 +1,313 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/test/state_machine_sweep.cpp
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ * Sweeps a dense temperature grid through the heat control state machine from every state,
+ * compares the transition map with the golden file state_machine_sweep.golden, reports the
+ * evaluation rate and flags temperatures at which the state flips back and forth.
+ *
+ * The test fails if the golden file is missing. After intended changes of the control logic,
+ * run it once with SMART_HOME_UPDATE_GOLDEN=1 to write a new golden file and review its diff.
+ * Set SMART_HOME_SWEEP_MAP to a file name to dump the full transition map.
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tUnitTestSuite.h"
+#include "rrlib/util/fileio.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "projects/smart_home/heat_control_states/tReady.h"
+#include "projects/smart_home/heat_control_states/tGround.h"
+#include "projects/smart_home/heat_control_states/tRoom.h"
+#include "projects/smart_home/heat_control_states/tSolar.h"
+#include "projects/smart_home/heat_control_states/tRoomGround.h"
+#include "projects/smart_home/heat_control_states/tGroundSolar.h"
+#include "projects/smart_home/heat_control_states/tRoomSolar.h"
+#include "projects/smart_home/heat_control_states/tGroundRoomSolar.h"
+#include "projects/smart_home/heat_control_states/tStateMachine.h"
+#include "projects/smart_home/heat_control_states/tHeatingCircuits.h"
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace tests
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+typedef std::function<heat_control_states::tCurrentState(heat_control_states::tCurrentState, const shared::tTemperatures &)> tStep;
+
+//! Result of a sweep from one start state
+struct tSweepResult
+{
+  uint64_t digest;
+  std::array<std::size_t, heat_control_states::cSTATE_COUNT> transitions;
+};
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+static const std::string cGOLDEN_FILE = "$FINROC_PROJECT_HOME/tests/state_machine_sweep.golden";
+static constexpr std::size_t cMAX_REPORTED_OSCILLATIONS = 100;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+/*!
+ * Creates values from first to last (inclusive) with constant step
+ */
+std::vector<double> Range(double first, double last, double step)
+{
+  std::vector<double> values;
+  for (int i = 0; first + i * step <= last; i++)
+  {
+    values.push_back(first + i * step);
+  }
+  return values;
+}
+
+std::vector<double> Concatenate(std::vector<double> a, const std::vector<double> & b)
+{
+  a.insert(a.end(), b.begin(), b.end());
+  return a;
+}
+
+class StateMachineSweep : public rrlib::util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(StateMachineSweep);
+  RRLIB_UNIT_TESTS_ADD_TEST(Sweep);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+private:
+
+  // grid hitting all thresholds of tTemperatures.h exactly as well as values in between
+  const std::vector<double> boiler_ = Concatenate({0.0, 20.0, 30.0}, Concatenate(Range(40.0, 60.0, 0.5), {80.0}));
+  const std::vector<double> room_ = Concatenate(Range(15.0, 25.0, 0.5), Concatenate({19.9, 20.9}, Range(40.0, 58.0, 1.0)));
+  const std::vector<double> solar_ = Range(0.0, 90.0, 2.0);
+  const std::vector<double> ground_ = Range(0.0, 60.0, 4.0);
+  const std::vector<double> set_point_ = {19.0, 20.0, 21.0};
+
+  std::size_t GetTupleCount() const
+  {
+    return boiler_.size() * room_.size() * solar_.size() * ground_.size() * set_point_.size();
+  }
+
+  /*!
+   * Evaluates every grid point from every start state
+   * @param step state machine step
+   * @param map if not null, receives the successor of every evaluation
+   * @return sweep result per start state
+   */
+  std::array<tSweepResult, heat_control_states::cSTATE_COUNT> Run(const tStep & step, std::vector<uint8_t> *map)
+  {
+    std::array<tSweepResult, heat_control_states::cSTATE_COUNT> results;
+    for (std::size_t s = 0; s < heat_control_states::cSTATE_COUNT; s++)
+    {
+      auto current = static_cast<heat_control_states::tCurrentState>(s);
+      tSweepResult & result = results[s];
+      result.digest = 14695981039346656037ULL;
+      result.transitions.fill(0);
+
+      ForEachTuple([&](const shared::tTemperatures & temperatures)
+      {
+        auto next = static_cast<uint8_t>(step(current, temperatures));
+        result.digest = (result.digest ^ next) * 1099511628211ULL;
+        result.transitions[next]++;
+        if (map)
+        {
+          map->push_back(next);
+        }
+      });
+    }
+    return results;
+  }
+
+  template<typename TFunction>
+  void ForEachTuple(TFunction function)
+  {
+    for (double boiler : boiler_)
+      for (double room : room_)
+        for (double solar : solar_)
+          for (double ground : ground_)
+            for (double set_point : set_point_)
+            {
+              function(shared::tTemperatures(boiler, room, solar, ground, set_point));
+            }
+  }
+
+  std::string Format(const std::array<tSweepResult, heat_control_states::cSTATE_COUNT> & results)
+  {
+    std::stringstream stream;
+    stream << "tuples " << GetTupleCount() << "\n";
+    for (std::size_t s = 0; s < results.size(); s++)
+    {
+      stream << "state " << s << " digest " << std::hex << std::setw(16) << std::setfill('0') << results[s].digest << std::dec << " transitions";
+      for (auto count : results[s].transitions)
+      {
+        stream << " " << count;
+      }
+      stream << "\n";
+    }
+    return stream.str();
+  }
+
+  void Sweep()
+  {
+    std::vector<std::unique_ptr<heat_control_states::tState>> states;
+    states.emplace_back(new heat_control_states::tReady());
+    states.emplace_back(new heat_control_states::tSolar());
+    states.emplace_back(new heat_control_states::tRoom());
+    states.emplace_back(new heat_control_states::tGround());
+    states.emplace_back(new heat_control_states::tRoomSolar());
+    states.emplace_back(new heat_control_states::tGroundSolar());
+    states.emplace_back(new heat_control_states::tRoomGround());
+    states.emplace_back(new heat_control_states::tGroundRoomSolar());
+
+    std::vector<std::pair<std::string, tStep>> engines;
+    engines.emplace_back("tState", [&](heat_control_states::tCurrentState current, const shared::tTemperatures & temperatures)
+    {
+      std::unique_ptr<heat_control_states::tState> next;
+      auto & state = states[static_cast<std::size_t>(current)];
+      state->ComputeControlState(next, temperatures);
+      return state->HasChanged() ? next->GetCurrentState() : current;
+    });
+    engines.emplace_back("tStateMachine", [](heat_control_states::tCurrentState current, const shared::tTemperatures & temperatures)
+    {
+      return heat_control_states::tStateMachine::GetNextState(current, heat_control_states::tStateMachine::EvaluateConditions(temperatures));
+    });
+    engines.emplace_back("tHeatingCircuits", [](heat_control_states::tCurrentState current, const shared::tTemperatures & temperatures)
+    {
+      heat_control_states::tHeatingCircuits circuits;
+      circuits.SetCurrentState(current);
+      circuits.ComputeControlState(temperatures);
+      return circuits.GetCurrentState();
+    });
+
+    // transition maps
+    const char *map_filename = std::getenv("SMART_HOME_SWEEP_MAP");
+    std::string reference;
+    for (auto & engine : engines)
+    {
+      std::vector<uint8_t> map;
+      bool dump = (map_filename != nullptr) and (&engine == &engines.front());
+      auto start = std::chrono::steady_clock::now();
+      auto results = Run(engine.second, dump ? &map : nullptr);
+      double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      RRLIB_LOG_PRINT(USER, engine.first, ": ", GetTupleCount() * heat_control_states::cSTATE_COUNT / seconds, " evaluations per second");
+
+      std::string formatted = Format(results);
+      if (reference.empty())
+      {
+        reference = formatted;
+      }
+      RRLIB_UNIT_TESTS_EQUALITY_MESSAGE(engine.first + " differs from tState", reference, formatted);
+
+      if (dump)
+      {
+        std::ofstream(map_filename, std::ofstream::binary).write(reinterpret_cast<const char *>(map.data()), map.size());
+      }
+    }
+
+    // oscillations: the state returns to the start state after two steps at constant temperatures
+    std::stringstream oscillations;
+    std::size_t oscillation_count = 0;
+    for (std::size_t s = 0; s < heat_control_states::cSTATE_COUNT; s++)
+    {
+      auto current = static_cast<heat_control_states::tCurrentState>(s);
+      ForEachTuple([&](const shared::tTemperatures & temperatures)
+      {
+        auto next = engines.front().second(current, temperatures);
+        if (next != current and engines.front().second(next, temperatures) == current)
+        {
+          if (oscillation_count < cMAX_REPORTED_OSCILLATIONS)
+          {
+            oscillations << "oscillation " << s << " <-> " << static_cast<int>(next) << " at boiler " << temperatures.GetBoiler().ValueFactored()
+                         << " room " << temperatures.GetRoom().ValueFactored() << " solar " << temperatures.GetSolar().ValueFactored()
+                         << " ground " << temperatures.GetGround().ValueFactored() << " set point " << temperatures.GetRoomSetPoint().ValueFactored() << "\n";
+          }
+          oscillation_count++;
+        }
+      });
+    }
+    if (oscillation_count > 0)
+    {
+      RRLIB_LOG_PRINT(WARNING, oscillation_count, " oscillating state pairs:\n", oscillations.str());
+    }
+    reference += "oscillations " + std::to_string(oscillation_count) + "\n" + oscillations.str();
+
+    // golden file
+    std::string golden_filename = rrlib::util::fileio::ShellExpandFilename(cGOLDEN_FILE);
+    const char *update_golden = std::getenv("SMART_HOME_UPDATE_GOLDEN");
+    if (update_golden and std::string(update_golden) == "1")
+    {
+      std::ofstream new_golden_file(golden_filename, std::ios::trunc);
+      new_golden_file << reference;
+      RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Could not write " + golden_filename, new_golden_file.good());
+      RRLIB_LOG_PRINT(WARNING, "Wrote new golden file ", golden_filename);
+      return;
+    }
+    std::ifstream golden_file(golden_filename);
+    RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Missing golden file " + golden_filename + " (run once with SMART_HOME_UPDATE_GOLDEN=1 to write it)", golden_file.good());
+    std::stringstream golden;
+    golden << golden_file.rdbuf();
+    RRLIB_UNIT_TESTS_EQUALITY_MESSAGE("Transition map differs from " + golden_filename, golden.str(), reference);
+  }
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(StateMachineSweep);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
@@ -0,0 +1,361 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/test/temperature_history.cpp
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tUnitTestSuite.h"
+#include <cmath>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include <cassert>
+
+#include "projects/smart_home/shared/tTemperatureHistory.h"
+#include "projects/smart_home/tests/test_utils.h"
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace tests
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+static const std::array<const char *, shared::eSENSOR_FRAME_COUNT> cCHANNEL_NAMES {{
+    "Speicher (unten)", "Speicher (mitte)", "Speicher (oben)", "Ofen", "Garage", "Bodenplatte", "Raum", "Solar", "Raum (extern)"
+  }
+};
+
+// segments: start (seconds after the reference time), number of one second records
+static const std::array<std::pair<int, int>, 3> cSEGMENTS {{ {200000, 50000}, {0, 100000}, {100500, 30000} }};
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+class TemperatureHistory : public rrlib::util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(TemperatureHistory);
+  RRLIB_UNIT_TESTS_ADD_TEST(Segments);
+  RRLIB_UNIT_TESTS_ADD_TEST(Records);
+  RRLIB_UNIT_TESTS_ADD_TEST(Aggregation);
+  RRLIB_UNIT_TESTS_ADD_TEST(StoredIndex);
+  RRLIB_UNIT_TESTS_ADD_TEST(InvalidQueries);
+  RRLIB_UNIT_TESTS_ADD_TEST(ClockSetBack);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+private:
+
+  std::string directory_;
+  rrlib::time::tTimestamp reference_;
+  std::vector<shared::tTemperatureLogRecord> all_records_;
+  shared::tTemperatureHistory history_;
+  shared::tTemperatureHistory reloaded_history_;
+
+  /*!
+   * Writes the segments, maps them and removes the files again (the mappings stay valid)
+   */
+  void Prepare()
+  {
+    if (history_.GetSegmentCount() > 0)
+    {
+      return;
+    }
+    directory_ = TemporaryFilename("history");
+    mkdir(directory_.c_str(), 0755);
+    reference_ = rrlib::time::Now();
+
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> temperature(-500, 9000);
+    for (auto & segment : cSEGMENTS)
+    {
+      auto start = reference_ + std::chrono::seconds(segment.first);
+      std::ofstream file(directory_ + "/temperatures_" + std::to_string(segment.first) + ".bin", std::ios::binary);
+      file << shared::CreateTemperatureLogHeader(start, cCHANNEL_NAMES);
+      for (int i = 0; i < segment.second; i++)
+      {
+        shared::tTemperatureLogRecord record;
+        record.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>((start + std::chrono::seconds(i)).time_since_epoch()).count();
+        for (int channel = 0; channel < shared::eSENSOR_FRAME_COUNT; channel++)
+        {
+          record.temperature[channel] = (random() % 50 == 0) ? shared::cSENSOR_FRAME_NO_READING : static_cast<int16_t>(temperature(random));
+        }
+        record.valid = 0x1FF;
+        record.outdated = (random() % 20 == 0) ? random() & 0x1FF : 0;
+        record.implausible = (random() % 20 == 0) ? random() & 0x1FF : 0;
+        file.write(reinterpret_cast<const char *>(&record), sizeof(record));
+        all_records_.push_back(record);
+      }
+    }
+    std::sort(all_records_.begin(), all_records_.end(), [](const shared::tTemperatureLogRecord & a, const shared::tTemperatureLogRecord & b)
+    {
+      return a.timestamp < b.timestamp;
+    });
+
+    // not a temperature log
+    std::ofstream(directory_ + "/events_0.txt") << "Systemereignisse\n";
+    std::ofstream(directory_ + "/temperatures_broken.bin") << "broken\n";
+
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(3), history_.AddDirectory(directory_));
+
+    // second instance with the stored index files
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(3), reloaded_history_.AddDirectory(directory_));
+
+    for (auto & segment : cSEGMENTS)
+    {
+      std::string filename = directory_ + "/temperatures_" + std::to_string(segment.first) + ".bin";
+      std::remove(filename.c_str());
+      std::remove((filename + ".idx").c_str());
+    }
+    std::remove((directory_ + "/events_0.txt").c_str());
+    std::remove((directory_ + "/temperatures_broken.bin").c_str());
+    rmdir(directory_.c_str());
+  }
+
+
+  rrlib::time::tTimestamp At(int64_t seconds) const
+  {
+    return reference_ + std::chrono::seconds(seconds);
+  }
+
+  int64_t Nanoseconds(const rrlib::time::tTimestamp &timestamp) const
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count();
+  }
+
+  void Segments()
+  {
+    Prepare();
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(3), history_.GetSegmentCount());
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint64_t>(all_records_.size()), history_.GetRecordCount());
+    RRLIB_UNIT_TESTS_ASSERT(history_.GetBegin() == At(0));
+    RRLIB_UNIT_TESTS_ASSERT(history_.GetEnd() == At(249999) + std::chrono::nanoseconds(1));
+    RRLIB_UNIT_TESTS_EQUALITY(std::string("Solar"), history_.GetChannelName(shared::eSENSOR_SOLAR));
+  }
+
+  void Records()
+  {
+    Prepare();
+    // across a gap and a segment border, in chronological order
+    auto ranges = history_.GetRecords(At(99990), At(100510));
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(2), ranges.size());
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<long>(10), static_cast<long>(ranges[0].end - ranges[0].begin));
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<long>(10), static_cast<long>(ranges[1].end - ranges[1].begin));
+    RRLIB_UNIT_TESTS_EQUALITY(Nanoseconds(At(99990)), ranges[0].begin->timestamp);
+    RRLIB_UNIT_TESTS_EQUALITY(Nanoseconds(At(100500)), ranges[1].begin->timestamp);
+
+    RRLIB_UNIT_TESTS_ASSERT(history_.GetRecords(At(100000), At(100500)).empty());
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(3), history_.GetRecords(At(-100), At(300000)).size());
+  }
+
+  void Aggregation()
+  {
+    Prepare();
+    // compare with a linear scan over unaligned ranges and buckets
+    std::mt19937 random(7);
+    for (int query = 0; query < 20; query++)
+    {
+      int64_t begin = static_cast<int64_t>(random() % 260000) - 5000;
+      int64_t end = begin + 1 + random() % 100000;
+      int64_t width = 1 + random() % 20000;
+      auto channel = static_cast<shared::tSensor>(random() % shared::eSENSOR_FRAME_COUNT);
+      auto buckets = history_.Aggregate(channel, At(begin), At(end), std::chrono::seconds(width));
+      RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>((end - begin - 1) / width + 1), buckets.size());
+
+      bool equal = true;
+      for (size_t b = 0; b < buckets.size(); b++)
+      {
+        int64_t bucket_begin = Nanoseconds(At(begin + b * width));
+        int64_t bucket_end = std::min(bucket_begin + width * 1000000000, Nanoseconds(At(end)));
+        uint32_t count = 0;
+        int16_t min = INT16_MAX, max = INT16_MIN;
+        int64_t sum = 0;
+        for (auto & record : all_records_)
+        {
+          int16_t value = record.temperature[channel];
+          bool usable = value != shared::cSENSOR_FRAME_NO_READING and not ((record.outdated | record.implausible) & (1 << channel));
+          if (record.timestamp >= bucket_begin and record.timestamp < bucket_end and usable)
+          {
+            count++;
+            min = std::min(min, value);
+            max = std::max(max, value);
+            sum += value;
+          }
+        }
+        equal &= buckets[b].count == count;
+        equal &= buckets[b].start == At(begin + b * width);
+        if (count > 0)
+        {
+          equal &= buckets[b].min == min / 100.0 and buckets[b].max == max / 100.0;
+          equal &= std::fabs(buckets[b].mean - sum / (100.0 * count)) < 1e-9;
+        }
+        else
+        {
+          equal &= std::isnan(buckets[b].mean);
+        }
+      }
+      RRLIB_UNIT_TESTS_ASSERT(equal);
+    }
+  }
+
+  void StoredIndex()
+  {
+    Prepare();
+    RRLIB_UNIT_TESTS_EQUALITY(history_.GetRecordCount(), reloaded_history_.GetRecordCount());
+    auto buckets = history_.Aggregate(shared::eSENSOR_SOLAR, At(-1000), At(260000), std::chrono::hours(1));
+    auto reloaded_buckets = reloaded_history_.Aggregate(shared::eSENSOR_SOLAR, At(-1000), At(260000), std::chrono::hours(1));
+    RRLIB_UNIT_TESTS_EQUALITY(buckets.size(), reloaded_buckets.size());
+    bool equal = true;
+    for (size_t i = 0; i < buckets.size(); i++)
+    {
+      equal &= buckets[i].count == reloaded_buckets[i].count;
+      equal &= buckets[i].count == 0 or (buckets[i].min == reloaded_buckets[i].min and buckets[i].max == reloaded_buckets[i].max
+                                         and buckets[i].mean == reloaded_buckets[i].mean);
+    }
+    RRLIB_UNIT_TESTS_ASSERT(equal);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(2), reloaded_history_.GetRecords(At(99990), At(100510)).size());
+  }
+
+  void InvalidQueries()
+  {
+    Prepare();
+    RRLIB_UNIT_TESTS_ASSERT(history_.Aggregate(shared::eSENSOR_ROOM, At(10), At(10), std::chrono::seconds(1)).empty());
+    RRLIB_UNIT_TESTS_ASSERT(history_.Aggregate(shared::eSENSOR_ROOM, At(0), At(10), std::chrono::seconds(0)).empty());
+    RRLIB_UNIT_TESTS_ASSERT(history_.Aggregate(shared::eSENSOR_FRAME_COUNT, At(0), At(10), std::chrono::seconds(1)).empty());
+    RRLIB_UNIT_TESTS_ASSERT(history_.Aggregate(shared::eSENSOR_ROOM, At(0), At(2000000), std::chrono::seconds(1)).empty());
+  }
+
+  void ClockSetBack()
+  {
+    Prepare();
+    // one segment, the clock is set back by 10 minutes after 3000 records
+    std::string directory = TemporaryFilename("history_clock");
+    std::string filename = directory + "/temperatures_0.bin";
+    mkdir(directory.c_str(), 0755);
+    std::vector<shared::tTemperatureLogRecord> records;
+    {
+      std::ofstream file(filename, std::ios::binary);
+      file << shared::CreateTemperatureLogHeader(At(0), cCHANNEL_NAMES);
+      for (int i = 0; i < 5000; i++)
+      {
+        shared::tTemperatureLogRecord record;
+        std::memset(&record, 0, sizeof(record));
+        record.timestamp = Nanoseconds(At(i < 3000 ? i : i - 600));
+        for (int channel = 0; channel < shared::eSENSOR_FRAME_COUNT; channel++)
+        {
+          record.temperature[channel] = static_cast<int16_t>(i + channel);
+        }
+        record.valid = 0x1FF;
+        file.write(reinterpret_cast<const char *>(&record), sizeof(record));
+        records.push_back(record);
+      }
+    }
+
+    shared::tTemperatureHistory history;
+    shared::tTemperatureHistory reloaded_history;
+    RRLIB_UNIT_TESTS_ASSERT(history.AddSegment(filename));
+    RRLIB_UNIT_TESTS_ASSERT(reloaded_history.AddSegment(filename));
+    std::remove(filename.c_str());
+    std::remove((filename + ".idx").c_str());
+    rmdir(directory.c_str());
+
+    for (auto * instance : { &history, &reloaded_history })
+    {
+      RRLIB_UNIT_TESTS_ASSERT(instance->GetBegin() == At(0));
+      RRLIB_UNIT_TESTS_ASSERT(instance->GetEnd() == At(4399) + std::chrono::nanoseconds(1));
+
+      // the range overlapping the step contains records from before and after it
+      auto ranges = instance->GetRecords(At(2500), At(2600));
+      RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(2), ranges.size());
+      RRLIB_UNIT_TESTS_EQUALITY(static_cast<long>(100), static_cast<long>(ranges[0].end - ranges[0].begin));
+      RRLIB_UNIT_TESTS_EQUALITY(static_cast<long>(100), static_cast<long>(ranges[1].end - ranges[1].begin));
+      RRLIB_UNIT_TESTS_EQUALITY(Nanoseconds(At(2500)), ranges[1].begin->timestamp);
+      RRLIB_UNIT_TESTS_EQUALITY(static_cast<int16_t>(3100), ranges[1].begin->temperature[0]);
+
+      // compare with a linear scan, buckets of whole index blocks included
+      for (int width : { 1, 256, 1000, 5000 })
+      {
+        auto buckets = instance->Aggregate(shared::eSENSOR_ROOM, At(-10), At(4500), std::chrono::seconds(width));
+        bool equal = true;
+        for (size_t b = 0; b < buckets.size(); b++)
+        {
+          int64_t bucket_begin = Nanoseconds(At(-10 + static_cast<int64_t>(b) * width));
+          int64_t bucket_end = std::min(bucket_begin + static_cast<int64_t>(width) * 1000000000, Nanoseconds(At(4500)));
+          uint32_t count = 0;
+          int16_t min = INT16_MAX, max = INT16_MIN;
+          for (auto & record : records)
+          {
+            if (record.timestamp >= bucket_begin and record.timestamp < bucket_end)
+            {
+              count++;
+              min = std::min(min, record.temperature[shared::eSENSOR_ROOM]);
+              max = std::max(max, record.temperature[shared::eSENSOR_ROOM]);
+            }
+          }
+          equal &= buckets[b].count == count;
+          equal &= count == 0 or (buckets[b].min == min / 100.0 and buckets[b].max == max / 100.0);
+        }
+        RRLIB_UNIT_TESTS_ASSERT(equal);
+      }
+    }
+  }
+
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(TemperatureHistory);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
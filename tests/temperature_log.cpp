@@ -0,0 +1,189 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/test/temperature_log.cpp
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tUnitTestSuite.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include <cassert>
+
+#include "projects/smart_home/shared/tAsyncLogWriter.h"
+#include "projects/smart_home/shared/tTemperatureLog.h"
+#include "projects/smart_home/tests/test_utils.h"
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace tests
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+static const std::array<const char *, shared::eSENSOR_FRAME_COUNT> cCHANNEL_NAMES {{
+    "Speicher (unten)", "Speicher (mitte)", "Speicher (oben)", "Ofen", "Garage", "Bodenplatte", "Raum", "Solar", "Raum (extern)"
+  }
+};
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+class TemperatureLog : public rrlib::util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(TemperatureLog);
+  RRLIB_UNIT_TESTS_ADD_TEST(RoundTrip);
+  RRLIB_UNIT_TESTS_ADD_TEST(Recovery);
+  RRLIB_UNIT_TESTS_ADD_TEST(NoTemperatureLog);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+private:
+
+  static shared::tSensorFrame CreateFrame(const rrlib::time::tTimestamp &time, int index)
+  {
+    shared::tSensorFrame frame = tests::CreateFrame(time, [index](int channel)
+    {
+      return index + channel * 0.25;
+    });
+    frame.SetOutdatedMask(index & 0x1FF);
+    return frame;
+  }
+
+  static void WriteLog(const std::string &filename, const rrlib::time::tTimestamp &start, int count)
+  {
+    shared::tAsyncLogWriter writer;
+    RRLIB_UNIT_TESTS_ASSERT(writer.Open(filename, sizeof(shared::tTemperatureLogRecord), shared::CreateTemperatureLogHeader(start, cCHANNEL_NAMES)));
+    for (int i = 0; i < count; i++)
+    {
+      shared::tTemperatureLogRecord record = shared::ToTemperatureLogRecord(CreateFrame(start + std::chrono::seconds(i), i));
+      while (not writer.Write(&record, sizeof(record)))
+      {
+        std::this_thread::sleep_for(shared::cLOG_WRITER_PERIOD);
+      }
+    }
+  }
+
+  void RoundTrip()
+  {
+    std::string filename = TemporaryFilename("temperature_log", ".bin");
+    std::remove(filename.c_str());
+    auto start = rrlib::time::Now();
+    WriteLog(filename, start, 1000);
+
+    shared::tTemperatureLogFile log;
+    RRLIB_UNIT_TESTS_ASSERT(log.Open(filename));
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(1000), log.GetRecordCount());
+    RRLIB_UNIT_TESTS_ASSERT(log.GetStartTime() == start);
+    RRLIB_UNIT_TESTS_EQUALITY(std::string("Raum (extern)"), log.GetChannelName(shared::eSENSOR_ROOM_EXTERNAL));
+
+    const shared::tTemperatureLogRecord &record = log[123];
+    RRLIB_UNIT_TESTS_ASSERT(shared::GetTimestamp(record) == start + std::chrono::seconds(123));
+    RRLIB_UNIT_TESTS_EQUALITY(123.0, shared::GetTemperature(record, shared::eSENSOR_BOILER_BOTTOM));
+    RRLIB_UNIT_TESTS_EQUALITY(125.0, shared::GetTemperature(record, shared::eSENSOR_ROOM_EXTERNAL));
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint16_t>(123), record.outdated);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint16_t>(0x1FF), record.valid);
+
+    size_t count = 0;
+    for (auto & entry : log)
+    {
+      count += (entry.timestamp != 0);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(1000), count);
+
+    // appending to an existing log keeps its header
+    WriteLog(filename, start + std::chrono::hours(1), 10);
+    RRLIB_UNIT_TESTS_ASSERT(log.Open(filename));
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(1010), log.GetRecordCount());
+    RRLIB_UNIT_TESTS_ASSERT(log.GetStartTime() == start);
+    std::remove(filename.c_str());
+  }
+
+  void Recovery()
+  {
+    // torn last record and zero filled records of an interrupted commit
+    std::string filename = TemporaryFilename("temperature_log_torn", ".bin");
+    std::remove(filename.c_str());
+    auto start = rrlib::time::Now();
+    WriteLog(filename, start, 10);
+    {
+      std::ofstream file(filename, std::ios::binary | std::ios::app);
+      file << std::string(3 * sizeof(shared::tTemperatureLogRecord), '\0') << std::string(sizeof(shared::tTemperatureLogRecord) + 5, 'x');
+    }
+    WriteLog(filename, start, 1);
+
+    shared::tTemperatureLogFile log;
+    RRLIB_UNIT_TESTS_ASSERT(log.Open(filename));
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(11), log.GetRecordCount());
+    RRLIB_UNIT_TESTS_ASSERT(shared::GetTimestamp(log[10]) == start);
+    std::remove(filename.c_str());
+  }
+
+  void NoTemperatureLog()
+  {
+    std::string filename = TemporaryFilename("temperature_log_text", ".bin");
+    {
+      std::ofstream file(filename);
+      file << std::string(1000, 'x');
+    }
+    shared::tTemperatureLogFile log;
+    RRLIB_UNIT_TESTS_ASSERT(not log.Open(filename));
+    RRLIB_UNIT_TESTS_ASSERT(not log.IsOpen());
+    std::remove(filename.c_str());
+  }
+
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(TemperatureLog);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
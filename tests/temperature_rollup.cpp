@@ -0,0 +1,283 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/test/temperature_rollup.cpp
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tUnitTestSuite.h"
+#include <algorithm>
+#include <memory>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include <cassert>
+
+#include "projects/smart_home/shared/tTemperatureRollup.h"
+#include "projects/smart_home/tests/test_utils.h"
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace tests
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+// start of the test data, aligned to a full hour
+static const rrlib::time::tTimestamp cSTART(std::chrono::duration_cast<rrlib::time::tTimestamp::duration>(std::chrono::hours(24 * 20000)));
+
+static const rrlib::time::tDuration cCYCLE = std::chrono::milliseconds(200);
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+class TemperatureRollup : public rrlib::util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(TemperatureRollup);
+  RRLIB_UNIT_TESTS_ADD_TEST(Levels);
+  RRLIB_UNIT_TESTS_ADD_TEST(Aggregation);
+  RRLIB_UNIT_TESTS_ADD_TEST(UnusableReadings);
+  RRLIB_UNIT_TESTS_ADD_TEST(Gaps);
+  RRLIB_UNIT_TESTS_ADD_TEST(Trend);
+  RRLIB_UNIT_TESTS_ADD_TEST(Serialization);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+private:
+
+  std::unique_ptr<shared::tTemperatureRollup> rollup_;
+
+  void Prepare()
+  {
+    rollup_.reset(new shared::tTemperatureRollup());
+  }
+
+  /*!
+   * Temperature of a channel in centi degree at cycle i
+   */
+  static int16_t GetValue(int i, int channel)
+  {
+    return static_cast<int16_t>((i * 37 + channel * 1000) % 5000 - 1000);
+  }
+
+  static shared::tSensorFrame CreateFrame(int i)
+  {
+    return tests::CreateFrame(cSTART + i * cCYCLE, [i](int channel)
+    {
+      return GetValue(i, channel) / 100.0;
+    });
+  }
+
+  void AddCycles(int begin, int end)
+  {
+    for (int i = begin; i < end; i++)
+    {
+      rollup_->Add(CreateFrame(i));
+    }
+  }
+
+  void Levels()
+  {
+    Prepare();
+    // two hours of frames
+    AddCycles(0, 2 * 3600 * 5);
+    RRLIB_UNIT_TESTS_EQUALITY(shared::cROLLUP_CAPACITY[shared::eROLLUP_RAW], rollup_->GetBucketCount(shared::eROLLUP_RAW));
+    RRLIB_UNIT_TESTS_EQUALITY(shared::cROLLUP_CAPACITY[shared::eROLLUP_SECOND], rollup_->GetBucketCount(shared::eROLLUP_SECOND));
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(120), rollup_->GetBucketCount(shared::eROLLUP_MINUTE));
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(2), rollup_->GetBucketCount(shared::eROLLUP_HOUR));
+
+    // full rings keep the newest buckets
+    RRLIB_UNIT_TESTS_ASSERT(shared::GetStart(rollup_->GetBucket(shared::eROLLUP_RAW, 0)) == cSTART + std::chrono::minutes(110));
+    RRLIB_UNIT_TESTS_ASSERT(shared::GetStart(rollup_->GetBucket(shared::eROLLUP_SECOND, 0)) == cSTART + std::chrono::hours(1));
+    RRLIB_UNIT_TESTS_ASSERT(shared::GetStart(rollup_->GetBucket(shared::eROLLUP_MINUTE, 119)) == cSTART + std::chrono::minutes(119));
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint16_t>(3600 * 5), rollup_->GetBucket(shared::eROLLUP_HOUR, 1).count[shared::eSENSOR_SOLAR]);
+
+    // a second frame within 200 ms is ignored
+    shared::tSensorFrame frame = CreateFrame(2 * 3600 * 5 - 1);
+    frame.SetTimestamp(frame.GetTimestamp() + std::chrono::milliseconds(100));
+    rollup_->Add(frame);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint16_t>(1), rollup_->GetBucket(shared::eROLLUP_RAW, shared::cROLLUP_CAPACITY[shared::eROLLUP_RAW] - 1).count[0]);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint16_t>(3600 * 5), rollup_->GetBucket(shared::eROLLUP_HOUR, 1).count[shared::eSENSOR_SOLAR]);
+
+    // clock set back
+    rollup_->Add(CreateFrame(100));
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(1), rollup_->GetBucketCount(shared::eROLLUP_RAW));
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(1), rollup_->GetBucketCount(shared::eROLLUP_HOUR));
+  }
+
+  void Aggregation()
+  {
+    Prepare();
+    // 90 minutes, starting in the middle of a second
+    AddCycles(3, 90 * 60 * 5);
+    for (int level = 0; level < shared::eROLLUP_LEVEL_COUNT; level++)
+    {
+      shared::tRollupLevel rollup_level = static_cast<shared::tRollupLevel>(level);
+      int cycles = static_cast<int>(shared::cROLLUP_BUCKET_DURATION_MS[level] / 200);
+      for (size_t b = 0; b < rollup_->GetBucketCount(rollup_level); b++)
+      {
+        const shared::tRollupBucket &bucket = rollup_->GetBucket(rollup_level, b);
+        int first = static_cast<int>((bucket.start - std::chrono::duration_cast<std::chrono::nanoseconds>(cSTART.time_since_epoch()).count()) / 200000000);
+        RRLIB_UNIT_TESTS_EQUALITY(0, first % cycles);
+        for (int channel = 0; channel < shared::eSENSOR_FRAME_COUNT; channel++)
+        {
+          int16_t min = INT16_MAX;
+          int16_t max = INT16_MIN;
+          int32_t sum = 0;
+          uint16_t count = 0;
+          for (int i = std::max(first, 3); i < std::min(first + cycles, 90 * 60 * 5); i++)
+          {
+            min = std::min(min, GetValue(i, channel));
+            max = std::max(max, GetValue(i, channel));
+            sum += GetValue(i, channel);
+            count++;
+          }
+          RRLIB_UNIT_TESTS_EQUALITY(count, bucket.count[channel]);
+          RRLIB_UNIT_TESTS_EQUALITY(sum, bucket.sum[channel]);
+          RRLIB_UNIT_TESTS_EQUALITY(min, bucket.min[channel]);
+          RRLIB_UNIT_TESTS_EQUALITY(max, bucket.max[channel]);
+        }
+      }
+    }
+  }
+
+  void UnusableReadings()
+  {
+    Prepare();
+    shared::tSensorFrame frame = CreateFrame(0);
+    frame.SetTemperature(shared::eSENSOR_GARAGE, rrlib::si_units::tCelsius<double>(NAN));
+    frame.SetOutdated(shared::eSENSOR_ROOM, true);
+    frame.SetImplausible(shared::eSENSOR_SOLAR, true);
+    rollup_->Add(frame);
+
+    const shared::tRollupBucket &bucket = rollup_->GetBucket(shared::eROLLUP_MINUTE, 0);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint16_t>(0), bucket.count[shared::eSENSOR_GARAGE]);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint16_t>(0), bucket.count[shared::eSENSOR_ROOM]);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint16_t>(0), bucket.count[shared::eSENSOR_SOLAR]);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint16_t>(1), bucket.count[shared::eSENSOR_FURNACE]);
+    RRLIB_UNIT_TESTS_ASSERT(std::isnan(shared::GetMean(bucket, shared::eSENSOR_ROOM)));
+    RRLIB_UNIT_TESTS_EQUALITY(GetValue(0, shared::eSENSOR_FURNACE) / 100.0, shared::GetMax(bucket, shared::eSENSOR_FURNACE));
+  }
+
+  void Gaps()
+  {
+    Prepare();
+    // one minute, then nothing for three days
+    AddCycles(0, 300);
+    AddCycles(3 * 24 * 3600 * 5, 3 * 24 * 3600 * 5 + 300);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(600), rollup_->GetBucketCount(shared::eROLLUP_RAW));
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(2), rollup_->GetBucketCount(shared::eROLLUP_MINUTE));
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(2), rollup_->GetBucketCount(shared::eROLLUP_HOUR));
+    RRLIB_UNIT_TESTS_ASSERT(shared::GetStart(rollup_->GetBucket(shared::eROLLUP_HOUR, 1)) == cSTART + std::chrono::hours(72));
+
+    std::vector<shared::tRollupBucket> buckets = rollup_->GetBuckets(shared::eROLLUP_SECOND, cSTART + std::chrono::seconds(30), cSTART + std::chrono::hours(72) + std::chrono::seconds(10));
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(40), buckets.size());
+    RRLIB_UNIT_TESTS_ASSERT(shared::GetStart(buckets.front()) == cSTART + std::chrono::seconds(30));
+    RRLIB_UNIT_TESTS_ASSERT(shared::GetStart(buckets.back()) == cSTART + std::chrono::hours(72) + std::chrono::seconds(9));
+  }
+
+  void Trend()
+  {
+    Prepare();
+    RRLIB_UNIT_TESTS_EQUALITY(shared::eROLLUP_RAW, shared::tTemperatureRollup::SelectLevel(std::chrono::minutes(4)));
+    RRLIB_UNIT_TESTS_EQUALITY(shared::eROLLUP_SECOND, shared::tTemperatureRollup::SelectLevel(std::chrono::minutes(20)));
+    RRLIB_UNIT_TESTS_EQUALITY(shared::eROLLUP_MINUTE, shared::tTemperatureRollup::SelectLevel(std::chrono::minutes(30)));
+    RRLIB_UNIT_TESTS_EQUALITY(shared::eROLLUP_MINUTE, shared::tTemperatureRollup::SelectLevel(std::chrono::hours(24)));
+    RRLIB_UNIT_TESTS_EQUALITY(shared::eROLLUP_HOUR, shared::tTemperatureRollup::SelectLevel(std::chrono::hours(25)));
+
+    // shortly after the start, a long trend still uses the coarse level
+    AddCycles(0, 5 * 60 * 5);
+    auto now = cSTART + std::chrono::minutes(5);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(5), rollup_->GetTrend(shared::eSENSOR_ROOM, now - std::chrono::hours(24), now).size());
+
+    // three hours
+    AddCycles(5 * 60 * 5, 3 * 3600 * 5);
+    now = cSTART + std::chrono::hours(3);
+    std::vector<shared::tHistoryBucket> trend = rollup_->GetTrend(shared::eSENSOR_ROOM, now - std::chrono::minutes(20), now);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(1200), trend.size());
+    RRLIB_UNIT_TESTS_ASSERT(trend.front().start == now - std::chrono::minutes(20));
+    const shared::tRollupBucket &bucket = rollup_->GetBucket(shared::eROLLUP_SECOND, 2400);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint32_t>(5), trend.front().count);
+    RRLIB_UNIT_TESTS_EQUALITY(shared::GetMin(bucket, shared::eSENSOR_ROOM), trend.front().min);
+    RRLIB_UNIT_TESTS_EQUALITY(shared::GetMax(bucket, shared::eSENSOR_ROOM), trend.front().max);
+    RRLIB_UNIT_TESTS_EQUALITY(shared::GetMean(bucket, shared::eSENSOR_ROOM), trend.front().mean);
+
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(180), rollup_->GetTrend(shared::eSENSOR_ROOM, now - std::chrono::hours(24), now).size());
+    RRLIB_UNIT_TESTS_ASSERT(rollup_->GetTrend(shared::eSENSOR_FRAME_COUNT, now - std::chrono::hours(24), now).empty());
+    RRLIB_UNIT_TESTS_ASSERT(rollup_->GetBuckets(shared::eROLLUP_LEVEL_COUNT, now - std::chrono::hours(24), now).empty());
+  }
+
+  void Serialization()
+  {
+    Prepare();
+    AddCycles(0, 400);
+    const shared::tRollupBucket &bucket = rollup_->GetBucket(shared::eROLLUP_MINUTE, 1);
+
+    rrlib::serialization::tMemoryBuffer buffer;
+    rrlib::serialization::tOutputStream output(buffer);
+    output << bucket;
+    output.Close();
+
+    shared::tRollupBucket copy;
+    rrlib::serialization::tInputStream input(buffer);
+    input >> copy;
+    RRLIB_UNIT_TESTS_EQUALITY(bucket.start, copy.start);
+    for (int channel = 0; channel < shared::eSENSOR_FRAME_COUNT; channel++)
+    {
+      RRLIB_UNIT_TESTS_EQUALITY(bucket.sum[channel], copy.sum[channel]);
+      RRLIB_UNIT_TESTS_EQUALITY(bucket.min[channel], copy.min[channel]);
+      RRLIB_UNIT_TESTS_EQUALITY(bucket.max[channel], copy.max[channel]);
+      RRLIB_UNIT_TESTS_EQUALITY(bucket.count[channel], copy.count[channel]);
+    }
+  }
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(TemperatureRollup);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
@@ -0,0 +1,96 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/test/test_utils.h
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Helpers shared by the tests
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __projects__smart_home__tests__test_utils_h__
+#define __projects__smart_home__tests__test_utils_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/time/time.h"
+#include <string>
+#include <unistd.h>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "projects/smart_home/shared/tSensorFrame.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace smart_home
+{
+namespace tests
+{
+
+//----------------------------------------------------------------------
+// Function declaration
+//----------------------------------------------------------------------
+
+/*!
+ * Path in /tmp that is unique per test process
+ * @param name name of the file or directory
+ * @param extension appended extension (e.g. ".txt")
+ */
+inline std::string TemporaryFilename(const std::string &name, const std::string &extension = "")
+{
+  return "/tmp/smart_home_" + name + "_" + std::to_string(getpid()) + extension;
+}
+
+/*!
+ * Sensor frame with valid readings of all channels
+ * @param time timestamp of the frame
+ * @param temperature function returning the temperature in degree Celsius of a channel index
+ */
+template <typename TTemperature>
+inline shared::tSensorFrame CreateFrame(const rrlib::time::tTimestamp &time, TTemperature temperature)
+{
+  shared::tSensorFrame frame;
+  frame.SetTimestamp(time);
+  for (int channel = 0; channel < shared::eSENSOR_FRAME_COUNT; channel++)
+  {
+    frame.SetTemperature(static_cast<shared::tSensor>(channel), rrlib::si_units::tCelsius<double>(temperature(channel)));
+  }
+  return frame;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
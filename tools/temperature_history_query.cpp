@@ -0,0 +1,238 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/tools/temperature_history_query.cpp
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ * Queries the binary temperature logs of the heat control.
+ *
+ * Usage: temperature_history_query [options] <from> <to>
+ *
+ * Times are local times as "YYYY-MM-DD", "YYYY-MM-DD HH:MM" or "YYYY-MM-DD HH:MM:SS",
+ * the range ends before <to>. Options:
+ *   --dir <directory>   directory of the logs (default $HOME)
+ *   --channel <channel> channel number or name (default all channels for raw output, 0 otherwise)
+ *   --bucket <seconds>  minimum, maximum and mean per bucket instead of raw records
+ *   --stats             prints the number of segments and the query time to stderr
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "projects/smart_home/shared/tTemperatureHistory.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+using namespace finroc::smart_home;
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+static const char *cTIME_FORMATS[] = { "%Y-%m-%d %H:%M:%S", "%Y-%m-%d %H:%M", "%Y-%m-%d" };
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+static bool ParseTime(const std::string &text, rrlib::time::tTimestamp &timestamp)
+{
+  for (const char *format : cTIME_FORMATS)
+  {
+    struct tm time;
+    std::memset(&time, 0, sizeof(time));
+    const char *end = strptime(text.c_str(), format, &time);
+    if (end and *end == '\0')
+    {
+      time.tm_isdst = -1;
+      timestamp = rrlib::time::tTimestamp(std::chrono::duration_cast<rrlib::time::tDuration>(std::chrono::seconds(mktime(&time))));
+      return true;
+    }
+  }
+  return false;
+}
+
+static int ParseChannel(const std::string &text, const shared::tTemperatureHistory &history)
+{
+  char *end = nullptr;
+  long number = std::strtol(text.c_str(), &end, 10);
+  if (end != text.c_str() and *end == '\0')
+  {
+    return (number >= 0 and number < shared::eSENSOR_FRAME_COUNT) ? static_cast<int>(number) : -1;
+  }
+  for (int i = 0; i < shared::eSENSOR_FRAME_COUNT; i++)
+  {
+    if (text == history.GetChannelName(static_cast<shared::tSensor>(i)))
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+static void PrintRecords(const shared::tTemperatureHistory &history, const std::vector<shared::tHistoryRange> &ranges, int channel)
+{
+  int first = channel < 0 ? 0 : channel;
+  int last = channel < 0 ? shared::eSENSOR_FRAME_COUNT : channel + 1;
+  std::cout << "time";
+  for (int i = first; i < last; i++)
+  {
+    std::cout << ", " << history.GetChannelName(static_cast<shared::tSensor>(i));
+  }
+  std::cout << "\n";
+
+  for (const shared::tHistoryRange & range : ranges)
+  {
+    for (const shared::tTemperatureLogRecord *record = range.begin; record != range.end; ++record)
+    {
+      std::cout << shared::GetTimestamp(*record);
+      for (int i = first; i < last; i++)
+      {
+        std::cout << ", " << shared::GetTemperature(*record, static_cast<shared::tSensor>(i));
+      }
+      std::cout << "\n";
+    }
+  }
+}
+
+static void PrintBuckets(const std::vector<shared::tHistoryBucket> &buckets)
+{
+  std::cout << "time, count, min, max, mean\n";
+  for (const shared::tHistoryBucket & bucket : buckets)
+  {
+    std::cout << bucket.start << ", " << bucket.count << ", " << bucket.min << ", " << bucket.max << ", " << bucket.mean << "\n";
+  }
+}
+
+static void PrintUsage(const char *program)
+{
+  std::cerr << "Usage: " << program << " [--dir <directory>] [--channel <channel>] [--bucket <seconds>] [--stats] <from> <to>" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+  const char *home = std::getenv("HOME");
+  std::string directory = home ? home : ".";
+  std::string channel_text;
+  long bucket_seconds = 0;
+  bool stats = false;
+  std::vector<std::string> times;
+  for (int i = 1; i < argc; i++)
+  {
+    std::string argument = argv[i];
+    if (argument == "--dir" and i + 1 < argc)
+    {
+      directory = argv[++i];
+    }
+    else if (argument == "--channel" and i + 1 < argc)
+    {
+      channel_text = argv[++i];
+    }
+    else if (argument == "--bucket" and i + 1 < argc)
+    {
+      bucket_seconds = std::atol(argv[++i]);
+    }
+    else if (argument == "--stats")
+    {
+      stats = true;
+    }
+    else
+    {
+      times.push_back(argument);
+    }
+  }
+
+  rrlib::time::tTimestamp begin, end;
+  if (times.size() != 2 or not ParseTime(times[0], begin) or not ParseTime(times[1], end) or bucket_seconds < 0)
+  {
+    PrintUsage(argv[0]);
+    return 1;
+  }
+
+  auto open_start = std::chrono::steady_clock::now();
+  shared::tTemperatureHistory history;
+  if (history.AddDirectory(directory) == 0)
+  {
+    std::cerr << "No temperature logs in " << directory << std::endl;
+    return 1;
+  }
+
+  int channel = channel_text.empty() ? -1 : ParseChannel(channel_text, history);
+  if (not channel_text.empty() and channel < 0)
+  {
+    std::cerr << "Unknown channel " << channel_text << std::endl;
+    return 1;
+  }
+
+  auto query_start = std::chrono::steady_clock::now();
+  std::vector<shared::tHistoryBucket> buckets;
+  std::vector<shared::tHistoryRange> ranges;
+  if (bucket_seconds > 0)
+  {
+    buckets = history.Aggregate(static_cast<shared::tSensor>(channel < 0 ? 0 : channel), begin, end, std::chrono::seconds(bucket_seconds));
+  }
+  else
+  {
+    ranges = history.GetRecords(begin, end);
+  }
+  auto query_end = std::chrono::steady_clock::now();
+
+  if (bucket_seconds > 0)
+  {
+    if (buckets.empty())
+    {
+      std::cerr << "Invalid range or too many buckets (at most " << shared::cHISTORY_MAX_BUCKETS << ")" << std::endl;
+      return 1;
+    }
+    PrintBuckets(buckets);
+  }
+  else
+  {
+    PrintRecords(history, ranges, channel);
+  }
+
+  if (stats)
+  {
+    std::cerr << history.GetSegmentCount() << " segments, " << history.GetRecordCount() << " records, open "
+              << std::chrono::duration_cast<std::chrono::microseconds>(query_start - open_start).count() << " us, query "
+              << std::chrono::duration_cast<std::chrono::microseconds>(query_end - query_start).count() << " us" << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,128 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Patrick Wolf
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    projects/smart_home/tools/temperature_log_export.cpp
+ *
+ * \author  Patrick Wolf
+ *
+ * \date    2026-10-17
+ *
+ * Exports a binary temperature log of the heat control to the CSV layout
+ * of the former text log.
+ *
+ * Usage: temperature_log_export [--all] <temperatures_*.bin> [<output.csv>]
+ *
+ * --all also exports the channels that were not part of the text log
+ * (external room sensor). Without output file, the CSV is written to stdout.
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "projects/smart_home/shared/tTemperatureLog.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+using namespace finroc::smart_home;
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+// channels of the text log (tTemperatureSensors, without the external room sensor)
+static constexpr int cTEXT_LOG_CHANNEL_COUNT = shared::eSENSOR_ROOM_EXTERNAL;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+static void Export(const shared::tTemperatureLogFile &log, int channel_count, std::ostream &stream)
+{
+  stream << "Temperaturen (" << rrlib::time::ToFilenameCompatibleString(log.GetStartTime()) << ")\n";
+  stream << "-----------------------------------------------------\n";
+  stream << "Zeit, ";
+  for (int i = 0; i < channel_count; i++)
+  {
+    stream << log.GetChannelName(static_cast<shared::tSensor>(i)) << ((i + 1 < channel_count) ? ", " : "\n");
+  }
+  stream << "-----------------------------------------------------\n";
+
+  for (const shared::tTemperatureLogRecord & record : log)
+  {
+    stream << shared::GetTimestamp(record) << ",";
+    for (int i = 0; i < channel_count; i++)
+    {
+      stream << shared::GetTemperature(record, static_cast<shared::tSensor>(i)) << ((i + 1 < channel_count) ? ", " : "\n");
+    }
+  }
+}
+
+int main(int argc, char **argv)
+{
+  int channel_count = cTEXT_LOG_CHANNEL_COUNT;
+  int argument = 1;
+  if (argument < argc and std::strcmp(argv[argument], "--all") == 0)
+  {
+    channel_count = shared::eSENSOR_FRAME_COUNT;
+    argument++;
+  }
+  if (argument >= argc or argc - argument > 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " [--all] <temperature log> [<csv file>]" << std::endl;
+    return 1;
+  }
+
+  shared::tTemperatureLogFile log;
+  if (not log.Open(argv[argument]))
+  {
+    std::cerr << "Cannot read temperature log " << argv[argument] << std::endl;
+    return 1;
+  }
+
+  if (argument + 1 < argc)
+  {
+    std::ofstream file(argv[argument + 1]);
+    if (not file.good())
+    {
+      std::cerr << "Cannot write " << argv[argument + 1] << std::endl;
+      return 1;
+    }
+    Export(log, channel_count, file);
+    return file.good() ? 0 : 1;
+  }
+  Export(log, channel_count, std::cout);
+  return std::cout.good() ? 0 : 1;
+}
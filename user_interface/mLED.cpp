@@ -76,7 +76,11 @@ static runtime_construction::tStandardCreateModuleAction<mLED> cCREATE_ACTION_FO
 //----------------------------------------------------------------------
 mLED::mLED(core::tFrameworkElement *parent, const std::string &name) :
   tModule(parent, name, false),
-  par_blink_duration(3.0)
+  par_blink_duration(3.0),
+  clock_(&shared::GetCycleClock()),
+  red_(out_red),
+  yellow_(out_yellow),
+  green_(out_green)
 {}
 
 //----------------------------------------------------------------------
@@ -91,7 +95,7 @@ mLED::~mLED()
 void mLED::Update()
 {
   // last update longer than 10s away
-  auto now = rrlib::time::Now();
+  auto now = clock_->Now();
   if (time == rrlib::time::cNO_TIME or this->InputChanged())
   {
     time = now;
@@ -101,9 +105,9 @@ void mLED::Update()
 
   if (delta.Value() < 10.0)
   {
-    out_red.Publish(in_red.Get());
-    out_yellow.Publish(in_yellow.Get());
-    out_green.Publish(in_green.Get());
+    red_.Publish(in_red.Get(), now);
+    yellow_.Publish(in_yellow.Get(), now);
+    green_.Publish(in_green.Get(), now);
   }
   else
   {
@@ -111,9 +115,9 @@ void mLED::Update()
     double mod = std::fmod(delta.Value(), blink);
     bool red = (mod < (blink / 2.0)) ? false : true;
 
-    out_red.Publish(red);
-    out_yellow.Publish(false);
-    out_green.Publish(false);
+    red_.Publish(red, now);
+    yellow_.Publish(false, now);
+    green_.Publish(false, now);
   }
 }
 
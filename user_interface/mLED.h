@@ -46,6 +46,8 @@
 // Internal includes with ""
 //----------------------------------------------------------------------
 #include "rrlib/si_units/si_units.h"
+#include "projects/smart_home/shared/tChangeGatedOutput.h"
+#include "projects/smart_home/shared/tCycleClock.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -93,6 +95,15 @@ public:
 
   mLED(core::tFrameworkElement *parent, const std::string &name = "LED");
 
+  /*!
+   * Replaces the clock of the module (shared::GetCycleClock() by default)
+   * @param clock clock (has to outlive the module)
+   */
+  inline void SetClock(shared::tCycleClock &clock)
+  {
+    clock_ = &clock;
+  }
+
 //----------------------------------------------------------------------
 // Protected methods
 //----------------------------------------------------------------------
@@ -112,9 +123,15 @@ private:
 
   virtual void Update() override;
 
+  shared::tCycleClock *clock_;
+
   rrlib::time::tTimestamp time;
   rrlib::time::tTimestamp blink;
 
+  shared::tChangeGatedOutput<bool, tOutput<bool>> red_;
+  shared::tChangeGatedOutput<bool, tOutput<bool>> yellow_;
+  shared::tChangeGatedOutput<bool, tOutput<bool>> green_;
+
 };
 
 //----------------------------------------------------------------------
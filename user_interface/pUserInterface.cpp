@@ -46,6 +46,7 @@
 #include <cassert>
 
 #include "projects/smart_home/user_interface/gUserInterface.h"
+#include "projects/smart_home/shared/tCycleClock.h"
 
 //----------------------------------------------------------------------
 // Namespace usage
@@ -71,7 +72,10 @@ bool make_all_port_links_unique = true;
 // StartUp
 //----------------------------------------------------------------------
 void StartUp()
-{}
+{
+  // SMART_HOME_TIME_SCALE=<factor> runs the controllers on accelerated simulated time
+  finroc::smart_home::shared::ConfigureCycleClockFromEnvironment();
+}
 
 //----------------------------------------------------------------------
 // CreateMainGroup
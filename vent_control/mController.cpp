@@ -67,6 +67,8 @@ mController::mController(core::tFrameworkElement *parent, const std::string &nam
   co_gpio_ventilation(cVENTILATION_OFFINE),
   co_ventilation(false),
   par_furnace_activity_threshold(50.0),
+  clock_(&shared::GetCycleClock()),
+  cycle_time_(clock_->Now()),
   furnace_active_(false)
 {
 }
@@ -83,6 +85,7 @@ mController::~mController()
 //----------------------------------------------------------------------
 void mController::Sense()
 {
+  cycle_time_ = clock_->Now();
   if (this->SensorInputChanged())
   {
     (si_temperature_furnace.Get() > par_furnace_activity_threshold.Get()) ? furnace_active_ = true : furnace_active_ = false;
@@ -100,13 +103,13 @@ void mController::Control()
     // ventilation manually disabled
     if (ci_ventilation_mode.Get() == tVentilationMode::eOFFLINE)
     {
-      co_gpio_ventilation.Publish(cVENTILATION_OFFINE);
-      co_ventilation.Publish(false);
+      co_gpio_ventilation.Publish(cVENTILATION_OFFINE, cycle_time_);
+      co_ventilation.Publish(false, cycle_time_);
     }
     else if (ci_ventilation_mode.Get() == tVentilationMode::eONLINE)
     {
-      co_gpio_ventilation.Publish(cVENTILATION_ONLINE);
-      co_ventilation.Publish(true);
+      co_gpio_ventilation.Publish(cVENTILATION_ONLINE, cycle_time_);
+      co_ventilation.Publish(true, cycle_time_);
     }
     else if (ci_ventilation_mode.Get() == tVentilationMode::eAUTOMATIC)
     {
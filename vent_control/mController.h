@@ -47,6 +47,7 @@
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "projects/smart_home/shared/tCycleClock.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -113,6 +114,15 @@ public:
 
   mController(core::tFrameworkElement *parent, const std::string &name = "Ventilation");
 
+  /*!
+   * Replaces the clock of the controller (shared::GetCycleClock() by default)
+   * @param clock clock (has to outlive the module)
+   */
+  inline void SetClock(shared::tCycleClock &clock)
+  {
+    clock_ = &clock;
+  }
+
 //----------------------------------------------------------------------
 // Protected methods
 //----------------------------------------------------------------------
@@ -130,6 +140,10 @@ protected:
 //----------------------------------------------------------------------
 private:
 
+  // clock and its timestamp of the current cycle (sampled once at the beginning of Sense)
+  shared::tCycleClock *clock_;
+  rrlib::time::tTimestamp cycle_time_;
+
   bool furnace_active_;
 
   virtual void Sense() override;
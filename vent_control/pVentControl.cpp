@@ -47,6 +47,7 @@
 #include <cassert>
 
 #include "projects/smart_home/vent_control/gVentControl.h"
+#include "projects/smart_home/shared/tCycleClock.h"
 
 //----------------------------------------------------------------------
 // Namespace usage
@@ -72,7 +73,10 @@ bool make_all_port_links_unique = true;
 // StartUp
 //----------------------------------------------------------------------
 void StartUp()
-{}
+{
+  // SMART_HOME_TIME_SCALE=<factor> runs the controllers on accelerated simulated time
+  finroc::smart_home::shared::ConfigureCycleClockFromEnvironment();
+}
 
 //----------------------------------------------------------------------
 // CreateMainGroup